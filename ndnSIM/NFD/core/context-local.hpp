@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_CONTEXT_LOCAL_HPP
+#define NFD_CORE_CONTEXT_LOCAL_HPP
+
+#include "common.hpp"
+
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace nfd {
+
+/** \brief keeps a separate instance of T for every simulator context, i.e., for every node
+ *
+ *  NFD state that used to be process-wide (scheduler, random number generator) is kept
+ *  per node, so that nodes simulated concurrently by a parallel simulator implementation
+ *  do not share it.  Instances are created on first use by the factory.
+ *
+ *  Instances are found in a table indexed by context (node ID), which is read without locking.
+ *  The table is only replaced by a larger copy, under the mutex, when an instance is created
+ *  for a context beyond its end.  Replaced tables are kept until reset(), because other threads
+ *  may still read them.
+ */
+template<typename T>
+class ContextLocal : noncopyable
+{
+public:
+  typedef std::function<T*(uint32_t context)> Factory;
+
+  explicit
+  ContextLocal(const Factory& factory)
+    : m_factory(factory)
+  {
+    reset();
+  }
+
+  /** \return instance of the current simulator context
+   */
+  T&
+  get()
+  {
+    return get(ns3::Simulator::GetContext());
+  }
+
+  /** \return instance of \p context, created if it does not exist yet
+   */
+  T&
+  get(uint32_t context)
+  {
+    T* instance = find(context);
+    if (instance != nullptr) {
+      return *instance;
+    }
+    return create(context);
+  }
+
+  /** \brief invoke \p f for every existing instance
+   *
+   *  The lock is not held while \p f runs, so \p f may use this ContextLocal.
+   */
+  template<typename F>
+  void
+  forEach(const F& f)
+  {
+    std::vector<T*> instances;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (const auto& instance : m_instances) {
+        instances.push_back(instance.get());
+      }
+    }
+    for (T* instance : instances) {
+      f(*instance);
+    }
+  }
+
+  /** \brief destroy all instances
+   *  \warning must not be called while another thread uses an instance
+   */
+  void
+  reset()
+  {
+    std::vector<unique_ptr<T>> instances;
+    std::vector<unique_ptr<Table>> tables;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      instances.swap(m_instances);
+      tables.swap(m_tables);
+
+      m_tables.emplace_back(new Table(0));
+      m_table.store(m_tables.back().get(), std::memory_order_release);
+      m_noContextInstance.store(nullptr, std::memory_order_release);
+    }
+    // instances are destroyed outside of the lock
+  }
+
+private:
+  struct Table
+  {
+    explicit
+    Table(size_t size)
+      : size(size)
+      , slots(new std::atomic<T*>[size])
+    {
+      for (size_t i = 0; i < size; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    const size_t size;
+    unique_ptr<std::atomic<T*>[]> slots;
+  };
+
+  T*
+  find(uint32_t context) const
+  {
+    if (context == ns3::Simulator::NO_CONTEXT) {
+      return m_noContextInstance.load(std::memory_order_acquire);
+    }
+
+    const Table* table = m_table.load(std::memory_order_acquire);
+    if (context >= table->size) {
+      return nullptr;
+    }
+    return table->slots[context].load(std::memory_order_acquire);
+  }
+
+  T&
+  create(uint32_t context)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    T* instance = find(context);
+    if (instance != nullptr) {
+      return *instance; // created by another thread
+    }
+
+    unique_ptr<T> created(m_factory(context));
+    instance = created.get();
+    m_instances.push_back(std::move(created));
+
+    if (context == ns3::Simulator::NO_CONTEXT) {
+      m_noContextInstance.store(instance, std::memory_order_release);
+      return *instance;
+    }
+
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if (context >= table->size) {
+      unique_ptr<Table> grown(new Table(std::max<size_t>(context + 1, table->size * 2)));
+      for (size_t i = 0; i < table->size; ++i) {
+        grown->slots[i].store(table->slots[i].load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+      }
+      table = grown.get();
+      m_tables.push_back(std::move(grown));
+      m_table.store(table, std::memory_order_release);
+    }
+    table->slots[context].store(instance, std::memory_order_release);
+    return *instance;
+  }
+
+private:
+  Factory m_factory;
+  std::mutex m_mutex;
+  std::vector<unique_ptr<T>> m_instances;
+  std::vector<unique_ptr<Table>> m_tables; ///< current table is the last one
+  std::atomic<Table*> m_table;
+  std::atomic<T*> m_noContextInstance;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_CONTEXT_LOCAL_HPP
@@ -24,19 +24,36 @@
  */
 
 #include "random.hpp"
-#include <boost/thread/tss.hpp>
+#include "context-local.hpp"
+
+#include "ns3/rng-seed-manager.h"
 
 namespace nfd {
 
+static ContextLocal<std::mt19937>&
+getRngs()
+{
+  // every node has its own generator seeded from ns-3 seed and run number, so that
+  // results are reproducible regardless of how nodes are scheduled on threads or MPI ranks
+  static auto rngs = new ContextLocal<std::mt19937>([] (uint32_t context) {
+      uint64_t run = ns3::RngSeedManager::GetRun();
+      std::seed_seq seed{ns3::RngSeedManager::GetSeed(), static_cast<uint32_t>(run),
+                         static_cast<uint32_t>(run >> 32), context};
+      return new std::mt19937(seed);
+    });
+  return *rngs;
+}
+
 std::mt19937&
 getGlobalRng()
 {
-  static boost::thread_specific_ptr<std::mt19937> rng;
-  if (rng.get() == nullptr) {
-    std::random_device rd;
-    rng.reset(new std::mt19937(rd()));
-  }
-  return *rng;
+  return getRngs().get();
+}
+
+void
+resetGlobalRng()
+{
+  getRngs().reset();
 }
 
 } // namespace nfd
@@ -41,11 +41,20 @@
 
 namespace nfd {
 
-/** \return the global random number generator instance
+/** \return the random number generator instance of the current simulator context (node)
  */
 std::mt19937&
 getGlobalRng();
 
+/** \brief destroy generators of all nodes, so that they are seeded again when next used
+ *
+ *  This is needed to apply a new ns-3 seed or run number (RngSeed, RngRun) within the same
+ *  process, e.g., between independent simulation runs.
+ *  \warning must not be called while the simulation is running
+ */
+void
+resetGlobalRng();
+
 } // namespace nfd
 
 #endif // NFD_CORE_RANDOM_HPP
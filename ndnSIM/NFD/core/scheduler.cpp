@@ -24,23 +24,27 @@
  */
 
 #include "scheduler.hpp"
+#include "context-local.hpp"
 #include "global-io.hpp"
 
-#include <boost/thread/tss.hpp>
-
 namespace nfd {
 namespace scheduler {
 
-static boost::thread_specific_ptr<Scheduler> g_scheduler;
+static ContextLocal<Scheduler>&
+getSchedulers()
+{
+  // never destroyed: ~Scheduler cancels events, which cannot be done after ns3::Simulator
+  // has been destroyed at process exit
+  static auto schedulers = new ContextLocal<Scheduler>([] (uint32_t) {
+      return new Scheduler(*static_cast<boost::asio::io_service*>(nullptr));
+    });
+  return *schedulers;
+}
 
 Scheduler&
 getGlobalScheduler()
 {
-  if (g_scheduler.get() == nullptr) {
-    g_scheduler.reset(new Scheduler(*static_cast<boost::asio::io_service*>(nullptr)));
-  }
-
-  return *g_scheduler;
+  return getSchedulers().get();
 }
 
 EventId
@@ -52,13 +56,24 @@ schedule(const time::nanoseconds& after, const Scheduler::Event& event)
 void
 cancel(const EventId& eventId)
 {
-  getGlobalScheduler().cancelEvent(eventId);
+  if (eventId == nullptr) {
+    return;
+  }
+  // the event may be cancelled outside of the node that scheduled it (e.g., when the node is
+  // disposed), so the scheduler is found by the context of the event itself
+  getSchedulers().get(eventId->GetContext()).cancelEvent(eventId);
+}
+
+void
+cancelAllEvents()
+{
+  getSchedulers().forEach([] (Scheduler& scheduler) { scheduler.cancelAllEvents(); });
 }
 
 void
 resetGlobalScheduler()
 {
-  g_scheduler.reset();
+  getSchedulers().reset();
 }
 
 ScopedEventId::ScopedEventId()
@@ -49,6 +49,15 @@ schedule(const time::nanoseconds& after, const Scheduler::Event& event);
 void
 cancel(const EventId& eventId);
 
+/** \brief cancel all scheduled events of all nodes
+ */
+void
+cancelAllEvents();
+
+/** \return scheduler of the current simulator context (node)
+ *
+ *  Every node has its own scheduler, so that nodes can be simulated concurrently.
+ */
 Scheduler&
 getGlobalScheduler();
 
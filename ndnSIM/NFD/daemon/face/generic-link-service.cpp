@@ -26,6 +26,8 @@
 #include "generic-link-service.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 
+#include "ns3/ndnSIM/utils/ndn-profiler.hpp"
+
 namespace nfd {
 namespace face {
 
@@ -56,6 +58,8 @@ GenericLinkService::GenericLinkService(const GenericLinkService::Options& option
 void
 GenericLinkService::doSendInterest(const Interest& interest)
 {
+  NDNSIM_PROFILE_SCOPE(LINK_SERVICE);
+
   lp::Packet lpPacket(interest.wireEncode());
 
   encodeLpFields(interest, lpPacket);
@@ -66,6 +70,8 @@ GenericLinkService::doSendInterest(const Interest& interest)
 void
 GenericLinkService::doSendData(const Data& data)
 {
+  NDNSIM_PROFILE_SCOPE(LINK_SERVICE);
+
   lp::Packet lpPacket(data.wireEncode());
 
   encodeLpFields(data, lpPacket);
@@ -76,6 +82,8 @@ GenericLinkService::doSendData(const Data& data)
 void
 GenericLinkService::doSendNack(const lp::Nack& nack)
 {
+  NDNSIM_PROFILE_SCOPE(LINK_SERVICE);
+
   lp::Packet lpPacket(nack.getInterest().wireEncode());
   lpPacket.add<lp::NackField>(nack.getHeader());
 
@@ -164,6 +172,8 @@ GenericLinkService::assignSequences(std::vector<lp::Packet>& pkts)
 void
 GenericLinkService::doReceivePacket(Transport::Packet&& packet)
 {
+  NDNSIM_PROFILE_SCOPE(LINK_SERVICE);
+
   try {
     lp::Packet pkt(packet.packet);
 
@@ -32,6 +32,8 @@
 #include "face/null-face.hpp"
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include "ns3/ndnSIM/utils/ndn-profiler.hpp"
+
 namespace nfd {
 
 NFD_LOG_INIT("Forwarder");
@@ -72,6 +74,8 @@ Forwarder::~Forwarder() = default;
 void
 Forwarder::startProcessInterest(Face& face, const Interest& interest)
 {
+  NDNSIM_PROFILE_SCOPE(FORWARDER);
+
   // check fields used by forwarding are well-formed
   try {
     if (interest.hasLink()) {
@@ -94,6 +98,8 @@ Forwarder::startProcessInterest(Face& face, const Interest& interest)
 void
 Forwarder::startProcessData(Face& face, const Data& data)
 {
+  NDNSIM_PROFILE_SCOPE(FORWARDER);
+
   // check fields used by forwarding are well-formed
   // (none needed)
 
@@ -103,6 +109,8 @@ Forwarder::startProcessData(Face& face, const Data& data)
 void
 Forwarder::startProcessNack(Face& face, const lp::Nack& nack)
 {
+  NDNSIM_PROFILE_SCOPE(FORWARDER);
+
   // check fields used by forwarding are well-formed
   try {
     if (nack.getInterest().hasLink()) {
@@ -173,7 +181,11 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
                 bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match;
+      {
+        NDNSIM_PROFILE_SCOPE(CONTENT_STORE);
+        match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      }
       if (match != nullptr) {
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
@@ -250,14 +262,18 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, data); });
 
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  // the Data is the cached instance, which is shared with later hits and, for unsolicited Data
+  // and the ndnSIM content store, with other holders of the same shared_ptr; tag a copy, so the
+  // tag does not leak to them (the copy shares the wire, so it is not re-encoded)
+  shared_ptr<Data> dataCopy = make_shared<Data>(data);
+  dataCopy->setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
-  this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
+  this->setStragglerTimer(pitEntry, true, dataCopy->getFreshnessPeriod());
 
   // goto outgoing Data pipeline
-  this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
+  this->onOutgoingData(*dataCopy, *const_pointer_cast<Face>(inFace.shared_from_this()));
 }
 
 void
@@ -355,8 +371,10 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   // CS insert
   if (m_csFromNdnSim == nullptr)
     m_cs.insert(*dataCopyWithoutTag);
-  else
+  else {
+    NDNSIM_PROFILE_SCOPE(CONTENT_STORE);
     m_csFromNdnSim->Add(dataCopyWithoutTag);
+  }
 
   std::set<Face*> pendingDownstreams;
   // foreach PitEntry
@@ -409,8 +427,10 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
     // CS insert
     if (m_csFromNdnSim == nullptr)
       m_cs.insert(data, true);
-    else
+    else {
+      NDNSIM_PROFILE_SCOPE(CONTENT_STORE);
       m_csFromNdnSim->Add(data.shared_from_this());
+    }
   }
 
   NFD_LOG_DEBUG("onDataUnsolicited face=" << inFace.getId() <<
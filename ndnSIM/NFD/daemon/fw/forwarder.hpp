@@ -40,6 +40,7 @@
 #include "table/network-region-table.hpp"
 
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/ndn-profiler.hpp"
 
 namespace nfd {
 
@@ -293,6 +294,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   dispatchToStrategy(pit::Entry& pitEntry, Function trigger)
 #endif
   {
+    NDNSIM_PROFILE_SCOPE(STRATEGY);
     trigger(m_strategyChoice.findEffectiveStrategy(pitEntry));
   }
 
@@ -26,6 +26,8 @@
 #include "strategy-registry.hpp"
 #include "best-route-strategy2.hpp"
 
+#include <mutex>
+
 namespace nfd {
 namespace fw {
 
@@ -42,17 +44,34 @@ getStrategyFactories()
   return strategyFactories;
 }
 
+/** \brief guards strategy factories, as forwarders of different nodes
+ *         may be created concurrently
+ */
+static std::mutex&
+getStrategyFactoriesMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
 void
 registerStrategyImpl(const Name& strategyName, const StrategyCreateFunc& createFunc)
 {
+  std::lock_guard<std::mutex> lock(getStrategyFactoriesMutex());
   getStrategyFactories().insert({strategyName, createFunc});
 }
 
 void
 installStrategies(Forwarder& forwarder)
 {
+  std::map<Name, StrategyCreateFunc> factories;
+  {
+    std::lock_guard<std::mutex> lock(getStrategyFactoriesMutex());
+    factories = getStrategyFactories();
+  }
+
   StrategyChoice& sc = forwarder.getStrategyChoice();
-  for (const auto& pair : getStrategyFactories()) {
+  for (const auto& pair : factories) {
     if (!sc.hasStrategy(pair.first, true)) {
       sc.install(pair.second(forwarder));
     }
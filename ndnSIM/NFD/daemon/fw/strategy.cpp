@@ -96,7 +96,7 @@ Strategy::sendInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
 
   if (wantNewNonce) {
     interest = make_shared<Interest>(*interest);
-    static std::uniform_int_distribution<uint32_t> dist;
+    std::uniform_int_distribution<uint32_t> dist;
     interest->setNonce(dist(getGlobalRng()));
   }
 
@@ -28,6 +28,7 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const double TablesConfigSection::DEFAULT_DNL_FILTER_FP_RATE = 0.0001;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -66,6 +67,65 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     nCsMaxPackets = ConfigFile::parseNumber<size_t>(*csMaxPacketsNode, "cs_max_packets", "tables");
   }
 
+  size_t nCsMaxBytes = 0;
+  OptionalNode csMaxBytesNode = section.get_child_optional("cs_max_bytes");
+  if (csMaxBytesNode) {
+    nCsMaxBytes = ConfigFile::parseNumber<size_t>(*csMaxBytesNode, "cs_max_bytes", "tables");
+  }
+
+  size_t nCsMaxDataSize = 0;
+  OptionalNode csMaxDataSizeNode = section.get_child_optional("cs_max_data_size");
+  if (csMaxDataSizeNode) {
+    nCsMaxDataSize = ConfigFile::parseNumber<size_t>(*csMaxDataSizeNode,
+                                                     "cs_max_data_size", "tables");
+  }
+
+  std::vector<Name> csNoCachePrefixes;
+  OptionalNode csNoCacheSection = section.get_child_optional("cs_no_cache");
+  if (csNoCacheSection) {
+    for (const auto& pair : *csNoCacheSection) {
+      try {
+        csNoCachePrefixes.push_back(Name(pair.first));
+      }
+      catch (const ndn::name::Component::Error& e) {
+        BOOST_THROW_EXCEPTION(ConfigFile::Error(
+          "Invalid prefix \"" + pair.first + "\" for option \"cs_no_cache\" in \"tables\" section: " +
+          e.what()));
+      }
+    }
+  }
+
+  bool wantCsHashIndex = false;
+  OptionalNode csHashIndexNode = section.get_child_optional("cs_hash_index");
+  if (csHashIndexNode) {
+    wantCsHashIndex = ConfigFile::parseYesNo(*csHashIndexNode, "cs_hash_index", "tables");
+  }
+
+  bool wantFibTrieIndex = false;
+  OptionalNode fibTrieIndexNode = section.get_child_optional("fib_trie_index");
+  if (fibTrieIndexNode) {
+    wantFibTrieIndex = ConfigFile::parseYesNo(*fibTrieIndexNode, "fib_trie_index", "tables");
+  }
+
+  size_t nDnlFilterCapacity = 0;
+  OptionalNode dnlFilterCapacityNode = section.get_child_optional("dnl_filter_capacity");
+  if (dnlFilterCapacityNode) {
+    nDnlFilterCapacity = ConfigFile::parseNumber<size_t>(*dnlFilterCapacityNode,
+                                                         "dnl_filter_capacity", "tables");
+  }
+
+  double dnlFilterFpRate = DEFAULT_DNL_FILTER_FP_RATE;
+  OptionalNode dnlFilterFpRateNode = section.get_child_optional("dnl_filter_fp_rate");
+  if (dnlFilterFpRateNode) {
+    dnlFilterFpRate = ConfigFile::parseNumber<double>(*dnlFilterFpRateNode,
+                                                      "dnl_filter_fp_rate", "tables");
+    if (!(dnlFilterFpRate > 0.0 && dnlFilterFpRate < 1.0)) {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(
+        "Invalid value \"" + dnlFilterFpRateNode->get_value<std::string>() +
+        "\" for option \"dnl_filter_fp_rate\" in \"tables\" section, must be in (0,1)"));
+    }
+  }
+
   unique_ptr<fw::UnsolicitedDataPolicy> unsolicitedDataPolicy;
   OptionalNode unsolicitedDataPolicyNode = section.get_child_optional("cs_unsolicited_policy");
   if (unsolicitedDataPolicyNode) {
@@ -95,12 +155,42 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
   }
 
   m_forwarder.getCs().setLimit(nCsMaxPackets);
+  m_forwarder.getCs().setByteLimit(nCsMaxBytes);
+  m_forwarder.getCs().setAdmissionFilter(makeCsAdmissionFilter(nCsMaxDataSize,
+                                                               csNoCachePrefixes));
+  m_forwarder.getCs().setHashIndexEnabled(wantCsHashIndex);
+
+  m_forwarder.getFib().setTrieIndexEnabled(wantFibTrieIndex);
+
+  if (nDnlFilterCapacity > 0) {
+    m_forwarder.getDeadNonceList().enableFilter(nDnlFilterCapacity, dnlFilterFpRate);
+  }
+  else {
+    m_forwarder.getDeadNonceList().disableFilter();
+  }
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
   m_isConfigured = true;
 }
 
+cs::Cs::AdmissionFilter
+TablesConfigSection::makeCsAdmissionFilter(size_t nMaxDataSize,
+                                           const std::vector<Name>& noCachePrefixes)
+{
+  if (nMaxDataSize == 0 && noCachePrefixes.empty()) {
+    return nullptr;
+  }
+
+  return [=] (const Data& data) {
+    if (nMaxDataSize > 0 && data.wireEncode().size() > nMaxDataSize) {
+      return false;
+    }
+    return std::none_of(noCachePrefixes.begin(), noCachePrefixes.end(),
+                        [&data] (const Name& prefix) { return prefix.isPrefixOf(data.getName()); });
+  };
+}
+
 void
 TablesConfigSection::processStrategyChoiceSection(const ConfigSection& section, bool isDryRun)
 {
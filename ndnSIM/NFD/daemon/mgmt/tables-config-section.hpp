@@ -38,6 +38,13 @@ namespace nfd {
  *  tables
  *  {
  *    cs_max_packets 65536
+ *    cs_max_bytes 0
+ *    cs_max_data_size 0
+ *
+ *    cs_no_cache
+ *    {
+ *      /example/tunnel
+ *    }
  *
  *    cs_unsolicited_policy drop-all
  *
@@ -58,8 +65,8 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets and cs_unsolicited_policy are applied;
- *      defaults are used if an option is omitted.
+ *  \li cs_max_packets, cs_max_bytes, cs_max_data_size, cs_no_cache, and cs_unsolicited_policy
+ *      are applied; defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
  *
@@ -91,8 +98,17 @@ private:
   void
   processNetworkRegionSection(const ConfigSection& section, bool isDryRun);
 
+  /** \brief makes a CS admission filter that rejects Data larger than \p nMaxDataSize bytes
+   *         and Data under any of \p noCachePrefixes
+   *  \param nMaxDataSize maximum size of a Data packet, or 0 for unlimited
+   *  \return the filter, or an empty function if every Data packet is admitted
+   */
+  static cs::Cs::AdmissionFilter
+  makeCsAdmissionFilter(size_t nMaxDataSize, const std::vector<Name>& noCachePrefixes);
+
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const double DEFAULT_DNL_FILTER_FP_RATE;
 
   Forwarder& m_forwarder;
 
@@ -30,11 +30,13 @@ namespace cs {
 
 EntryImpl::EntryImpl(const Name& name)
   : m_queryName(name)
+  , m_seqNo(0)
 {
   BOOST_ASSERT(this->isQuery());
 }
 
-EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited)
+EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, uint64_t seqNo)
+  : m_seqNo(seqNo)
 {
   this->setData(data, isUnsolicited);
   BOOST_ASSERT(!this->isQuery());
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_CS_ENTRY_IMPL_HPP
 
 #include "cs-entry.hpp"
+#include "cs-internal.hpp"
 
 namespace nfd {
 namespace cs {
@@ -49,8 +50,9 @@ public:
   EntryImpl(const Name& name);
 
   /** \brief construct Entry for storage
+   *  \param seqNo insertion sequence number, which orders the Table when ordered by insertion
    */
-  EntryImpl(shared_ptr<const Data> data, bool isUnsolicited);
+  EntryImpl(shared_ptr<const Data> data, bool isUnsolicited, uint64_t seqNo = 0);
 
   /** \return true if entry can become stale, false if entry is never stale
    */
@@ -63,14 +65,36 @@ public:
   bool
   operator<(const EntryImpl& other) const;
 
+  uint64_t
+  getSeqNo() const
+  {
+    return m_seqNo;
+  }
+
+  void
+  setSeqNo(uint64_t seqNo)
+  {
+    m_seqNo = seqNo;
+  }
+
 private:
   bool
   isQuery() const;
 
 private:
   Name m_queryName;
+  uint64_t m_seqNo;
 };
 
+inline bool
+TableOrder::operator()(const EntryImpl& a, const EntryImpl& b) const
+{
+  if (m_isByInsertion) {
+    return a.getSeqNo() < b.getSeqNo();
+  }
+  return a < b;
+}
+
 } // namespace cs
 } // namespace nfd
 
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-ghost-list.hpp"
+
+namespace nfd {
+namespace cs {
+
+void
+GhostList::push(const Name& name)
+{
+  name_tree::HashValue h = name_tree::computeHash(name);
+  auto it = m_index.find(h);
+  if (it != m_index.end()) {
+    m_queue.erase(it->second);
+    it->second = m_queue.insert(m_queue.end(), h);
+    return;
+  }
+  m_index.insert(std::make_pair(h, m_queue.insert(m_queue.end(), h)));
+}
+
+bool
+GhostList::erase(const Name& name)
+{
+  auto it = m_index.find(name_tree::computeHash(name));
+  if (it == m_index.end()) {
+    return false;
+  }
+  m_queue.erase(it->second);
+  m_index.erase(it);
+  return true;
+}
+
+void
+GhostList::pop()
+{
+  BOOST_ASSERT(!m_queue.empty());
+  m_index.erase(m_queue.front());
+  m_queue.pop_front();
+}
+
+void
+GhostList::clear()
+{
+  m_queue.clear();
+  m_index.clear();
+}
+
+} // namespace cs
+} // namespace nfd
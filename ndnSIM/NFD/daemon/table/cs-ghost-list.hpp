@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_GHOST_LIST_HPP
+#define NFD_DAEMON_TABLE_CS_GHOST_LIST_HPP
+
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief remembers Names of recently evicted entries, in FIFO order
+ *
+ *  Replacement policies use a ghost list to recognize a Data packet that is inserted again
+ *  shortly after its eviction. Only the hash of each Name is kept, so that a ghost entry costs
+ *  a few words regardless of Name and Data size; a hash collision makes the policy treat
+ *  a new Name as recently evicted, which only affects the quality of eviction decisions.
+ */
+class GhostList : noncopyable
+{
+public:
+  size_t
+  size() const
+  {
+    return m_queue.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_queue.empty();
+  }
+
+  /** \brief appends \p name as the most recently evicted
+   *
+   *  If \p name is already in the list, it is moved to the end.
+   */
+  void
+  push(const Name& name);
+
+  /** \brief removes \p name if it is in the list
+   *  \return whether \p name was in the list
+   */
+  bool
+  erase(const Name& name);
+
+  /** \brief removes the least recently evicted Name
+   *  \pre !empty()
+   */
+  void
+  pop();
+
+  void
+  clear();
+
+private:
+  typedef std::list<name_tree::HashValue> Queue;
+
+  Queue m_queue;
+  std::unordered_map<name_tree::HashValue, Queue::iterator> m_index;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_GHOST_LIST_HPP
@@ -37,7 +37,40 @@ namespace cs {
 
 class EntryImpl;
 
-typedef std::set<EntryImpl> Table;
+/** \brief orders ContentStore entries in the Table
+ *
+ *  By default, entries are ordered by full Names of stored Data packets,
+ *  and the Table serves lookups directly.
+ *  When the ContentStore hash index is enabled, entries are ordered by insertion,
+ *  so that inserting and erasing an entry does not compare Names.
+ */
+class TableOrder
+{
+public:
+  explicit
+  TableOrder(bool isByInsertion = false)
+    : m_isByInsertion(isByInsertion)
+  {
+  }
+
+  bool
+  isByInsertion() const
+  {
+    return m_isByInsertion;
+  }
+
+  bool
+  operator()(const EntryImpl& a, const EntryImpl& b) const;
+
+private:
+  bool m_isByInsertion;
+};
+
+/** \brief stores ContentStore entries
+ *
+ *  Iterators remain valid until the entry is erased.
+ */
+typedef std::set<EntryImpl, TableOrder> Table;
 typedef Table::const_iterator iterator;
 
 } // namespace cs
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-arc.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+const std::string ArcPolicy::POLICY_NAME = "arc";
+NFD_REGISTER_CS_POLICY(ArcPolicy);
+
+ArcPolicy::ArcPolicy()
+  : Policy(POLICY_NAME)
+  , m_target(0.0)
+{
+}
+
+void
+ArcPolicy::doAfterInsert(iterator i)
+{
+  double capacity = static_cast<double>(this->getLimit());
+  double nGhostRecent = static_cast<double>(m_ghostRecent.size());
+  double nGhostFrequent = static_cast<double>(m_ghostFrequent.size());
+
+  if (m_ghostRecent.erase(i->getName())) {
+    // B1 hit: T1 was too small
+    m_target = std::min(capacity, m_target + std::max(nGhostFrequent / nGhostRecent, 1.0));
+    this->attachQueue(i, QUEUE_FREQUENT);
+  }
+  else if (m_ghostFrequent.erase(i->getName())) {
+    // B2 hit: T2 was too small
+    m_target = std::max(0.0, m_target - std::max(nGhostRecent / nGhostFrequent, 1.0));
+    this->attachQueue(i, QUEUE_FREQUENT);
+  }
+  else {
+    this->attachQueue(i, QUEUE_RECENT);
+  }
+
+  this->evictEntries();
+}
+
+void
+ArcPolicy::doAfterRefresh(iterator i)
+{
+  this->promote(i);
+}
+
+void
+ArcPolicy::doBeforeErase(iterator i)
+{
+  this->detachQueue(i);
+}
+
+void
+ArcPolicy::doBeforeUse(iterator i)
+{
+  this->promote(i);
+}
+
+void
+ArcPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    this->evictOne();
+  }
+  this->trimGhosts();
+}
+
+void
+ArcPolicy::evictOne()
+{
+  BOOST_ASSERT(!m_queues[QUEUE_RECENT].empty() || !m_queues[QUEUE_FREQUENT].empty());
+
+  const Queue& recent = m_queues[QUEUE_RECENT];
+  bool isFromRecent = !recent.empty() &&
+                      (static_cast<double>(recent.size()) > m_target ||
+                       m_queues[QUEUE_FREQUENT].empty());
+
+  iterator i = isFromRecent ? recent.front() : m_queues[QUEUE_FREQUENT].front();
+  this->detachQueue(i);
+  (isFromRecent ? m_ghostRecent : m_ghostFrequent).push(i->getName());
+  this->emitSignal(beforeEvict, i);
+}
+
+void
+ArcPolicy::attachQueue(iterator i, QueueType queueType)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+
+  Queue& queue = m_queues[queueType];
+  EntryInfo entryInfo{queueType, queue.insert(queue.end(), i)};
+  m_entryInfoMap.insert(std::make_pair(i, entryInfo));
+}
+
+void
+ArcPolicy::detachQueue(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  m_queues[it->second.queueType].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+}
+
+void
+ArcPolicy::promote(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  Queue& frequent = m_queues[QUEUE_FREQUENT];
+  frequent.splice(frequent.end(), m_queues[it->second.queueType], it->second.queueIt);
+  it->second.queueType = QUEUE_FREQUENT;
+}
+
+void
+ArcPolicy::trimGhosts()
+{
+  // |T1| + |B1| <= c, and |T1| + |T2| + |B1| + |B2| <= 2c
+  size_t capacity = this->getLimit();
+  size_t nRecent = m_queues[QUEUE_RECENT].size();
+  while (!m_ghostRecent.empty() && nRecent + m_ghostRecent.size() > capacity) {
+    m_ghostRecent.pop();
+  }
+
+  size_t nResident = nRecent + m_queues[QUEUE_FREQUENT].size();
+  while (!m_ghostFrequent.empty() &&
+         nResident + m_ghostRecent.size() + m_ghostFrequent.size() > 2 * capacity) {
+    m_ghostFrequent.pop();
+  }
+}
+
+} // namespace arc
+} // namespace cs
+} // namespace nfd
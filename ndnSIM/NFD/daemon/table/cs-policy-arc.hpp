@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+
+#include "cs-policy.hpp"
+#include "cs-ghost-list.hpp"
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+typedef std::list<iterator> Queue;
+typedef Queue::iterator QueueIt;
+
+enum QueueType {
+  QUEUE_RECENT,  ///< T1: entries used once since insertion
+  QUEUE_FREQUENT ///< T2: entries used at least twice
+};
+
+struct EntryInfo
+{
+  QueueType queueType;
+  QueueIt queueIt;
+};
+
+typedef std::unordered_map<iterator, EntryInfo, EntryItHash> EntryInfoMap;
+
+/** \brief Adaptive Replacement Cache (ARC) cs replacement policy
+ *
+ * Entries are kept in two LRU queues: T1 holds entries inserted once, and T2 holds entries
+ * that were used or inserted again. Names of entries evicted from T1 and T2 are remembered in
+ * ghost lists B1 and B2. When a Data packet whose Name is in B1 is inserted, the target size of
+ * T1 grows, because a larger T1 would have kept it; a Name in B2 shrinks the target instead.
+ * Entries are evicted from T1 while it exceeds its target, and from T2 otherwise.
+ *
+ * A one-time scan of many Names only passes through T1, so that it cannot flush T2.
+ * The target and the ghost lists are sized by the limit in number of entries.
+ */
+class ArcPolicy : public Policy
+{
+public:
+  ArcPolicy();
+
+  /** \return target size of T1
+   */
+  double
+  getTarget() const
+  {
+    return m_target;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+private:
+  /** \brief evicts one entry and remembers its Name in a ghost list
+   *  \pre CS is not empty
+   */
+  void
+  evictOne();
+
+  /** \brief attaches the entry to the MRU end of a queue
+   *  \pre the entry is not in any queue
+   */
+  void
+  attachQueue(iterator i, QueueType queueType);
+
+  /** \brief detaches the entry from its current queue
+   */
+  void
+  detachQueue(iterator i);
+
+  /** \brief moves the entry to the MRU end of T2
+   */
+  void
+  promote(iterator i);
+
+  /** \brief drops the oldest ghosts so that the ghost lists do not outgrow the limit
+   */
+  void
+  trimGhosts();
+
+private:
+  Queue m_queues[2];
+  EntryInfoMap m_entryInfoMap;
+  GhostList m_ghostRecent;   ///< B1
+  GhostList m_ghostFrequent; ///< B2
+  double m_target;           ///< p, target size of T1
+};
+
+} // namespace arc
+
+using arc::ArcPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
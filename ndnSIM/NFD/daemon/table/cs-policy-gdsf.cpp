@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-gdsf.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace gdsf {
+
+const std::string GdsfPolicy::POLICY_NAME = "gdsf";
+NFD_REGISTER_CS_POLICY(GdsfPolicy);
+
+const std::string GdsPolicy::POLICY_NAME = "gds";
+NFD_REGISTER_CS_POLICY(GdsPolicy);
+
+GdsfPolicy::GdsfPolicy()
+  : GdsfPolicy(POLICY_NAME, true)
+{
+}
+
+GdsfPolicy::GdsfPolicy(const std::string& policyName, bool isFrequencyAware)
+  : Policy(policyName)
+  , m_isFrequencyAware(isFrequencyAware)
+  , m_inflation(0.0)
+  , m_nextSequence(0)
+{
+}
+
+GdsPolicy::GdsPolicy()
+  : GdsfPolicy(POLICY_NAME, false)
+{
+}
+
+void
+GdsfPolicy::doAfterInsert(iterator i)
+{
+  this->prioritize(i, true);
+  this->evictEntries();
+}
+
+void
+GdsfPolicy::doAfterRefresh(iterator i)
+{
+  this->prioritize(i, false);
+}
+
+void
+GdsfPolicy::doBeforeErase(iterator i)
+{
+  m_queue.get<1>().erase(i);
+}
+
+void
+GdsfPolicy::doBeforeUse(iterator i)
+{
+  this->prioritize(i, false);
+}
+
+void
+GdsfPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->isOverLimit()) {
+    BOOST_ASSERT(!m_queue.empty());
+    auto lowest = m_queue.begin();
+    iterator i = lowest->entry;
+    m_inflation = lowest->priority;
+    m_queue.erase(lowest);
+    this->emitSignal(beforeEvict, i);
+  }
+}
+
+void
+GdsfPolicy::prioritize(iterator i, bool isNewEntry)
+{
+  double size = static_cast<double>(i->getData().wireEncode().size());
+
+  auto& byEntry = m_queue.get<1>();
+  auto it = byEntry.find(i);
+  BOOST_ASSERT((it == byEntry.end()) == isNewEntry);
+
+  uint64_t sequence = m_nextSequence++;
+  if (it == byEntry.end()) {
+    QueueEntry queueEntry{i, m_inflation + 1.0 / size, sequence, 1};
+    m_queue.insert(queueEntry);
+    return;
+  }
+
+  double inflation = m_inflation;
+  bool isFrequencyAware = m_isFrequencyAware;
+  byEntry.modify(it, [=] (QueueEntry& queueEntry) {
+    if (isFrequencyAware) {
+      ++queueEntry.frequency;
+    }
+    queueEntry.priority = inflation + queueEntry.frequency / size;
+    queueEntry.sequence = sequence;
+  });
+}
+
+} // namespace gdsf
+} // namespace cs
+} // namespace nfd
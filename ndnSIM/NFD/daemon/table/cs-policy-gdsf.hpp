@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
+
+#include "cs-policy.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/composite_key.hpp>
+
+namespace nfd {
+namespace cs {
+namespace gdsf {
+
+struct QueueEntry
+{
+  iterator entry;
+  double priority;
+  uint64_t sequence; ///< breaks ties between equal priorities, in order of prioritization
+  size_t frequency;
+};
+
+typedef boost::multi_index_container<
+    QueueEntry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::ordered_unique<
+        boost::multi_index::composite_key<
+          QueueEntry,
+          boost::multi_index::member<QueueEntry, double, &QueueEntry::priority>,
+          boost::multi_index::member<QueueEntry, uint64_t, &QueueEntry::sequence>
+        >
+      >,
+      boost::multi_index::hashed_unique<
+        boost::multi_index::member<QueueEntry, iterator, &QueueEntry::entry>, EntryItHash
+      >
+    >
+  > Queue;
+
+/** \brief GreedyDual-Size-Frequency cs replacement policy
+ *
+ * Every entry has a priority of L + frequency / size, where size is the size of the Data packet
+ * in bytes, frequency is the number of times the entry was inserted, refreshed or used, and L is
+ * an inflation value that starts at zero. The entry with the lowest priority is evicted first,
+ * and L becomes its priority, so that entries which are not used age relative to new ones.
+ * Among entries with equal priorities, the least recently prioritized entry is evicted first.
+ *
+ * Large Data packets are evicted sooner than small ones with the same popularity, which keeps
+ * more packets in a ContentStore limited in bytes.
+ */
+class GdsfPolicy : public Policy
+{
+public:
+  GdsfPolicy();
+
+  /** \return current inflation value L
+   */
+  double
+  getInflation() const
+  {
+    return m_inflation;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+protected:
+  /** \param isFrequencyAware if false, frequency is always 1
+   */
+  GdsfPolicy(const std::string& policyName, bool isFrequencyAware);
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+private:
+  /** \brief inserts an entry, or counts an access to an existing entry, and updates its priority
+   */
+  void
+  prioritize(iterator i, bool isNewEntry);
+
+private:
+  bool m_isFrequencyAware;
+  double m_inflation;
+  uint64_t m_nextSequence;
+  Queue m_queue;
+};
+
+/** \brief GreedyDual-Size cs replacement policy
+ *
+ * Like GdsfPolicy, but the priority of an entry is L + 1 / size, which is reset every time
+ * the entry is refreshed or used. This is a size-adjusted LRU: among packets of equal size,
+ * the least recently used one is evicted first.
+ */
+class GdsPolicy : public GdsfPolicy
+{
+public:
+  GdsPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+};
+
+} // namespace gdsf
+
+using gdsf::GdsfPolicy;
+using gdsf::GdsPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_GDSF_HPP
@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-s3fifo.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace s3fifo {
+
+const std::string S3FifoPolicy::POLICY_NAME = "s3fifo";
+NFD_REGISTER_CS_POLICY(S3FifoPolicy);
+
+const double S3FifoPolicy::SMALL_RATIO = 0.1;
+const uint8_t S3FifoPolicy::MAX_FREQUENCY = 3;
+
+S3FifoPolicy::S3FifoPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+S3FifoPolicy::doAfterInsert(iterator i)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+
+  QueueType queueType = m_ghost.erase(i->getName()) ? QUEUE_MAIN : QUEUE_SMALL;
+  Queue& queue = m_queues[queueType];
+  EntryInfo entryInfo{queueType, queue.insert(queue.end(), i), 0};
+  m_entryInfoMap.insert(std::make_pair(i, entryInfo));
+
+  this->evictEntries();
+}
+
+void
+S3FifoPolicy::doAfterRefresh(iterator i)
+{
+  this->doBeforeUse(i);
+}
+
+void
+S3FifoPolicy::doBeforeErase(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  m_queues[it->second.queueType].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+}
+
+void
+S3FifoPolicy::doBeforeUse(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  if (it->second.frequency < MAX_FREQUENCY) {
+    ++it->second.frequency;
+  }
+}
+
+void
+S3FifoPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    this->evictOne();
+  }
+}
+
+void
+S3FifoPolicy::evictOne()
+{
+  BOOST_ASSERT(!m_queues[QUEUE_SMALL].empty() || !m_queues[QUEUE_MAIN].empty());
+
+  size_t smallTarget = this->getSmallTarget();
+
+  // every pass either evicts, or moves an entry toward eviction, so this loop terminates
+  while (true) {
+    const Queue& small = m_queues[QUEUE_SMALL];
+    bool isFromSmall = !small.empty() &&
+                       (small.size() >= smallTarget || m_queues[QUEUE_MAIN].empty());
+    if (isFromSmall ? this->evictFromSmall() : this->evictFromMain()) {
+      return;
+    }
+  }
+}
+
+size_t
+S3FifoPolicy::getSmallTarget() const
+{
+  return std::max<size_t>(static_cast<size_t>(this->getLimit() * SMALL_RATIO), 1);
+}
+
+bool
+S3FifoPolicy::evictFromSmall()
+{
+  auto it = m_entryInfoMap.find(m_queues[QUEUE_SMALL].front());
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  if (it->second.frequency > 0) {
+    it->second.frequency = 0;
+    this->moveTo(it->second, QUEUE_MAIN);
+    return false;
+  }
+
+  m_ghost.push(it->first->getName());
+  // the ghost FIFO remembers about as many Names as the main queue holds
+  size_t smallTarget = this->getSmallTarget();
+  size_t ghostLimit = this->getLimit() > smallTarget ? this->getLimit() - smallTarget : 1;
+  while (m_ghost.size() > ghostLimit) {
+    m_ghost.pop();
+  }
+
+  this->evict(it);
+  return true;
+}
+
+bool
+S3FifoPolicy::evictFromMain()
+{
+  auto it = m_entryInfoMap.find(m_queues[QUEUE_MAIN].front());
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  if (it->second.frequency > 0) {
+    --it->second.frequency;
+    this->moveTo(it->second, QUEUE_MAIN);
+    return false;
+  }
+
+  this->evict(it);
+  return true;
+}
+
+void
+S3FifoPolicy::evict(EntryInfoMap::iterator it)
+{
+  iterator i = it->first;
+  m_queues[it->second.queueType].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+  this->emitSignal(beforeEvict, i);
+}
+
+void
+S3FifoPolicy::moveTo(EntryInfo& entryInfo, QueueType queueType)
+{
+  Queue& queue = m_queues[queueType];
+  queue.splice(queue.end(), m_queues[entryInfo.queueType], entryInfo.queueIt);
+  entryInfo.queueType = queueType;
+}
+
+} // namespace s3fifo
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
+
+#include "cs-policy.hpp"
+#include "cs-ghost-list.hpp"
+
+namespace nfd {
+namespace cs {
+namespace s3fifo {
+
+typedef std::list<iterator> Queue;
+typedef Queue::iterator QueueIt;
+
+enum QueueType {
+  QUEUE_SMALL,
+  QUEUE_MAIN
+};
+
+struct EntryInfo
+{
+  QueueType queueType;
+  QueueIt queueIt;
+  uint8_t frequency; ///< number of uses, saturating at MAX_FREQUENCY
+};
+
+typedef std::unordered_map<iterator, EntryInfo, EntryItHash> EntryInfoMap;
+
+/** \brief S3-FIFO cs replacement policy
+ *
+ * New entries enter a small FIFO queue, which holds about SMALL_RATIO of the limit in number
+ * of entries. When an entry leaves the small queue, it moves to a main FIFO queue if it was used
+ * while in the small queue, and is evicted otherwise, with its Name remembered in a ghost FIFO.
+ * Data whose Name is in the ghost FIFO is inserted directly into the main queue.
+ * The main queue evicts in FIFO order, but reinserts an entry that was used since it was last
+ * examined (CLOCK-style), decrementing its use count.
+ *
+ * Most Data used only once leaves through the small queue quickly, and all operations are
+ * FIFO queue manipulations without reordering on every hit.
+ */
+class S3FifoPolicy : public Policy
+{
+public:
+  S3FifoPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /// fraction of the limit in number of entries targeted by the small queue
+  static const double SMALL_RATIO;
+
+  /// maximum use count of an entry
+  static const uint8_t MAX_FREQUENCY;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+private:
+  /** \brief evicts one entry
+   *  \pre CS is not empty
+   */
+  void
+  evictOne();
+
+  /** \return target number of entries in the small queue
+   */
+  size_t
+  getSmallTarget() const;
+
+  /** \brief examines the head of the small queue
+   *  \return whether an entry was evicted, rather than moved to the main queue
+   */
+  bool
+  evictFromSmall();
+
+  /** \brief examines the head of the main queue
+   *  \return whether an entry was evicted
+   */
+  bool
+  evictFromMain();
+
+  /** \brief detaches the entry from its queue and evicts it
+   */
+  void
+  evict(EntryInfoMap::iterator it);
+
+  /** \brief moves the entry to the tail of \p queueType
+   */
+  void
+  moveTo(EntryInfo& entryInfo, QueueType queueType);
+
+private:
+  Queue m_queues[2];
+  EntryInfoMap m_entryInfoMap;
+  GhostList m_ghost;
+};
+
+} // namespace s3fifo
+
+using s3fifo::S3FifoPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_S3FIFO_HPP
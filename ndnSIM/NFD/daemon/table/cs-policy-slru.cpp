@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-slru.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace slru {
+
+const std::string SlruPolicy::POLICY_NAME = "slru";
+NFD_REGISTER_CS_POLICY(SlruPolicy);
+
+const double SlruPolicy::PROTECTED_RATIO = 0.8;
+
+SlruPolicy::SlruPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+SlruPolicy::doAfterInsert(iterator i)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+
+  Queue& probation = m_queues[QUEUE_PROBATION];
+  EntryInfo entryInfo{QUEUE_PROBATION, probation.insert(probation.end(), i)};
+  m_entryInfoMap.insert(std::make_pair(i, entryInfo));
+
+  this->evictEntries();
+}
+
+void
+SlruPolicy::doAfterRefresh(iterator i)
+{
+  this->protect(i);
+}
+
+void
+SlruPolicy::doBeforeErase(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+
+  m_queues[it->second.queueType].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+}
+
+void
+SlruPolicy::doBeforeUse(iterator i)
+{
+  this->protect(i);
+}
+
+void
+SlruPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    Queue& queue = m_queues[QUEUE_PROBATION].empty() ? m_queues[QUEUE_PROTECTED] :
+                                                       m_queues[QUEUE_PROBATION];
+    BOOST_ASSERT(!queue.empty());
+    iterator i = queue.front();
+    queue.pop_front();
+    m_entryInfoMap.erase(i);
+    this->emitSignal(beforeEvict, i);
+  }
+}
+
+void
+SlruPolicy::protect(iterator i)
+{
+  auto it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+  this->moveTo(it->second, QUEUE_PROTECTED);
+
+  size_t protectedLimit = static_cast<size_t>(this->getLimit() * PROTECTED_RATIO);
+  Queue& protectedQueue = m_queues[QUEUE_PROTECTED];
+  while (protectedQueue.size() > std::max<size_t>(protectedLimit, 1)) {
+    this->moveTo(m_entryInfoMap.at(protectedQueue.front()), QUEUE_PROBATION);
+  }
+}
+
+void
+SlruPolicy::moveTo(EntryInfo& entryInfo, QueueType queueType)
+{
+  Queue& queue = m_queues[queueType];
+  queue.splice(queue.end(), m_queues[entryInfo.queueType], entryInfo.queueIt);
+  entryInfo.queueType = queueType;
+}
+
+} // namespace slru
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_SLRU_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_SLRU_HPP
+
+#include "cs-policy.hpp"
+
+namespace nfd {
+namespace cs {
+namespace slru {
+
+typedef std::list<iterator> Queue;
+typedef Queue::iterator QueueIt;
+
+enum QueueType {
+  QUEUE_PROBATION,
+  QUEUE_PROTECTED
+};
+
+struct EntryInfo
+{
+  QueueType queueType;
+  QueueIt queueIt;
+};
+
+typedef std::unordered_map<iterator, EntryInfo, EntryItHash> EntryInfoMap;
+
+/** \brief Segmented LRU cs replacement policy
+ *
+ * New entries enter an LRU probation segment. An entry that is used or refreshed while on
+ * probation moves to an LRU protected segment, which holds at most PROTECTED_RATIO of the limit
+ * in number of entries; when it overflows, its least recently used entry goes back to probation.
+ * Entries are evicted from probation first, so that Data used only once, such as a scan,
+ * cannot displace Data that was used repeatedly. This is also the structure of 2Q.
+ */
+class SlruPolicy : public Policy
+{
+public:
+  SlruPolicy();
+
+  /** \return number of entries in the protected segment
+   */
+  size_t
+  getNProtected() const
+  {
+    return m_queues[QUEUE_PROTECTED].size();
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+  /// fraction of the limit in number of entries reserved for the protected segment
+  static const double PROTECTED_RATIO;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+private:
+  /** \brief moves the entry to the MRU end of the protected segment,
+   *         and demotes protected entries that exceed its capacity
+   */
+  void
+  protect(iterator i);
+
+  /** \brief moves the entry described by \p entryInfo to the MRU end of \p queueType
+   */
+  void
+  moveTo(EntryInfo& entryInfo, QueueType queueType);
+
+private:
+  Queue m_queues[2];
+  EntryInfoMap m_entryInfoMap;
+};
+
+} // namespace slru
+
+using slru::SlruPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_SLRU_HPP
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-tinylfu.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tinylfu {
+
+const size_t FrequencySketch::N_ROWS = 4;
+const uint8_t FrequencySketch::MAX_COUNT = 15;
+const size_t FrequencySketch::SAMPLE_FACTOR = 10;
+
+FrequencySketch::FrequencySketch(size_t width)
+  : m_nIncrements(0)
+{
+  size_t nCounters = 1;
+  while (nCounters < width) {
+    nCounters <<= 1;
+  }
+  m_mask = nCounters - 1;
+  m_counters.resize(N_ROWS * nCounters, 0);
+}
+
+size_t
+FrequencySketch::getIndex(name_tree::HashValue h, size_t row) const
+{
+  // double hashing: row k probes h1 + k * h2, with h2 odd to reach every counter
+  uint64_t h1 = static_cast<uint64_t>(h);
+  uint64_t h2 = ((h1 * 0x9E3779B97F4A7C15ULL) >> 32) | 1;
+  return row * this->getWidth() + static_cast<size_t>((h1 + row * h2) & m_mask);
+}
+
+void
+FrequencySketch::increment(name_tree::HashValue h)
+{
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    uint8_t& counter = m_counters[this->getIndex(h, row)];
+    if (counter < MAX_COUNT) {
+      ++counter;
+    }
+  }
+
+  if (++m_nIncrements >= SAMPLE_FACTOR * this->getWidth()) {
+    this->age();
+  }
+}
+
+uint8_t
+FrequencySketch::estimate(name_tree::HashValue h) const
+{
+  uint8_t count = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    count = std::min(count, m_counters[this->getIndex(h, row)]);
+  }
+  return count;
+}
+
+void
+FrequencySketch::age()
+{
+  for (uint8_t& counter : m_counters) {
+    counter >>= 1;
+  }
+  m_nIncrements /= 2;
+}
+
+const std::string TinyLfuPolicy::POLICY_NAME = "tinylfu";
+NFD_REGISTER_CS_POLICY(TinyLfuPolicy);
+
+TinyLfuPolicy::TinyLfuPolicy()
+  : Policy(POLICY_NAME)
+  , m_nRejected(0)
+{
+}
+
+void
+TinyLfuPolicy::doAfterInsert(iterator i)
+{
+  BOOST_ASSERT(m_queueIts.find(i) == m_queueIts.end());
+
+  this->record(i);
+  m_queueIts.insert(std::make_pair(i, m_queue.insert(m_queue.end(), i)));
+
+  if (this->isOverLimit() && m_queue.front() != i &&
+      this->estimate(i) <= this->estimate(m_queue.front())) {
+    ++m_nRejected;
+    this->detach(i);
+    this->emitSignal(beforeEvict, i);
+    return;
+  }
+
+  this->evictEntries();
+}
+
+void
+TinyLfuPolicy::doAfterRefresh(iterator i)
+{
+  this->doBeforeUse(i);
+}
+
+void
+TinyLfuPolicy::doBeforeErase(iterator i)
+{
+  this->detach(i);
+}
+
+void
+TinyLfuPolicy::doBeforeUse(iterator i)
+{
+  this->record(i);
+
+  auto it = m_queueIts.find(i);
+  BOOST_ASSERT(it != m_queueIts.end());
+  m_queue.splice(m_queue.end(), m_queue, it->second);
+}
+
+void
+TinyLfuPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    BOOST_ASSERT(!m_queue.empty());
+    iterator i = m_queue.front();
+    this->detach(i);
+    this->emitSignal(beforeEvict, i);
+  }
+}
+
+void
+TinyLfuPolicy::record(iterator i)
+{
+  // resize the sketch when the limit changes; counts start over
+  size_t width = std::min<size_t>(std::max<size_t>(this->getLimit(), 16), 1 << 22);
+  if (m_sketch.getWidth() < width || m_sketch.getWidth() >= 2 * width) {
+    m_sketch = FrequencySketch(width);
+  }
+
+  m_sketch.increment(name_tree::computeHash(i->getName()));
+}
+
+uint8_t
+TinyLfuPolicy::estimate(iterator i) const
+{
+  return m_sketch.estimate(name_tree::computeHash(i->getName()));
+}
+
+void
+TinyLfuPolicy::detach(iterator i)
+{
+  auto it = m_queueIts.find(i);
+  BOOST_ASSERT(it != m_queueIts.end());
+  m_queue.erase(it->second);
+  m_queueIts.erase(it);
+}
+
+} // namespace tinylfu
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
+
+#include "cs-policy.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tinylfu {
+
+/** \brief approximately counts recent occurrences of hashed Names
+ *
+ *  This is a count-min sketch of N_ROWS rows of 4-bit saturating counters. After a number of
+ *  increments proportional to the width, all counters are halved, so that estimates reflect
+ *  recent popularity rather than all-time popularity.
+ */
+class FrequencySketch
+{
+public:
+  /** \param width number of counters per row, rounded up to a power of two
+   */
+  explicit
+  FrequencySketch(size_t width = 16);
+
+  size_t
+  getWidth() const
+  {
+    return m_mask + 1;
+  }
+
+  void
+  increment(name_tree::HashValue h);
+
+  /** \return estimated number of recent increments of \p h, saturating at MAX_COUNT
+   */
+  uint8_t
+  estimate(name_tree::HashValue h) const;
+
+public:
+  static const size_t N_ROWS;
+  static const uint8_t MAX_COUNT;
+
+  /// increments between agings, per counter in a row
+  static const size_t SAMPLE_FACTOR;
+
+private:
+  size_t
+  getIndex(name_tree::HashValue h, size_t row) const;
+
+  /** \brief halves all counters
+   */
+  void
+  age();
+
+private:
+  std::vector<uint8_t> m_counters;
+  size_t m_mask;
+  size_t m_nIncrements;
+};
+
+typedef std::list<iterator> Queue;
+typedef Queue::iterator QueueIt;
+typedef std::unordered_map<iterator, QueueIt, EntryItHash> QueueItMap;
+
+/** \brief TinyLFU admission over LRU cs replacement policy
+ *
+ * A FrequencySketch counts insertions and uses of each Name. When a new entry would cause
+ * an eviction, it is only admitted if its Name has been requested more frequently than that of
+ * the least recently used entry; otherwise, the new entry itself is evicted. Once admitted,
+ * entries are replaced in LRU order.
+ *
+ * Unpopular Data, such as the long tail of a Zipf distribution or a scan, then cannot displace
+ * popular Data. The sketch is sized by the limit in number of entries.
+ */
+class TinyLfuPolicy : public Policy
+{
+public:
+  TinyLfuPolicy();
+
+  /** \return number of new entries that were not admitted
+   */
+  uint64_t
+  getNRejected() const
+  {
+    return m_nRejected;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) override;
+
+  virtual void
+  doAfterRefresh(iterator i) override;
+
+  virtual void
+  doBeforeErase(iterator i) override;
+
+  virtual void
+  doBeforeUse(iterator i) override;
+
+  virtual void
+  evictEntries() override;
+
+private:
+  /** \brief counts a request for the entry's Name
+   */
+  void
+  record(iterator i);
+
+  uint8_t
+  estimate(iterator i) const;
+
+  void
+  detach(iterator i);
+
+private:
+  FrequencySketch m_sketch;
+  Queue m_queue;
+  QueueItMap m_queueIts;
+  uint64_t m_nRejected;
+};
+
+} // namespace tinylfu
+
+using tinylfu::TinyLfuPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
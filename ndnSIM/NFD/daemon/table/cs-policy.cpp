@@ -39,16 +39,32 @@ Policy::getRegistry()
   return registry;
 }
 
+std::mutex&
+Policy::getRegistryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
 unique_ptr<Policy>
 Policy::create(const std::string& key)
 {
-  Registry& registry = getRegistry();
-  auto i = registry.find(key);
-  return i == registry.end() ? nullptr : i->second();
+  CreateFunc createFunc;
+  {
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    Registry& registry = getRegistry();
+    auto i = registry.find(key);
+    if (i == registry.end()) {
+      return nullptr;
+    }
+    createFunc = i->second;
+  }
+  return createFunc();
 }
 
 Policy::Policy(const std::string& policyName)
   : m_policyName(policyName)
+  , m_byteLimit(0)
 {
 }
 
@@ -60,6 +76,22 @@ Policy::setLimit(size_t nMaxEntries)
   this->evictEntries();
 }
 
+void
+Policy::setByteLimit(size_t nMaxBytes)
+{
+  NFD_LOG_INFO("setByteLimit " << nMaxBytes);
+  m_byteLimit = nMaxBytes;
+  this->evictEntries();
+}
+
+bool
+Policy::isOverLimit() const
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  return m_cs->size() > m_limit ||
+         (m_byteLimit > 0 && m_cs->getNBytes() > m_byteLimit);
+}
+
 void
 Policy::afterInsert(iterator i)
 {
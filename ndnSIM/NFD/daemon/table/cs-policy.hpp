@@ -29,11 +29,24 @@
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
 
+#include <mutex>
+
 namespace nfd {
 namespace cs {
 
 class Cs;
 
+/** \brief hashes Table iterators by entry address, for policies that index entries in hash tables
+ */
+struct EntryItHash
+{
+  size_t
+  operator()(const iterator& i) const
+  {
+    return std::hash<const EntryImpl*>()(&*i);
+  }
+};
+
 /** \brief represents a CS replacement policy
  */
 class Policy : noncopyable
@@ -44,6 +57,7 @@ public: // registry
   registerPolicy()
   {
     const std::string& key = P::POLICY_NAME;
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
     Registry& registry = getRegistry();
     BOOST_ASSERT(registry.count(key) == 0);
     registry[key] = [] { return make_unique<P>(); };
@@ -89,6 +103,22 @@ public:
   void
   setLimit(size_t nMaxEntries);
 
+  /** \brief gets hard limit (in bytes of stored Data packets)
+   *  \retval 0 the size of stored Data packets is unlimited
+   */
+  size_t
+  getByteLimit() const;
+
+  /** \brief sets hard limit (in bytes of stored Data packets)
+   *  \param nMaxBytes the limit, or 0 to only limit the number of entries
+   *  \post getByteLimit() == nMaxBytes
+   *  \post getByteLimit() == 0 || cs.getNBytes() <= getByteLimit()
+   *
+   *  The policy may evict entries if necessary.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
   /** \brief emits when an entry is being evicted
    *
    *  A policy implementation should emit this signal to cause CS to erase the entry from its index.
@@ -163,11 +193,16 @@ protected:
   doBeforeUse(iterator i) = 0;
 
   /** \brief evicts zero or more entries
-   *  \post CS size does not exceed hard limit
+   *  \post CS size does not exceed hard limits
    */
   virtual void
   evictEntries() = 0;
 
+  /** \return whether CS exceeds the hard limit in number of entries or in bytes
+   */
+  bool
+  isOverLimit() const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
 
@@ -178,9 +213,15 @@ private: // registry
   static Registry&
   getRegistry();
 
+  /** \brief guards the registry, as content stores of different nodes may be created concurrently
+   */
+  static std::mutex&
+  getRegistryMutex();
+
 private:
   std::string m_policyName;
   size_t m_limit;
+  size_t m_byteLimit;
   Cs* m_cs;
 };
 
@@ -208,6 +249,12 @@ Policy::getLimit() const
   return m_limit;
 }
 
+inline size_t
+Policy::getByteLimit() const
+{
+  return m_byteLimit;
+}
+
 } // namespace cs
 } // namespace nfd
 
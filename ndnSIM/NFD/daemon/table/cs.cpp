@@ -28,6 +28,8 @@
 #include "core/algorithm.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 
+#include "ns3/ndnSIM/utils/ndn-profiler.hpp"
+
 NFD_LOG_INIT("ContentStore");
 
 namespace nfd {
@@ -52,6 +54,11 @@ makeDefaultPolicy()
 }
 
 Cs::Cs(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : m_nBytes(0)
+  , m_isOrderedIndexValid(false)
+  , m_nOrderedIndexIdleOps(0)
+  , m_isHashIndexEnabled(false)
+  , m_nextSeqNo(0)
 {
   this->setPolicyImpl(std::move(policy));
   m_policy->setLimit(nMaxPackets);
@@ -69,19 +76,34 @@ Cs::getLimit() const
   return m_policy->getLimit();
 }
 
+void
+Cs::setByteLimit(size_t nMaxBytes)
+{
+  m_policy->setByteLimit(nMaxBytes);
+}
+
+size_t
+Cs::getByteLimit() const
+{
+  return m_policy->getByteLimit();
+}
+
 void
 Cs::setPolicy(unique_ptr<Policy> policy)
 {
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  size_t byteLimit = m_policy->getByteLimit();
   this->setPolicyImpl(std::move(policy));
   m_policy->setLimit(limit);
+  m_policy->setByteLimit(byteLimit);
 }
 
 void
 Cs::insert(const Data& data, bool isUnsolicited)
 {
+  NDNSIM_PROFILE_SCOPE(CONTENT_STORE);
   NFD_LOG_DEBUG("insert " << data.getName());
 
   if (m_policy->getLimit() == 0) {
@@ -98,10 +120,20 @@ Cs::insert(const Data& data, bool isUnsolicited)
     }
   }
 
+  if (m_admissionFilter && !m_admissionFilter(data)) {
+    NFD_LOG_DEBUG("  not-admitted");
+    return;
+  }
+
+  size_t byteLimit = m_policy->getByteLimit();
+  if (byteLimit > 0 && data.wireEncode().size() > byteLimit) {
+    NFD_LOG_DEBUG("  exceeds-byte-limit");
+    return;
+  }
+
   bool isNewEntry = false;
   iterator it;
-  // use .insert because gcc46 does not support .emplace
-  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited));
+  std::tie(it, isNewEntry) = this->insertEntry(data, isUnsolicited);
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
 
   entry.updateStaleTime();
@@ -127,25 +159,29 @@ Cs::find(const Interest& interest,
   BOOST_ASSERT(static_cast<bool>(hitCallback));
   BOOST_ASSERT(static_cast<bool>(missCallback));
 
-  const Name& prefix = interest.getName();
-  bool isRightmost = interest.getChildSelector() == 1;
-  NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
-
-  iterator first = m_table.lower_bound(prefix);
-  iterator last = m_table.end();
-  if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
-  }
+  NFD_LOG_DEBUG("find " << interest.getName() <<
+                (interest.getChildSelector() == 1 ? " R" : " L"));
 
-  iterator match = last;
-  if (isRightmost) {
-    match = this->findRightmost(interest, first, last);
-  }
-  else {
-    match = this->findLeftmost(interest, first, last);
+  iterator match = m_table.end();
+  {
+    // callbacks continue the forwarding pipelines and are not counted for the CS
+    NDNSIM_PROFILE_SCOPE(CONTENT_STORE);
+    bool isConclusive = false;
+    if (m_isHashIndexEnabled) {
+      std::tie(isConclusive, match) = this->findInHashIndex(interest);
+    }
+    if (!isConclusive) {
+      if (m_isHashIndexEnabled) {
+        this->ensureOrderedIndex();
+        match = this->findInOrder(m_orderedIndex, interest);
+      }
+      else {
+        match = this->findInOrder(m_table, interest);
+      }
+    }
   }
 
-  if (match == last) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("  no-match");
     missCallback(interest);
     return;
@@ -155,36 +191,262 @@ Cs::find(const Interest& interest,
   hitCallback(interest, match->getData());
 }
 
-iterator
-Cs::findLeftmost(const Interest& interest, iterator first, iterator last) const
+void
+Cs::setHashIndexEnabled(bool isEnabled)
+{
+  if (isEnabled == m_isHashIndexEnabled) {
+    return;
+  }
+  m_isHashIndexEnabled = isEnabled;
+  NFD_LOG_DEBUG("set-hash-index " << isEnabled);
+
+  m_hashIndex.clear();
+  m_prefixCounts.clear();
+  m_orderedIndex.clear();
+  m_isOrderedIndexValid = false;
+  m_nOrderedIndexIdleOps = 0;
+
+  // the Table changes its order, so entries are moved to a new Table and handed to the policy again
+  std::vector<EntryImpl> entries;
+  entries.reserve(m_table.size());
+  for (iterator it = m_table.begin(); it != m_table.end(); ++it) {
+    m_policy->beforeErase(it);
+    entries.push_back(*it);
+  }
+  Table(TableOrder(isEnabled)).swap(m_table);
+
+  for (EntryImpl& entry : entries) {
+    iterator it = m_table.end();
+    if (isEnabled) {
+      entry.setSeqNo(m_nextSeqNo++);
+      it = m_table.insert(m_table.end(), entry);
+      this->addToHashIndex(it, name_tree::computeHashes(it->getName()));
+    }
+    else {
+      it = m_table.insert(entry).first;
+    }
+    m_policy->afterInsert(it);
+  }
+}
+
+std::pair<iterator, bool>
+Cs::insertEntry(const Data& data, bool isUnsolicited)
 {
-  return std::find_if(first, last, bind(&cs::EntryImpl::canSatisfy, _1, interest));
+  if (!m_isHashIndexEnabled) {
+    // use .insert because gcc46 does not support .emplace
+    std::pair<iterator, bool> result = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited));
+    if (result.second) {
+      m_nBytes += data.wireEncode().size();
+    }
+    return result;
+  }
+
+  const Name& name = data.getName();
+  name_tree::HashSequence hashes = name_tree::computeHashes(name);
+  auto range = m_hashIndex.equal_range(hashes.back());
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second->getName() == name && i->second->getFullName() == data.getFullName()) {
+      return std::make_pair(i->second, false);
+    }
+  }
+
+  // the new entry has the largest sequence number, so the hint makes insertion constant time
+  iterator it = m_table.insert(m_table.end(),
+                               EntryImpl(data.shared_from_this(), isUnsolicited, m_nextSeqNo++));
+  this->addToHashIndex(it, hashes);
+  if (m_isOrderedIndexValid) {
+    m_orderedIndex.insert(it);
+    this->countOrderedIndexIdleOp();
+  }
+  m_nBytes += data.wireEncode().size();
+  return std::make_pair(it, true);
 }
 
-iterator
-Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
+void
+Cs::addToHashIndex(iterator it, const name_tree::HashSequence& hashes)
+{
+  // use .insert because gcc46 does not support .emplace
+  m_hashIndex.insert(std::make_pair(hashes.back(), it));
+  for (size_t prefixLen = 0; prefixLen < it->getName().size(); ++prefixLen) {
+    ++m_prefixCounts[hashes[prefixLen]];
+  }
+}
+
+void
+Cs::eraseEntry(iterator it)
+{
+  if (m_isHashIndexEnabled) {
+    if (m_isOrderedIndexValid) {
+      m_orderedIndex.erase(it);
+      this->countOrderedIndexIdleOp();
+    }
+
+    const Name& name = it->getName();
+    name_tree::HashSequence hashes = name_tree::computeHashes(name);
+    auto range = m_hashIndex.equal_range(hashes.back());
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second == it) {
+        m_hashIndex.erase(i);
+        break;
+      }
+    }
+    for (size_t prefixLen = 0; prefixLen < name.size(); ++prefixLen) {
+      auto count = m_prefixCounts.find(hashes[prefixLen]);
+      BOOST_ASSERT(count != m_prefixCounts.end() && count->second > 0);
+      if (--count->second == 0) {
+        m_prefixCounts.erase(count);
+      }
+    }
+  }
+
+  BOOST_ASSERT(m_nBytes >= it->getData().wireEncode().size());
+  m_nBytes -= it->getData().wireEncode().size();
+  m_table.erase(it);
+}
+
+std::pair<bool, iterator>
+Cs::findInHashIndex(const Interest& interest) const
+{
+  const iterator none = m_table.end();
+
+  if (interest.getChildSelector() == 1 ||
+      interest.getMinSuffixComponents() >= 0 ||
+      interest.getMaxSuffixComponents() >= 0 ||
+      !interest.getPublisherPublicKeyLocator().empty() ||
+      !interest.getExclude().empty()) {
+    return std::make_pair(false, none);
+  }
+
+  const Name& name = interest.getName();
+
+  // Data whose full Name equals Interest Name sorts first
+  if (!name.empty() && name[-1].isImplicitSha256Digest()) {
+    auto range = m_hashIndex.equal_range(name_tree::computeHash(name, name.size() - 1));
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second->getName().size() == name.size() - 1 && i->second->canSatisfy(interest)) {
+        return std::make_pair(true, i->second);
+      }
+    }
+  }
+
+  // then Data whose Name equals Interest Name, by implicit digest
+  iterator match = none;
+  auto range = m_hashIndex.equal_range(name_tree::computeHash(name));
+  for (auto i = range.first; i != range.second; ++i) {
+    const EntryImpl& entry = *i->second;
+    if (entry.getName() != name || !entry.canSatisfy(interest)) {
+      continue;
+    }
+    if (match == none || entry.getFullName()[-1] < match->getFullName()[-1]) {
+      match = i->second;
+    }
+  }
+  if (match != none) {
+    return std::make_pair(true, match);
+  }
+
+  // then Data under Interest Name, which only the ordered index can find
+  bool mayHaveDescendants = m_prefixCounts.count(name_tree::computeHash(name)) > 0;
+  return std::make_pair(!mayHaveDescendants, none);
+}
+
+static iterator
+toTableIt(iterator it)
+{
+  return it;
+}
+
+static iterator
+toTableIt(OrderedIndex::const_iterator it)
+{
+  return *it;
+}
+
+static const EntryImpl&
+getEntry(const EntryImpl& entry)
+{
+  return entry;
+}
+
+static const EntryImpl&
+getEntry(iterator it)
+{
+  return *it;
+}
+
+/** \brief determines whether an element of the Table or the ordered index can satisfy an Interest
+ */
+template<typename It>
+class CanSatisfy
+{
+public:
+  explicit
+  CanSatisfy(const Interest& interest)
+    : m_interest(interest)
+  {
+  }
+
+  bool
+  operator()(const typename std::iterator_traits<It>::value_type& element) const
+  {
+    return getEntry(element).canSatisfy(m_interest);
+  }
+
+private:
+  const Interest& m_interest;
+};
+
+/** \brief find leftmost match in [first,last)
+ *  \return the leftmost match, or last if not found
+ */
+template<typename It>
+static It
+findLeftmost(const Interest& interest, It first, It last)
+{
+  return std::find_if(first, last, CanSatisfy<It>(interest));
+}
+
+/** \brief find rightmost match among entries with exact Names in [first,last)
+ *  \return the rightmost match, or last if not found
+ */
+template<typename It>
+static It
+findRightmostAmongExact(const Interest& interest, It first, It last)
+{
+  return find_last_if(first, last, CanSatisfy<It>(interest));
+}
+
+/** \brief find rightmost match in [first,last)
+ *  \return the rightmost match, or last if not found
+ */
+template<typename Index>
+static typename Index::const_iterator
+findRightmost(const Index& index, const Interest& interest,
+              typename Index::const_iterator first, typename Index::const_iterator last)
 {
+  typedef typename Index::const_iterator It;
+
   // Each loop visits a sub-namespace under a prefix one component longer than Interest Name.
   // If there is a match in that sub-namespace, the leftmost match is returned;
   // otherwise, loop continues.
 
   size_t interestNameLength = interest.getName().size();
-  for (iterator right = last; right != first;) {
-    iterator prev = std::prev(right);
+  for (It right = last; right != first;) {
+    It prev = std::prev(right);
 
     // special case: [first,prev] have exact Names
-    if (prev->getName().size() == interestNameLength) {
-      NFD_LOG_TRACE("  find-among-exact " << prev->getName());
-      iterator matchExact = this->findRightmostAmongExact(interest, first, right);
+    if (getEntry(*prev).getName().size() == interestNameLength) {
+      NFD_LOG_TRACE("  find-among-exact " << getEntry(*prev).getName());
+      It matchExact = findRightmostAmongExact(interest, first, right);
       return matchExact == right ? last : matchExact;
     }
 
-    Name prefix = prev->getName().getPrefix(interestNameLength + 1);
-    iterator left = m_table.lower_bound(prefix);
+    Name prefix = getEntry(*prev).getName().getPrefix(interestNameLength + 1);
+    It left = index.lower_bound(EntryImpl(prefix));
 
     // normal case: [left,right) are under one-component-longer prefix
     NFD_LOG_TRACE("  find-under-prefix " << prefix);
-    iterator match = this->findLeftmost(interest, left, right);
+    It match = findLeftmost(interest, left, right);
     if (match != right) {
       return match;
     }
@@ -193,10 +455,62 @@ Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
   return last;
 }
 
+template<typename Index>
 iterator
-Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const
+Cs::findInOrder(const Index& index, const Interest& interest) const
 {
-  return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
+  typedef typename Index::const_iterator It;
+
+  const Name& prefix = interest.getName();
+  bool isRightmost = interest.getChildSelector() == 1;
+
+  It first = index.lower_bound(EntryImpl(prefix));
+  It last = index.end();
+  if (prefix.size() > 0) {
+    last = index.lower_bound(EntryImpl(prefix.getSuccessor()));
+  }
+
+  It match = last;
+  if (isRightmost) {
+    match = findRightmost(index, interest, first, last);
+  }
+  else {
+    match = findLeftmost(interest, first, last);
+  }
+
+  return match == last ? m_table.end() : toTableIt(match);
+}
+
+void
+Cs::ensureOrderedIndex() const
+{
+  BOOST_ASSERT(m_isHashIndexEnabled);
+  m_nOrderedIndexIdleOps = 0;
+  if (m_isOrderedIndexValid) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("build-ordered-index size=" << m_table.size());
+  for (iterator it = m_table.begin(); it != m_table.end(); ++it) {
+    m_orderedIndex.insert(it);
+  }
+  m_isOrderedIndexValid = true;
+}
+
+void
+Cs::countOrderedIndexIdleOp()
+{
+  // Rebuilding costs about as much as maintaining the index over half as many inserts and erases
+  // as there are entries, so dropping it then at most triples the cost of lookups that need it.
+  static const size_t MIN_IDLE_OPS = 64;
+  if (++m_nOrderedIndexIdleOps <= std::max(m_table.size() / 2, MIN_IDLE_OPS)) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("drop-ordered-index size=" << m_table.size());
+  m_orderedIndex.clear();
+  m_isOrderedIndexValid = false;
+  m_nOrderedIndexIdleOps = 0;
 }
 
 void
@@ -205,7 +519,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
-      m_table.erase(it);
+      this->eraseEntry(it);
     });
 
   m_policy->setCs(this);
@@ -27,23 +27,29 @@
  *
  *  \brief implements the ContentStore
  *
- *  This ContentStore implementation consists of two data structures,
- *  a Table, and a set of cleanup queues.
+ *  This ContentStore implementation consists of a Table, an optional hash index,
+ *  and a replacement policy.
  *
- *  The Table is a container (std::set) sorted by full Names of stored Data packets.
- *  Data packets are wrapped in Entry objects.
+ *  The Table is a container (std::set) of Entry objects.
  *  Each Entry contain the Data packet itself,
  *  and a few addition attributes such as the staleness of the Data packet.
+ *  Table iterators are stable, and are passed to the policy to identify entries.
  *
- *  The cleanup queues are three doubly linked lists which stores Table iterators.
- *  The three queues keep track of unsolicited, stale, and fresh Data packet, respectively.
- *  Table iterator is placed into, removed from, and moved between suitable queues
- *  whenever an Entry is added, removed, or has other attribute changes.
- *  The Table iterator of an Entry should be in exactly one queue at any moment.
- *  Within each queue, the iterators are kept in first-in-first-out order.
- *  Eviction procedure exhausts the first queue before moving onto the next queue,
- *  in the order of unsolicited, stale, and fresh queue.
- */
+ *  By default, the Table is sorted by full Names of stored Data packets, and serves every lookup.
+ *
+ *  When the hash index is enabled, the Table is sorted by insertion instead,
+ *  Table iterators are hashed by Data Name,
+ *  and a count of stored Data is kept for each hashed proper prefix of their Names.
+ *  Lookups without selectors other than MustBeFresh are then answered from the hash index,
+ *  including lookups by full Name and lookups that find nothing under the Interest Name.
+ *  Other lookups need an ordered index of Table iterators by full Name. It is built on demand,
+ *  and dropped once half as many Data packets as the ContentStore holds have been inserted or
+ *  erased without another lookup needing it.
+ *
+ *  The policy decides which entries to evict when the ContentStore is over its limits,
+ *  which bound the number of entries and, optionally, the total size of stored Data packets.
+ *  An optional admission filter decides which Data packets are stored at all.
+  */
 
 #ifndef NFD_DAEMON_TABLE_CS_HPP
 #define NFD_DAEMON_TABLE_CS_HPP
@@ -51,8 +57,12 @@
 #include "cs-policy.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "name-tree-hashtable.hpp"
 #include <ndn-cxx/util/signal.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/identity.hpp>
 
 namespace nfd {
 namespace cs {
@@ -60,6 +70,40 @@ namespace cs {
 unique_ptr<Policy>
 makeDefaultPolicy();
 
+/** \brief orders Table iterators by full Names of their entries
+ *
+ *  Overloads taking an EntryImpl allow looking up the ordered index by a query or Data entry.
+ */
+struct EntryItComparator
+{
+  bool
+  operator()(const iterator& a, const iterator& b) const
+  {
+    return *a < *b;
+  }
+
+  bool
+  operator()(const EntryImpl& a, const iterator& b) const
+  {
+    return a < *b;
+  }
+
+  bool
+  operator()(const iterator& a, const EntryImpl& b) const
+  {
+    return *a < b;
+  }
+};
+
+typedef boost::multi_index_container<
+    iterator,
+    boost::multi_index::indexed_by<
+      boost::multi_index::ordered_unique<
+        boost::multi_index::identity<iterator>, EntryItComparator
+      >
+    >
+  > OrderedIndex;
+
 /** \brief represents the ContentStore
  */
 class Cs : noncopyable
@@ -104,6 +148,36 @@ public:
   size_t
   getLimit() const;
 
+  /** \brief changes capacity (in bytes of stored Data packets)
+   *  \param nMaxBytes the capacity, or 0 to only limit the number of packets
+   *
+   *  The size of a Data packet is the size of its wire encoding.
+   *  A Data packet larger than the capacity is not stored.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** \return capacity (in bytes of stored Data packets), or 0 if unlimited
+   */
+  size_t
+  getByteLimit() const;
+
+  /** \brief determines whether a Data packet may be stored
+   *  \return true to store the Data packet, false to skip it
+   */
+  typedef std::function<bool(const Data& data)> AdmissionFilter;
+
+  /** \brief sets the admission filter
+   *  \param filter the filter, or an empty function to admit every Data packet
+   *
+   *  The filter is consulted before a Data packet is inserted. It does not affect stored entries.
+   */
+  void
+  setAdmissionFilter(const AdmissionFilter& filter)
+  {
+    m_admissionFilter = filter;
+  }
+
   /** \brief changes cs replacement policy
    *  \pre size() == 0
    */
@@ -118,6 +192,21 @@ public:
     return m_policy.get();
   }
 
+  /** \brief enables or disables the hash index
+   *
+   *  When enabled, inserts and lookups without selectors other than MustBeFresh do not compare
+   *  Names with stored entries. When disabled, the hash index is released.
+   *  Stored entries are kept, but the policy sees them as newly inserted.
+   */
+  void
+  setHashIndexEnabled(bool isEnabled);
+
+  bool
+  isHashIndexEnabled() const
+  {
+    return m_isHashIndexEnabled;
+  }
+
   /** \return number of stored packets
    */
   size_t
@@ -126,10 +215,26 @@ public:
     return m_table.size();
   }
 
+  /** \return total size of stored Data packets, in bytes
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
 
+  /** \return whether the ordered index is built and maintained
+   */
+  bool
+  hasOrderedIndex() const
+  {
+    return m_isOrderedIndexValid;
+  }
+
 public: // enumeration
   struct EntryFromEntryImpl
   {
@@ -158,30 +263,83 @@ public: // enumeration
     return boost::make_transform_iterator(m_table.end(), EntryFromEntryImpl());
   }
 
+private: // insert and erase
+  /** \brief inserts an entry for \p data into the Table and the indexes
+   *  \return iterator to the new or existing entry, and whether it is new
+   */
+  std::pair<iterator, bool>
+  insertEntry(const Data& data, bool isUnsolicited);
+
+  /** \brief adds a Table entry to the hash index
+   *  \param hashes hashes of all prefixes of the entry Name
+   */
+  void
+  addToHashIndex(iterator it, const name_tree::HashSequence& hashes);
+
+  /** \brief erases an entry from the indexes and the Table
+   */
+  void
+  eraseEntry(iterator it);
+
 private: // find
-  /** \brief find leftmost match in [first,last)
-   *  \return the leftmost match, or last if not found
+  typedef OrderedIndex::const_iterator IndexIt;
+
+  /** \brief attempts to find the best match with the hash index
+   *  \return whether the result is conclusive, and the match or m_table.end() if none
+   *
+   *  The result is not conclusive if the Interest has selectors that need the ordered index,
+   *  or if there may be Data under the Interest Name that could be a better match.
    */
-  iterator
-  findLeftmost(const Interest& interest, iterator left, iterator right) const;
+  std::pair<bool, iterator>
+  findInHashIndex(const Interest& interest) const;
 
-  /** \brief find rightmost match in [first,last)
-   *  \return the rightmost match, or last if not found
+  /** \brief finds the best match among entries sorted by full Name
+   *  \param index the Table when sorted by full Name, or the ordered index
+   *  \return the match, or m_table.end() if none
    */
+  template<typename Index>
   iterator
-  findRightmost(const Interest& interest, iterator first, iterator last) const;
+  findInOrder(const Index& index, const Interest& interest) const;
 
-  /** \brief find rightmost match among entries with exact Names in [first,last)
-   *  \return the rightmost match, or last if not found
+  /** \brief builds the ordered index if it is not being maintained
    */
-  iterator
-  findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
+  void
+  ensureOrderedIndex() const;
+
+  /** \brief drops the ordered index if it has been maintained for too long without being used
+   */
+  void
+  countOrderedIndexIdleOp();
 
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
 private:
   Table m_table;
+  size_t m_nBytes;
+  AdmissionFilter m_admissionFilter;
+
+  /** \brief Table iterators ordered by full Name, valid if m_isOrderedIndexValid
+   *
+   *  Only used when the hash index is enabled, because the Table is then sorted by insertion.
+   */
+  mutable OrderedIndex m_orderedIndex;
+  mutable bool m_isOrderedIndexValid;
+  /** \brief inserts and erases since the ordered index was last used
+   */
+  mutable size_t m_nOrderedIndexIdleOps;
+
+  bool m_isHashIndexEnabled;
+  uint64_t m_nextSeqNo;
+
+  /** \brief Table iterators keyed by hash of Data Name
+   */
+  std::unordered_multimap<name_tree::HashValue, iterator> m_hashIndex;
+
+  /** \brief number of stored Data under each hashed proper prefix of their Names
+   */
+  std::unordered_map<name_tree::HashValue, size_t> m_prefixCounts;
+
   unique_ptr<Policy> m_policy;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
 };
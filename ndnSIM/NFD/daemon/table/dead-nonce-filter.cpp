@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+#include "core/logger.hpp"
+#include "core/random.hpp"
+
+#include <cmath>
+#include <numeric>
+
+NFD_LOG_INIT("DeadNonceFilter");
+
+namespace nfd {
+
+const size_t DeadNonceFilter::N_GENERATIONS = 5;
+const size_t DeadNonceFilter::BUCKET_SIZE = 4;
+const size_t DeadNonceFilter::MAX_KICKS = 500;
+const double DeadNonceFilter::MAX_LOAD_FACTOR = 0.9;
+
+DeadNonceFilter::DeadNonceFilter(const time::nanoseconds& lifetime, size_t capacity,
+                                 double falsePositiveRate)
+  : m_lifetime(lifetime)
+  , m_capacity(capacity)
+  , m_falsePositiveRate(falsePositiveRate)
+  , m_generationSizes(N_GENERATIONS, 0)
+  , m_currentGeneration(0)
+  , m_nOverflows(0)
+  , m_rotateInterval(m_lifetime / (N_GENERATIONS - 1))
+{
+  if (m_capacity == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("capacity must be positive"));
+  }
+  if (!(m_falsePositiveRate > 0.0 && m_falsePositiveRate < 1.0)) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("falsePositiveRate must be in (0,1)"));
+  }
+
+  // has() probes 2 buckets in each generation, and every probed slot matches a foreign
+  // fingerprint with probability 2^-bits
+  double nProbedSlots = 2.0 * BUCKET_SIZE * N_GENERATIONS;
+  size_t nBits = static_cast<size_t>(std::ceil(std::log2(nProbedSlots / m_falsePositiveRate)));
+  m_fingerprintBytes = std::min<size_t>((nBits + 7) / 8, sizeof(Fingerprint));
+  m_fingerprintMask = m_fingerprintBytes == sizeof(Fingerprint) ?
+                      std::numeric_limits<Fingerprint>::max() :
+                      (Fingerprint(1) << (8 * m_fingerprintBytes)) - 1;
+
+  size_t nEntriesPerGeneration = (m_capacity + N_GENERATIONS - 2) / (N_GENERATIONS - 1);
+  size_t nSlotsPerGeneration =
+    static_cast<size_t>(std::ceil(nEntriesPerGeneration / MAX_LOAD_FACTOR));
+  size_t nMinBuckets = (nSlotsPerGeneration + BUCKET_SIZE - 1) / BUCKET_SIZE;
+  m_nBuckets = 1;
+  while (m_nBuckets < nMinBuckets) {
+    m_nBuckets <<= 1;
+  }
+
+  m_slots.resize(N_GENERATIONS * m_nBuckets * BUCKET_SIZE * m_fingerprintBytes, 0);
+
+  NFD_LOG_DEBUG("capacity=" << m_capacity << " fpBytes=" << m_fingerprintBytes <<
+                " nBuckets=" << m_nBuckets << " memory=" << m_slots.size());
+
+  m_rotateEvent = scheduler::schedule(m_rotateInterval, bind(&DeadNonceFilter::rotate, this));
+}
+
+DeadNonceFilter::~DeadNonceFilter()
+{
+  scheduler::cancel(m_rotateEvent);
+
+  static_assert(BUCKET_SIZE >= 1, "BUCKET_SIZE must be at least 1");
+  BOOST_ASSERT_MSG(N_GENERATIONS >= 2, "N_GENERATIONS must allow one generation to expire");
+  BOOST_ASSERT_MSG(MAX_LOAD_FACTOR > 0.0 && MAX_LOAD_FACTOR <= 1.0,
+                   "MAX_LOAD_FACTOR must be in (0,1]");
+}
+
+size_t
+DeadNonceFilter::size() const
+{
+  return std::accumulate(m_generationSizes.begin(), m_generationSizes.end(), size_t(0));
+}
+
+bool
+DeadNonceFilter::has(Entry entry) const
+{
+  Fingerprint fp = this->makeFingerprint(entry);
+  size_t bucket1 = static_cast<size_t>(entry) & (m_nBuckets - 1);
+  size_t bucket2 = this->getAltBucket(bucket1, fp);
+
+  for (size_t generation = 0; generation < N_GENERATIONS; ++generation) {
+    if (m_generationSizes[generation] == 0) {
+      continue;
+    }
+    if (this->hasInBucket(generation, bucket1, fp) ||
+        this->hasInBucket(generation, bucket2, fp)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+DeadNonceFilter::add(Entry entry)
+{
+  Fingerprint fp = this->makeFingerprint(entry);
+  size_t bucket1 = static_cast<size_t>(entry) & (m_nBuckets - 1);
+  size_t bucket2 = this->getAltBucket(bucket1, fp);
+  size_t generation = m_currentGeneration;
+
+  if (this->hasInBucket(generation, bucket1, fp) ||
+      this->hasInBucket(generation, bucket2, fp)) {
+    // already recorded in this generation, which expires no earlier than a new copy would
+    return;
+  }
+
+  if (this->insertIntoBucket(generation, bucket1, fp) ||
+      this->insertIntoBucket(generation, bucket2, fp)) {
+    ++m_generationSizes[generation];
+    return;
+  }
+
+  std::uniform_int_distribution<size_t> slotDist(0, BUCKET_SIZE - 1);
+  size_t bucket = (getGlobalRng()() & 1) == 0 ? bucket1 : bucket2;
+  for (size_t nKicks = 0; nKicks < MAX_KICKS; ++nKicks) {
+    size_t slot = slotDist(getGlobalRng());
+    Fingerprint victim = this->getSlot(generation, bucket, slot);
+    this->setSlot(generation, bucket, slot, fp);
+    fp = victim;
+    bucket = this->getAltBucket(bucket, fp);
+
+    if (this->insertIntoBucket(generation, bucket, fp)) {
+      ++m_generationSizes[generation];
+      return;
+    }
+  }
+
+  // fp is homeless: one fingerprint was added and another one is lost
+  ++m_nOverflows;
+  NFD_LOG_DEBUG("add overflow generation=" << generation <<
+                " size=" << m_generationSizes[generation]);
+}
+
+DeadNonceFilter::Fingerprint
+DeadNonceFilter::makeFingerprint(Entry entry) const
+{
+  // Entry is already a hash: low bits select the bucket, high bits make the fingerprint
+  Fingerprint fp = static_cast<Fingerprint>(entry >> 32) & m_fingerprintMask;
+  return fp == 0 ? 1 : fp;
+}
+
+size_t
+DeadNonceFilter::getAltBucket(size_t bucket, Fingerprint fp) const
+{
+  // multiplication spreads short fingerprints over all bucket bits;
+  // XOR makes the mapping an involution, so either bucket leads to the other
+  return (bucket ^ (static_cast<size_t>(fp) * 0x5bd1e995)) & (m_nBuckets - 1);
+}
+
+DeadNonceFilter::Fingerprint
+DeadNonceFilter::getSlot(size_t generation, size_t bucket, size_t slot) const
+{
+  const uint8_t* p = &m_slots[((generation * m_nBuckets + bucket) * BUCKET_SIZE + slot) *
+                              m_fingerprintBytes];
+  Fingerprint fp = 0;
+  for (size_t i = 0; i < m_fingerprintBytes; ++i) {
+    fp |= static_cast<Fingerprint>(p[i]) << (8 * i);
+  }
+  return fp;
+}
+
+void
+DeadNonceFilter::setSlot(size_t generation, size_t bucket, size_t slot, Fingerprint fp)
+{
+  uint8_t* p = &m_slots[((generation * m_nBuckets + bucket) * BUCKET_SIZE + slot) *
+                        m_fingerprintBytes];
+  for (size_t i = 0; i < m_fingerprintBytes; ++i) {
+    p[i] = static_cast<uint8_t>(fp >> (8 * i));
+  }
+}
+
+bool
+DeadNonceFilter::hasInBucket(size_t generation, size_t bucket, Fingerprint fp) const
+{
+  for (size_t slot = 0; slot < BUCKET_SIZE; ++slot) {
+    if (this->getSlot(generation, bucket, slot) == fp) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DeadNonceFilter::insertIntoBucket(size_t generation, size_t bucket, Fingerprint fp)
+{
+  for (size_t slot = 0; slot < BUCKET_SIZE; ++slot) {
+    if (this->getSlot(generation, bucket, slot) == 0) {
+      this->setSlot(generation, bucket, slot, fp);
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+DeadNonceFilter::rotate()
+{
+  m_currentGeneration = (m_currentGeneration + 1) % N_GENERATIONS;
+
+  size_t generationBytes = m_nBuckets * BUCKET_SIZE * m_fingerprintBytes;
+  auto begin = m_slots.begin() + m_currentGeneration * generationBytes;
+  std::fill(begin, begin + generationBytes, 0);
+  m_generationSizes[m_currentGeneration] = 0;
+
+  NFD_LOG_TRACE("rotate generation=" << m_currentGeneration << " size=" << this->size());
+
+  m_rotateEvent = scheduler::schedule(m_rotateInterval, bind(&DeadNonceFilter::rotate, this));
+}
+
+} // namespace nfd
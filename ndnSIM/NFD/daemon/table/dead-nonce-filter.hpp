@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "core/common.hpp"
+#include "core/scheduler.hpp"
+
+namespace nfd {
+
+/** \brief a time-bucketed cuckoo filter of Name+Nonce hashes
+ *
+ *  The filter consists of N_GENERATIONS cuckoo filters of identical, fixed size, all allocated
+ *  in one array when the filter is constructed. New hashes are added to the current generation.
+ *  Every lifetime / (N_GENERATIONS - 1), the oldest generation is wiped and becomes the current
+ *  one, so that a hash is kept for at least lifetime, and at most
+ *  lifetime * N_GENERATIONS / (N_GENERATIONS - 1).
+ *
+ *  Each generation stores a short fingerprint of every hash in one of two candidate buckets of
+ *  BUCKET_SIZE slots. Fingerprint width is chosen from the requested false positive rate, which
+ *  bounds the probability that has() returns true for a hash that was never added.
+ *
+ *  Memory usage is independent of the traffic: it depends only on capacity and false positive
+ *  rate. If more than capacity / (N_GENERATIONS - 1) hashes are added within one rotation
+ *  interval, a generation can overflow, and the fingerprint that cannot be placed is dropped.
+ *  Like an eviction from a full DeadNonceList, this may cause a loop to go undetected.
+ */
+class DeadNonceFilter : noncopyable
+{
+public:
+  typedef uint64_t Entry;
+
+  /** \brief constructs the filter
+   *  \param lifetime minimum duration each hash is kept
+   *  \param capacity maximum number of hashes expected to be added within any lifetime
+   *  \param falsePositiveRate upper bound of the false positive rate of has()
+   *  \throw std::invalid_argument capacity is zero, or falsePositiveRate is not in (0,1)
+   */
+  DeadNonceFilter(const time::nanoseconds& lifetime, size_t capacity, double falsePositiveRate);
+
+  ~DeadNonceFilter();
+
+  /** \brief determines if \p entry may have been added within lifetime
+   */
+  bool
+  has(Entry entry) const;
+
+  /** \brief records \p entry
+   */
+  void
+  add(Entry entry);
+
+  /** \return number of fingerprints stored in all generations
+   */
+  size_t
+  size() const;
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  double
+  getFalsePositiveRate() const
+  {
+    return m_falsePositiveRate;
+  }
+
+  /** \return number of bytes occupied by fingerprints of all generations
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_slots.size();
+  }
+
+  /** \return number of fingerprints dropped because a generation was full
+   */
+  uint64_t
+  getNOverflows() const
+  {
+    return m_nOverflows;
+  }
+
+private:
+  typedef uint32_t Fingerprint;
+
+  Fingerprint
+  makeFingerprint(Entry entry) const;
+
+  size_t
+  getAltBucket(size_t bucket, Fingerprint fp) const;
+
+  Fingerprint
+  getSlot(size_t generation, size_t bucket, size_t slot) const;
+
+  void
+  setSlot(size_t generation, size_t bucket, size_t slot, Fingerprint fp);
+
+  bool
+  hasInBucket(size_t generation, size_t bucket, Fingerprint fp) const;
+
+  /** \brief stores \p fp into an empty slot of \p bucket in \p generation
+   *  \return whether an empty slot was found
+   */
+  bool
+  insertIntoBucket(size_t generation, size_t bucket, Fingerprint fp);
+
+  /** \brief wipes the oldest generation and makes it current
+   */
+  void
+  rotate();
+
+public:
+  /// number of time buckets
+  static const size_t N_GENERATIONS;
+
+  /// number of fingerprints per cuckoo bucket
+  static const size_t BUCKET_SIZE;
+
+  /// maximum number of relocations attempted by one insertion
+  static const size_t MAX_KICKS;
+
+  /// maximum expected load factor of a generation, used for sizing
+  static const double MAX_LOAD_FACTOR;
+
+private:
+  time::nanoseconds m_lifetime;
+  size_t m_capacity;
+  double m_falsePositiveRate;
+
+  size_t m_fingerprintBytes;
+  Fingerprint m_fingerprintMask;
+  size_t m_nBuckets; ///< number of buckets per generation, a power of two
+
+  /** \brief fingerprints of all generations, zero means an empty slot
+   *
+   *  Generation g, bucket b, slot s is stored at
+   *  ((g * m_nBuckets + b) * BUCKET_SIZE + s) * m_fingerprintBytes.
+   */
+  std::vector<uint8_t> m_slots;
+  std::vector<size_t> m_generationSizes;
+  size_t m_currentGeneration;
+  uint64_t m_nOverflows;
+
+  time::nanoseconds m_rotateInterval;
+  scheduler::EventId m_rotateEvent;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
@@ -54,19 +54,12 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
-  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
-  }
-
-  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  this->startCapacityControl();
 }
 
 DeadNonceList::~DeadNonceList()
 {
-  scheduler::cancel(m_markEvent);
-  scheduler::cancel(m_adjustCapacityEvent);
+  this->stopCapacityControl();
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -83,6 +76,9 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  if (m_filter != nullptr) {
+    return m_filter->size();
+  }
   return m_queue.size() - this->countMarks();
 }
 
@@ -90,6 +86,9 @@ bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    return m_filter->has(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -97,11 +96,57 @@ void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    m_filter->add(entry);
+    return;
+  }
   m_queue.push_back(entry);
 
   this->evictEntries();
 }
 
+void
+DeadNonceList::enableFilter(size_t capacity, double falsePositiveRate)
+{
+  if (m_filter != nullptr &&
+      m_filter->getCapacity() == capacity &&
+      m_filter->getFalsePositiveRate() == falsePositiveRate) {
+    return;
+  }
+
+  auto filter = make_unique<DeadNonceFilter>(m_lifetime, capacity, falsePositiveRate);
+
+  if (m_filter == nullptr) {
+    for (Entry entry : m_queue) {
+      if (entry != MARK) {
+        filter->add(entry);
+      }
+    }
+
+    this->stopCapacityControl();
+    Index().swap(m_index);
+    m_actualMarkCounts.clear();
+    m_capacity = INITIAL_CAPACITY;
+  }
+  m_filter = std::move(filter);
+
+  NFD_LOG_DEBUG("enableFilter capacity=" << capacity << " fpRate=" << falsePositiveRate <<
+                " memory=" << m_filter->getMemoryUsage());
+}
+
+void
+DeadNonceList::disableFilter()
+{
+  if (m_filter == nullptr) {
+    return;
+  }
+
+  m_filter.reset();
+  this->startCapacityControl();
+
+  NFD_LOG_DEBUG("disableFilter");
+}
+
 DeadNonceList::Entry
 DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
 {
@@ -125,7 +170,7 @@ DeadNonceList::mark()
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
@@ -168,4 +213,23 @@ DeadNonceList::evictEntries()
   BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
+void
+DeadNonceList::startCapacityControl()
+{
+  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
+    m_queue.push_back(MARK);
+  }
+
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
+                                              bind(&DeadNonceList::adjustCapacity, this));
+}
+
+void
+DeadNonceList::stopCapacityControl()
+{
+  scheduler::cancel(m_markEvent);
+  scheduler::cancel(m_adjustCapacityEvent);
+}
+
 } // namespace nfd
@@ -31,6 +31,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
+#include "dead-nonce-filter.hpp"
 
 namespace nfd {
 
@@ -50,6 +51,9 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Alternatively, entries can be stored in a DeadNonceFilter, which has fixed memory usage
+ *  and no per-entry allocation, at the cost of a configurable false positive rate.
  */
 class DeadNonceList : noncopyable
 {
@@ -88,6 +92,33 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
+public: // filter
+  /** \brief stores entries in a time-bucketed cuckoo filter instead of the index
+   *  \param capacity maximum number of Nonces expected to be added within lifetime
+   *  \param falsePositiveRate upper bound of the false positive rate of has()
+   *  \throw std::invalid_argument capacity is zero, or falsePositiveRate is not in (0,1)
+   *
+   *  Entries in the index are moved into the filter, and the index releases its memory.
+   *  If a filter with different parameters is in use, its entries are discarded.
+   */
+  void
+  enableFilter(size_t capacity, double falsePositiveRate);
+
+  /** \brief stores entries in the index again
+   *
+   *  Entries in the filter are discarded, because a filter cannot enumerate them.
+   */
+  void
+  disableFilter();
+
+  /** \return the filter in use, or nullptr if entries are stored in the index
+   */
+  const DeadNonceFilter*
+  getFilter() const
+  {
+    return m_filter.get();
+  }
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -131,6 +162,14 @@ private: // actual lifetime estimation and capacity control
   void
   evictEntries();
 
+  /** \brief fills the index with initial MARKs and schedules capacity control
+   */
+  void
+  startCapacityControl();
+
+  void
+  stopCapacityControl();
+
 public:
   /// default entry lifetime
   static const time::nanoseconds DEFAULT_LIFETIME;
@@ -143,6 +182,7 @@ private:
   Index m_index;
   Queue& m_queue;
   Hashtable& m_ht;
+  unique_ptr<DeadNonceFilter> m_filter;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
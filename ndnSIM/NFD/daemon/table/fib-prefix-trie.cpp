@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fib-prefix-trie.hpp"
+#include "fib-entry.hpp"
+#include "core/city-hash.hpp"
+
+namespace nfd {
+namespace fib {
+
+/** \brief hashes a name component by its TLV-TYPE and TLV-VALUE
+ */
+class ComponentHash
+{
+public:
+  size_t
+  operator()(const name::Component& component) const
+  {
+    return static_cast<size_t>(CityHash64(reinterpret_cast<const char*>(component.value()),
+                                          component.value_size()) ^ component.type());
+  }
+};
+
+class PrefixTrie::Node : noncopyable
+{
+public:
+  Node()
+    : parent(nullptr)
+    , entry(nullptr)
+  {
+  }
+
+public:
+  /** \brief name components between the parent node and this node
+   *
+   *  The root has an empty label; every other node has at least one component.
+   */
+  std::vector<name::Component> label;
+  Node* parent;
+  Entry* entry;
+
+  /** \brief children keyed by the first component of their labels
+   */
+  std::unordered_map<name::Component, unique_ptr<Node>, ComponentHash> children;
+};
+
+struct PrefixTrie::Step
+{
+  const Node* node;
+  size_t depth;
+  Entry* match;
+};
+
+/** \return how many leading components of \p label equal the components of \p name
+ *          starting at \p depth
+ */
+static size_t
+matchLabel(const std::vector<name::Component>& label, const Name& name, size_t depth)
+{
+  size_t len = std::min(label.size(), name.size() - depth);
+  size_t i = 0;
+  while (i < len && label[i] == name[depth + i]) {
+    ++i;
+  }
+  return i;
+}
+
+const PrefixTrie::Node*
+PrefixTrie::findMatchingChild(const Node& node, const Name& name, size_t depth)
+{
+  auto it = node.children.find(name[depth]);
+  if (it == node.children.end()) {
+    return nullptr;
+  }
+
+  const Node* child = it->second.get();
+  if (depth + child->label.size() > name.size() ||
+      matchLabel(child->label, name, depth) != child->label.size()) {
+    return nullptr;
+  }
+  return child;
+}
+
+PrefixTrie::PrefixTrie()
+  : m_root(make_unique<Node>())
+  , m_nEntries(0)
+{
+}
+
+PrefixTrie::~PrefixTrie() = default;
+
+void
+PrefixTrie::insert(Entry& entry)
+{
+  const Name& prefix = entry.getPrefix();
+  Node* node = m_root.get();
+  size_t depth = 0;
+
+  while (depth < prefix.size()) {
+    auto it = node->children.find(prefix[depth]);
+    if (it == node->children.end()) {
+      auto leaf = make_unique<Node>();
+      leaf->label.assign(prefix.begin() + depth, prefix.end());
+      leaf->parent = node;
+      node = node->children.emplace(prefix[depth], std::move(leaf)).first->second.get();
+      break;
+    }
+
+    Node* child = it->second.get();
+    size_t nMatched = matchLabel(child->label, prefix, depth);
+    BOOST_ASSERT(nMatched > 0);
+    if (nMatched < child->label.size()) {
+      // split the edge: a new node takes the matched part of the label
+      auto mid = make_unique<Node>();
+      mid->label.assign(child->label.begin(), child->label.begin() + nMatched);
+      mid->parent = node;
+
+      unique_ptr<Node> tail = std::move(it->second);
+      tail->label.erase(tail->label.begin(), tail->label.begin() + nMatched);
+      tail->parent = mid.get();
+      name::Component tailKey = tail->label.front();
+      mid->children.emplace(tailKey, std::move(tail));
+
+      child = mid.get();
+      it->second = std::move(mid);
+    }
+
+    node = child;
+    depth += nMatched;
+  }
+
+  BOOST_ASSERT(node->entry == nullptr);
+  node->entry = &entry;
+  ++m_nEntries;
+}
+
+void
+PrefixTrie::erase(const Name& prefix)
+{
+  Node* node = m_root.get();
+  size_t depth = 0;
+
+  while (depth < prefix.size()) {
+    Node* child = const_cast<Node*>(findMatchingChild(*node, prefix, depth));
+    if (child == nullptr) {
+      return;
+    }
+    node = child;
+    depth += child->label.size();
+  }
+
+  if (node->entry == nullptr) {
+    return;
+  }
+  node->entry = nullptr;
+  --m_nEntries;
+  this->compact(node);
+}
+
+void
+PrefixTrie::compact(Node* node)
+{
+  while (node != m_root.get() && node->entry == nullptr) {
+    Node* parent = node->parent;
+    name::Component key = node->label.front();
+    auto it = parent->children.find(key);
+    BOOST_ASSERT(it != parent->children.end() && it->second.get() == node);
+
+    if (node->children.empty()) {
+      parent->children.erase(it);
+      node = parent;
+      continue;
+    }
+
+    if (node->children.size() == 1) {
+      unique_ptr<Node> child = std::move(node->children.begin()->second);
+      node->children.clear();
+      child->label.insert(child->label.begin(), node->label.begin(), node->label.end());
+      child->parent = parent;
+      it->second = std::move(child); // deletes node
+    }
+    break;
+  }
+}
+
+void
+PrefixTrie::clear()
+{
+  m_root = make_unique<Node>();
+  m_nEntries = 0;
+}
+
+void
+PrefixTrie::walk(const Name& name, std::vector<Step>& path) const
+{
+  BOOST_ASSERT(!path.empty());
+  const Node* node = path.back().node;
+  size_t depth = path.back().depth;
+  Entry* match = path.back().match;
+
+  while (depth < name.size()) {
+    const Node* child = findMatchingChild(*node, name, depth);
+    if (child == nullptr) {
+      break;
+    }
+
+    node = child;
+    depth += child->label.size();
+    if (node->entry != nullptr) {
+      match = node->entry;
+    }
+    path.push_back({node, depth, match});
+  }
+}
+
+Entry*
+PrefixTrie::findLongestPrefixMatch(const Name& name) const
+{
+  Entry* match = m_root->entry;
+  const Node* node = m_root.get();
+  size_t depth = 0;
+
+  while (depth < name.size()) {
+    const Node* child = findMatchingChild(*node, name, depth);
+    if (child == nullptr) {
+      break;
+    }
+
+    node = child;
+    depth += child->label.size();
+    if (node->entry != nullptr) {
+      match = node->entry;
+    }
+  }
+  return match;
+}
+
+void
+PrefixTrie::findLongestPrefixMatch(const std::vector<const Name*>& names,
+                                   std::vector<Entry*>& matches) const
+{
+  matches.clear();
+  matches.reserve(names.size());
+
+  std::vector<Step> path;
+  path.push_back({m_root.get(), 0, m_root->entry});
+  const Name* prev = nullptr;
+
+  for (const Name* name : names) {
+    if (name == nullptr) {
+      matches.push_back(nullptr);
+      continue;
+    }
+
+    if (prev != nullptr) {
+      // keep only the nodes whose path is also a prefix of this name
+      size_t maxDepth = std::min(path.back().depth, name->size());
+      size_t nShared = 0;
+      while (nShared < maxDepth && (*prev)[nShared] == (*name)[nShared]) {
+        ++nShared;
+      }
+      while (path.back().depth > nShared) {
+        path.pop_back();
+      }
+    }
+
+    this->walk(*name, path);
+    matches.push_back(path.back().match);
+    prev = name;
+  }
+}
+
+} // namespace fib
+} // namespace nfd
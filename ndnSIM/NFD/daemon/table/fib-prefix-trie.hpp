@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_FIB_PREFIX_TRIE_HPP
+#define NFD_DAEMON_TABLE_FIB_PREFIX_TRIE_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace fib {
+
+class Entry;
+
+/** \brief a compressed name component trie that indexes FIB entries by their prefixes
+ *
+ *  Every node is labelled with one or more name components. A node that has no FIB entry
+ *  and only one child is merged with that child, so the depth of the trie is bounded by
+ *  the number of FIB entries on a path rather than by the length of their prefixes.
+ *
+ *  Longest prefix match walks down from the root and stops at the first mismatch. Its cost
+ *  therefore depends on the depth of the FIB, not on the length of the looked up name,
+ *  which is what NameTree::findLongestPrefixMatch(const Name&) pays for (one hash computation
+ *  per component and one hashtable probe per prefix length).
+ *
+ *  \note This index does not own the FIB entries; Fib keeps it in sync with the NameTree.
+ */
+class PrefixTrie : noncopyable
+{
+public:
+  PrefixTrie();
+
+  ~PrefixTrie();
+
+  /** \return number of indexed FIB entries
+   */
+  size_t
+  size() const
+  {
+    return m_nEntries;
+  }
+
+  /** \brief indexes \p entry under entry.getPrefix()
+   *  \pre no other entry is indexed under the same prefix
+   */
+  void
+  insert(Entry& entry);
+
+  /** \brief removes the entry indexed under \p prefix, if any
+   */
+  void
+  erase(const Name& prefix);
+
+  /** \brief removes all entries
+   */
+  void
+  clear();
+
+  /** \return the entry with the longest prefix of \p name, or nullptr if none exists
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name) const;
+
+  /** \brief performs longest prefix match for a batch of names
+   *  \param names names to look up; a null pointer yields a null match
+   *  \param[out] matches receives one match per name, in the same order as \p names
+   *
+   *  The trie path walked for a name is retained for the next one, and the walk resumes
+   *  at the deepest node shared by both. Batches whose names share prefixes, e.g. Interests
+   *  toward the same producer, skip most child lookups.
+   */
+  void
+  findLongestPrefixMatch(const std::vector<const Name*>& names, std::vector<Entry*>& matches) const;
+
+private:
+  class Node;
+
+  /** \brief a node on a walked path, with the deepest entry up to and including it
+   */
+  struct Step;
+
+  /** \return child of \p node whose label entirely matches \p name at \p depth, or nullptr
+   */
+  static const Node*
+  findMatchingChild(const Node& node, const Name& name, size_t depth);
+
+  /** \brief walks down from the last node of \p path as far as \p name allows
+   *  \param[in,out] path nodes whose labels fully match a prefix of \p name;
+   *                  must contain at least the root
+   */
+  void
+  walk(const Name& name, std::vector<Step>& path) const;
+
+  /** \brief removes \p node if it has become useless, and merges chains left behind
+   */
+  void
+  compact(Node* node);
+
+private:
+  unique_ptr<Node> m_root;
+  size_t m_nEntries;
+};
+
+} // namespace fib
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_FIB_PREFIX_TRIE_HPP
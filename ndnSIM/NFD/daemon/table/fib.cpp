@@ -73,9 +73,56 @@ Fib::findLongestPrefixMatchImpl(const K& key) const
 const Entry&
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
+  if (m_trie != nullptr) {
+    Entry* entry = m_trie->findLongestPrefixMatch(prefix);
+    return entry != nullptr ? *entry : *s_emptyEntry;
+  }
   return this->findLongestPrefixMatchImpl(prefix);
 }
 
+std::vector<const Entry*>
+Fib::findLongestPrefixMatchImpl(const std::vector<const Name*>& names) const
+{
+  std::vector<const Entry*> result;
+  result.reserve(names.size());
+
+  if (m_trie == nullptr) {
+    for (const Name* name : names) {
+      result.push_back(&this->findLongestPrefixMatchImpl(*name));
+    }
+    return result;
+  }
+
+  std::vector<Entry*> matches;
+  m_trie->findLongestPrefixMatch(names, matches);
+  for (const Entry* entry : matches) {
+    result.push_back(entry != nullptr ? entry : s_emptyEntry.get());
+  }
+  return result;
+}
+
+std::vector<const Entry*>
+Fib::findLongestPrefixMatch(const std::vector<Name>& names) const
+{
+  std::vector<const Name*> keys;
+  keys.reserve(names.size());
+  for (const Name& name : names) {
+    keys.push_back(&name);
+  }
+  return this->findLongestPrefixMatchImpl(keys);
+}
+
+std::vector<const Entry*>
+Fib::findLongestPrefixMatch(const std::vector<shared_ptr<Interest>>& interests) const
+{
+  std::vector<const Name*> keys;
+  keys.reserve(interests.size());
+  for (const shared_ptr<Interest>& interest : interests) {
+    keys.push_back(&interest->getName());
+  }
+  return this->findLongestPrefixMatchImpl(keys);
+}
+
 const Entry&
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
@@ -98,6 +145,25 @@ Fib::findExactMatch(const Name& prefix)
   return nullptr;
 }
 
+void
+Fib::setTrieIndexEnabled(bool isEnabled)
+{
+  if (!isEnabled) {
+    m_trie.reset();
+    return;
+  }
+
+  if (m_trie != nullptr) {
+    return;
+  }
+
+  m_trie = make_unique<PrefixTrie>();
+  for (const name_tree::Entry& nte : m_nameTree.fullEnumerate(&nteHasFibEntry)) {
+    m_trie->insert(*nte.getFibEntry());
+  }
+  BOOST_ASSERT(m_trie->size() == m_nItems);
+}
+
 std::pair<Entry*, bool>
 Fib::insert(const Name& prefix)
 {
@@ -109,6 +175,9 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  if (m_trie != nullptr) {
+    m_trie->insert(*nte.getFibEntry());
+  }
   return std::make_pair(nte.getFibEntry(), true);
 }
 
@@ -117,6 +186,9 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  if (m_trie != nullptr) {
+    m_trie->erase(nte->getName());
+  }
   nte->setFibEntry(nullptr);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_FIB_HPP
 
 #include "fib-entry.hpp"
+#include "fib-prefix-trie.hpp"
 #include "name-tree.hpp"
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -58,10 +59,30 @@ public:
 
 public: // lookup
   /** \brief performs a longest prefix match
+   *
+   *  If the trie index is enabled, this walks the index instead of the NameTree.
    */
   const Entry&
   findLongestPrefixMatch(const Name& prefix) const;
 
+  /** \brief performs longest prefix matches for a batch of names
+   *  \return one entry per name, in the same order as \p names
+   *
+   *  This is equivalent to calling .findLongestPrefixMatch(name) for every name,
+   *  but names sharing a prefix with their predecessor reuse its trie walk when the
+   *  trie index is enabled.
+   */
+  std::vector<const Entry*>
+  findLongestPrefixMatch(const std::vector<Name>& names) const;
+
+  /** \brief performs longest prefix matches for a batch of Interests
+   *  \return one entry per Interest, in the same order as \p interests
+   *
+   *  This is equivalent to .findLongestPrefixMatch(names) with the names of \p interests.
+   */
+  std::vector<const Entry*>
+  findLongestPrefixMatch(const std::vector<shared_ptr<Interest>>& interests) const;
+
   /** \brief performs a longest prefix match
    *
    *  This is equivalent to .findLongestPrefixMatch(pitEntry.getName())
@@ -81,6 +102,24 @@ public: // lookup
   Entry*
   findExactMatch(const Name& prefix);
 
+public: // index
+  /** \brief enables or disables the compressed trie index for longest prefix match
+   *
+   *  The index serves findLongestPrefixMatch overloads that take names or Interests;
+   *  lookups from a PIT or Measurements entry keep walking NameTree parents, which is
+   *  already proportional to the distance to the match.
+   *  The index is built from existing entries when enabled, and afterwards maintained by
+   *  insert, erase and removeNextHop, so it follows every FibManager update.
+   */
+  void
+  setTrieIndexEnabled(bool isEnabled);
+
+  bool
+  isTrieIndexEnabled() const
+  {
+    return m_trie != nullptr;
+  }
+
 public: // mutation
   /** \brief inserts a FIB entry for prefix
    *
@@ -132,6 +171,9 @@ private:
   const Entry&
   findLongestPrefixMatchImpl(const K& key) const;
 
+  std::vector<const Entry*>
+  findLongestPrefixMatchImpl(const std::vector<const Name*>& names) const;
+
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
@@ -142,6 +184,10 @@ private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief optional longest prefix match index, nullptr when disabled
+   */
+  unique_ptr<PrefixTrie> m_trie;
+
   /** \brief the empty FIB entry.
    *
    *  This entry has no nexthops.
@@ -34,8 +34,9 @@ namespace tests {
 
 BOOST_AUTO_TEST_SUITE(TestRandom)
 
-BOOST_AUTO_TEST_CASE(ThreadLocalRng)
+BOOST_AUTO_TEST_CASE(ContextLocalRng)
 {
+  // the generator belongs to the simulator context (node), not to the thread
   std::mt19937* s1 = &getGlobalRng();
   std::mt19937* s2 = nullptr;
   boost::thread t([&s2] {
@@ -45,8 +46,7 @@ BOOST_AUTO_TEST_CASE(ThreadLocalRng)
   t.join();
 
   BOOST_CHECK(s1 != nullptr);
-  BOOST_CHECK(s2 != nullptr);
-  BOOST_CHECK(s1 != s2);
+  BOOST_CHECK(s1 == s2);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestRandom
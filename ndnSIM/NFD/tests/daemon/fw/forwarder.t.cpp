@@ -110,6 +110,8 @@ BOOST_AUTO_TEST_CASE(CsMatched)
   // IncomingFaceId field should be reset to represent CS
   BOOST_REQUIRE(face1->sentData[0].getTag<lp::IncomingFaceIdTag>() != nullptr);
   BOOST_CHECK_EQUAL(*face1->sentData[0].getTag<lp::IncomingFaceIdTag>(), face::FACEID_CONTENT_STORE);
+  // the cached instance, which is shared with dataA, is not tagged
+  BOOST_CHECK_EQUAL(*dataA->getTag<lp::IncomingFaceIdTag>(), face3->getId());
 
   this->advanceClocks(time::milliseconds(100), time::milliseconds(500));
   // PIT entry should not be left behind
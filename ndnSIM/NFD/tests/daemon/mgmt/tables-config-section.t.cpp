@@ -141,6 +141,137 @@ BOOST_AUTO_TEST_CASE(InvalidValue)
 
 BOOST_AUTO_TEST_SUITE_END() // CsMaxPackets
 
+BOOST_AUTO_TEST_SUITE(CsMaxBytes)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.setByteLimit(5000);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes 5000
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 5000);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsMaxBytes
+
+BOOST_AUTO_TEST_SUITE(CsAdmission)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_packets 10
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  shared_ptr<Data> data = makeData("/tunnel/1");
+  data->setContent(std::vector<uint8_t>(8000, 0xBB).data(), 8000);
+  signData(data);
+  cs.insert(*data);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_packets 10
+      cs_max_data_size 1000
+      cs_no_cache
+      {
+        /tunnel
+        /other
+      }
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  cs.insert(*makeData("/tunnel/1"));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  cs.insert(*makeData("/tunnel/2"));
+  cs.insert(*makeData("/other/1"));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  shared_ptr<Data> largeData = makeData("/A/large");
+  largeData->setContent(std::vector<uint8_t>(1000, 0xBB).data(), 1000);
+  signData(largeData);
+  cs.insert(*largeData);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  cs.insert(*makeData("/A/small"));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidMaxDataSize)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_data_size invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidNoCachePrefix)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_no_cache
+      {
+        /tunnel/..
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsAdmission
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
@@ -214,6 +345,177 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsUnsolicitedPolicy
 
+BOOST_AUTO_TEST_SUITE(CsHashIndex)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  forwarder.getCs().setHashIndexEnabled(true);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getCs().isHashIndexEnabled(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Enabled)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_hash_index yes
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(forwarder.getCs().isHashIndexEnabled(), false);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getCs().isHashIndexEnabled(), true);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_hash_index maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsHashIndex
+
+BOOST_AUTO_TEST_SUITE(FibTrieIndex)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  forwarder.getFib().setTrieIndexEnabled(true);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getFib().isTrieIndexEnabled(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Enabled)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      fib_trie_index yes
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(forwarder.getFib().isTrieIndexEnabled(), false);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getFib().isTrieIndexEnabled(), true);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      fib_trie_index maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FibTrieIndex
+
+BOOST_AUTO_TEST_SUITE(DnlFilter)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  forwarder.getDeadNonceList().enableFilter(1000, 0.01);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK(forwarder.getDeadNonceList().getFilter() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Enabled)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dnl_filter_capacity 50000
+      dnl_filter_fp_rate 0.001
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(forwarder.getDeadNonceList().getFilter() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  const DeadNonceFilter* filter = forwarder.getDeadNonceList().getFilter();
+  BOOST_REQUIRE(filter != nullptr);
+  BOOST_CHECK_EQUAL(filter->getCapacity(), 50000);
+  BOOST_CHECK_EQUAL(filter->getFalsePositiveRate(), 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(DefaultFpRate)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dnl_filter_capacity 50000
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  const DeadNonceFilter* filter = forwarder.getDeadNonceList().getFilter();
+  BOOST_REQUIRE(filter != nullptr);
+  BOOST_CHECK_EQUAL(filter->getFalsePositiveRate(), 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      dnl_filter_capacity many
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      dnl_filter_capacity 50000
+      dnl_filter_fp_rate 1.5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DnlFilter
+
 BOOST_AUTO_TEST_SUITE(StrategyChoice)
 
 BOOST_AUTO_TEST_CASE(Unversioned)
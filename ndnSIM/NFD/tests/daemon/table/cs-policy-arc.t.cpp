@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-arc.hpp"
+#include "table/cs.hpp"
+
+#include "tests/daemon/table/cs-test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsArc)
+
+BOOST_FIXTURE_TEST_CASE(ScanResistance, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<ArcPolicy>());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+
+  // a scan only replaces entries used once
+  cs.insert(*makeData("ndn:/C"));
+  cs.insert(*makeData("ndn:/D"));
+  cs.insert(*makeData("ndn:/E"));
+  cs.insert(*makeData("ndn:/F"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/E"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/F"), true);
+}
+
+BOOST_FIXTURE_TEST_CASE(Adapt, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<ArcPolicy>());
+  auto policy = static_cast<ArcPolicy*>(cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+  cs.insert(*makeData("ndn:/C"));
+  cs.insert(*makeData("ndn:/D")); // evict C
+  BOOST_CHECK_EQUAL(policy->getTarget(), 0.0);
+
+  // C is inserted again soon after its eviction: grow target size of T1
+  cs.insert(*makeData("ndn:/C"));
+  BOOST_CHECK_EQUAL(policy->getTarget(), 1.0);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // T1 holds D within its target, so the LRU entry of T2 is evicted
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), true);
+
+  // A is inserted again soon after its eviction from T2: shrink target size of T1
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(policy->getTarget(), 0.0);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsArc
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
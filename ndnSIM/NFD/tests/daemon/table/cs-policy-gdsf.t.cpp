@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-gdsf.hpp"
+#include "table/cs.hpp"
+#include <ndn-cxx/util/crypto.hpp>
+
+#include "tests/daemon/table/cs-test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsGdsf)
+
+static shared_ptr<Data>
+makeDataWithPayload(const Name& name, size_t payloadSize)
+{
+  shared_ptr<Data> data = makeData(name);
+  data->setContent(std::vector<uint8_t>(payloadSize, 0xBB).data(), payloadSize);
+  signData(data);
+  return data;
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictLarge, UnitTestTimeFixture)
+{
+  Cs cs(100);
+  cs.setPolicy(make_unique<GdsfPolicy>());
+
+  shared_ptr<Data> dataL = makeDataWithPayload("ndn:/L", 1000);
+  shared_ptr<Data> dataA = makeDataWithPayload("ndn:/A", 100);
+  shared_ptr<Data> dataB = makeDataWithPayload("ndn:/B", 100);
+  shared_ptr<Data> dataC = makeDataWithPayload("ndn:/C", 100);
+  size_t smallSize = dataA->wireEncode().size();
+  cs.setByteLimit(dataL->wireEncode().size() + 2 * smallSize);
+
+  cs.insert(*dataL);
+  cs.insert(*dataA);
+  cs.insert(*dataB);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // evict L, although it is the oldest entry
+  cs.insert(*dataC);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 3 * smallSize);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/L"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), true);
+
+  auto policy = static_cast<GdsfPolicy*>(cs.getPolicy());
+  BOOST_CHECK_CLOSE(policy->getInflation(), 1.0 / dataL->wireEncode().size(), 0.001);
+}
+
+BOOST_FIXTURE_TEST_CASE(Frequency, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<GdsfPolicy>());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+
+  // A is used twice, then C once
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), true);
+
+  // evict B, which has the lowest frequency
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), false);
+
+  // D starts from the inflated priority, and outranks C after one use;
+  // evict C, which has the same priority as E but is older
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), true);
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+}
+
+BOOST_FIXTURE_TEST_CASE(SizeAdjustedLru, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<GdsPolicy>());
+  BOOST_CHECK_EQUAL(cs.getPolicy()->getName(), GdsPolicy::POLICY_NAME);
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+
+  // A is used repeatedly, but only the last use counts
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+
+  // evict B, the least recently used
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), false);
+
+  // use C, then evict A, the least recently used
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), true);
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsGdsf
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-s3fifo.hpp"
+#include "table/cs.hpp"
+
+#include "tests/daemon/table/cs-test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsS3Fifo)
+
+BOOST_FIXTURE_TEST_CASE(SmallQueue, UnitTestTimeFixture)
+{
+  Cs cs(10);
+  cs.setPolicy(make_unique<S3FifoPolicy>());
+
+  for (char c = 'A'; c <= 'J'; ++c) {
+    cs.insert(*makeData(Name("ndn:/").append(std::string(1, c))));
+  }
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+
+  // A and B were used in the small queue and move to the main queue; evict C
+  cs.insert(*makeData("ndn:/K"));
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), false);
+
+  // evict D
+  cs.insert(*makeData("ndn:/L"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+}
+
+BOOST_FIXTURE_TEST_CASE(Ghost, UnitTestTimeFixture)
+{
+  Cs cs(10);
+  cs.setPolicy(make_unique<S3FifoPolicy>());
+
+  for (char c = 'A'; c <= 'K'; ++c) {
+    cs.insert(*makeData(Name("ndn:/").append(std::string(1, c))));
+  }
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), false);
+
+  // A is in the ghost FIFO: it enters the main queue and B is evicted instead
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), false);
+
+  // the small queue is evicted before the main queue, even though A is not used again
+  cs.insert(*makeData("ndn:/L"));
+  cs.insert(*makeData("ndn:/M"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsS3Fifo
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-slru.hpp"
+#include "table/cs.hpp"
+
+#include "tests/daemon/table/cs-test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsSlru)
+
+BOOST_FIXTURE_TEST_CASE(EvictProbation, UnitTestTimeFixture)
+{
+  Cs cs(5);
+  cs.setPolicy(make_unique<SlruPolicy>());
+  auto policy = static_cast<SlruPolicy*>(cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+  BOOST_CHECK_EQUAL(policy->getNProtected(), 2);
+
+  // evict C then D from probation, although A is older
+  cs.insert(*makeData("ndn:/D"));
+  cs.insert(*makeData("ndn:/E"));
+  cs.insert(*makeData("ndn:/F"));
+  cs.insert(*makeData("ndn:/G"));
+  BOOST_CHECK_EQUAL(cs.size(), 5);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+}
+
+BOOST_FIXTURE_TEST_CASE(Demote, UnitTestTimeFixture)
+{
+  Cs cs(5);
+  cs.setPolicy(make_unique<SlruPolicy>());
+  auto policy = static_cast<SlruPolicy*>(cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  cs.insert(*makeData("ndn:/D"));
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), true);
+  BOOST_CHECK_EQUAL(policy->getNProtected(), 4);
+
+  // refreshing E protects it; the protected segment holds 4 entries, so A goes back to probation
+  cs.insert(*makeData("ndn:/E"));
+  BOOST_CHECK_EQUAL(policy->getNProtected(), 4);
+
+  cs.insert(*makeData("ndn:/F"));
+  BOOST_CHECK_EQUAL(cs.size(), 5);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/E"), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsSlru
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
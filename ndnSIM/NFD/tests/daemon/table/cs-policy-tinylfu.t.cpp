@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-tinylfu.hpp"
+#include "table/cs.hpp"
+
+#include "tests/daemon/table/cs-test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsTinyLfu)
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  tinylfu::FrequencySketch sketch(100);
+  BOOST_CHECK_EQUAL(sketch.getWidth(), 128);
+
+  name_tree::HashValue hA = name_tree::computeHash("/A");
+  name_tree::HashValue hB = name_tree::computeHash("/B");
+  for (int i = 0; i < 20; ++i) {
+    sketch.increment(hA);
+  }
+  sketch.increment(hB);
+  BOOST_CHECK_EQUAL(sketch.estimate(hA), tinylfu::FrequencySketch::MAX_COUNT);
+  BOOST_CHECK_EQUAL(sketch.estimate(hB), 1);
+
+  // aging halves all counters
+  for (size_t i = 0; i < tinylfu::FrequencySketch::SAMPLE_FACTOR * sketch.getWidth(); ++i) {
+    sketch.increment(name_tree::computeHash(Name("/C").appendNumber(i)));
+  }
+  BOOST_CHECK_LT(sketch.estimate(hA), tinylfu::FrequencySketch::MAX_COUNT);
+}
+
+BOOST_FIXTURE_TEST_CASE(Admission, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(make_unique<TinyLfuPolicy>());
+  auto policy = static_cast<TinyLfuPolicy*>(cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/A"), true);
+
+  // D is not more popular than B, the LRU entry
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy->getNRejected(), 1);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), false);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/B"), true);
+
+  // D is requested again, and becomes more popular than C, now the LRU entry
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy->getNRejected(), 1);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/D"), true);
+  BOOST_CHECK_EQUAL(isInCs(cs, "ndn:/C"), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsTinyLfu
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
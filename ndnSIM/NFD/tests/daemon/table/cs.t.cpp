@@ -319,6 +319,187 @@ BOOST_AUTO_TEST_CASE(DigestExclude)
 
 BOOST_AUTO_TEST_SUITE_END() // Find
 
+class HashIndexFixture : public FindFixture
+{
+protected:
+  HashIndexFixture()
+  {
+    m_cs.setHashIndexEnabled(true);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HashIndex, HashIndexFixture)
+
+BOOST_AUTO_TEST_CASE(ExactName)
+{
+  insert(1, "ndn:/");
+  insert(2, "ndn:/A");
+  insert(3, "ndn:/A/B");
+  insert(4, "ndn:/A/C");
+  insert(5, "ndn:/D");
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/D");
+  CHECK_CS_FIND(5);
+
+  startInterest("ndn:/E");
+  CHECK_CS_FIND(0);
+
+  startInterest("ndn:/A/B/C");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(FullName)
+{
+  Name n1 = insert(1, "ndn:/A");
+  Name n2 = insert(2, "ndn:/A");
+
+  startInterest(n1);
+  CHECK_CS_FIND(1);
+
+  startInterest(n2);
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(n1[-1] < n2[-1] ? 1 : 2);
+}
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/B/p/1");
+  insert(3, "ndn:/B/p/2");
+
+  startInterest("ndn:/B");
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/B/p");
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/B/q");
+  CHECK_CS_FIND(0);
+
+  startInterest("ndn:/");
+  CHECK_CS_FIND(1);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  insert(1, "ndn:/A/1");
+  shared_ptr<Data> data = makeData("ndn:/A");
+  uint32_t id = 2;
+  data->setContent(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+  data->setFreshnessPeriod(time::milliseconds::zero());
+  data->wireEncode();
+  m_cs.insert(*data);
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(2);
+
+  // stale exact match is skipped in favor of a fresh Data under the Interest Name
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(1);
+}
+
+BOOST_AUTO_TEST_CASE(Selectors)
+{
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+  insert(3, "ndn:/A/C");
+
+  startInterest("ndn:/A")
+    .setChildSelector(1);
+  CHECK_CS_FIND(3);
+
+  startInterest("ndn:/A")
+    .setMinSuffixComponents(2);
+  CHECK_CS_FIND(2);
+
+  // exact match with selectors after the ordered index was built on demand
+  insert(4, "ndn:/A/D");
+  startInterest("ndn:/A")
+    .setChildSelector(1);
+  CHECK_CS_FIND(4);
+}
+
+BOOST_AUTO_TEST_CASE(Refresh)
+{
+  insert(1, "ndn:/A");
+  insert(1, "ndn:/A");
+  BOOST_CHECK_EQUAL(m_cs.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Evict)
+{
+  m_cs.setLimit(2);
+  insert(1, "ndn:/A/1");
+  insert(2, "ndn:/B/1");
+  insert(3, "ndn:/C/1");
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(0);
+
+  startInterest("ndn:/B");
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/C/1");
+  CHECK_CS_FIND(3);
+}
+
+BOOST_AUTO_TEST_CASE(DropOrderedIndex)
+{
+  m_cs.setLimit(1000);
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+  BOOST_CHECK_EQUAL(m_cs.hasOrderedIndex(), false);
+
+  startInterest("ndn:/A")
+    .setChildSelector(1);
+  CHECK_CS_FIND(2);
+  BOOST_CHECK_EQUAL(m_cs.hasOrderedIndex(), true);
+
+  // lookups without selectors do not keep the ordered index alive
+  for (uint32_t id = 3; id < 200; ++id) {
+    insert(id, Name("ndn:/C").appendNumber(id));
+    startInterest(Name("ndn:/C").appendNumber(id));
+    CHECK_CS_FIND(id);
+  }
+  BOOST_CHECK_EQUAL(m_cs.hasOrderedIndex(), false);
+
+  startInterest("ndn:/C")
+    .setChildSelector(1);
+  CHECK_CS_FIND(199);
+  BOOST_CHECK_EQUAL(m_cs.hasOrderedIndex(), true);
+}
+
+BOOST_AUTO_TEST_CASE(Toggle)
+{
+  m_cs.setHashIndexEnabled(false);
+  insert(1, "ndn:/A/1");
+  insert(2, "ndn:/B");
+
+  m_cs.setHashIndexEnabled(true);
+  BOOST_CHECK_EQUAL(m_cs.isHashIndexEnabled(), true);
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(1);
+  startInterest("ndn:/B");
+  CHECK_CS_FIND(2);
+
+  insert(3, "ndn:/C");
+  m_cs.setHashIndexEnabled(false);
+  BOOST_CHECK_EQUAL(m_cs.isHashIndexEnabled(), false);
+  startInterest("ndn:/C");
+  CHECK_CS_FIND(3);
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // HashIndex
+
 // When the capacity limit is set to zero, Data cannot be inserted;
 // this test case covers this situation.
 // The behavior of non-zero capacity limit depends on the eviction policy,
@@ -354,6 +535,98 @@ BOOST_AUTO_TEST_CASE(CachePolicyNoCache)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_AUTO_TEST_CASE(ByteLimit)
+{
+  Cs cs(100);
+  shared_ptr<Data> dataA = makeData("ndn:/A");
+  shared_ptr<Data> dataB = makeData("ndn:/B");
+  shared_ptr<Data> dataC = makeData("ndn:/C");
+  size_t dataSize = dataA->wireEncode().size();
+  BOOST_REQUIRE_EQUAL(dataB->wireEncode().size(), dataSize);
+  BOOST_REQUIRE_EQUAL(dataC->wireEncode().size(), dataSize);
+
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 0);
+  cs.setByteLimit(2 * dataSize);
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 2 * dataSize);
+
+  cs.insert(*dataA);
+  cs.insert(*dataB);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * dataSize);
+
+  cs.insert(*dataA); // refresh does not count twice
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * dataSize);
+
+  cs.insert(*dataC);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * dataSize);
+
+  cs.setByteLimit(dataSize);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), dataSize);
+
+  // Data larger than the byte limit is not stored
+  shared_ptr<Data> dataD = makeData("ndn:/D");
+  dataD->setContent(std::vector<uint8_t>(dataSize, 0xBB).data(), dataSize);
+  signData(dataD);
+  cs.insert(*dataD);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  cs.find(Interest("ndn:/D"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  // byte limit is kept when policy changes
+  cs.setPolicy(makeDefaultPolicy());
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), dataSize);
+
+  cs.setByteLimit(0);
+  cs.insert(*dataD);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ByteAccountingMatchesMemory)
+{
+  Cs cs(100);
+  shared_ptr<Data> dataA = makeData("ndn:/A");
+  shared_ptr<Data> dataB = makeData("ndn:/B");
+  dataB->setContent(std::vector<uint8_t>(1000, 0xBB).data(), 1000);
+  signData(dataB);
+  cs.insert(*dataA);
+  cs.insert(*dataB);
+
+  // stored wires do not pin larger encoding buffers, so the byte count is the memory held
+  size_t nBufferBytes = 0;
+  for (const auto& csEntry : cs) {
+    const Block& wire = csEntry.getData().wireEncode();
+    BOOST_CHECK_EQUAL(wire.getBuffer()->size(), wire.size());
+    BOOST_CHECK_EQUAL(wire.getBuffer()->capacity(), wire.size());
+    nBufferBytes += wire.getBuffer()->capacity();
+  }
+  BOOST_CHECK_EQUAL(cs.getNBytes(), nBufferBytes);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionFilter)
+{
+  Cs cs(3);
+  cs.setAdmissionFilter([] (const Data& data) {
+    return !Name("/tunnel").isPrefixOf(data.getName());
+  });
+
+  cs.insert(*makeData("ndn:/tunnel/1"));
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  cs.find(Interest("ndn:/tunnel/1"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  cs.setAdmissionFilter(nullptr);
+  cs.insert(*makeData("ndn:/tunnel/1"));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Cs cs;
@@ -155,6 +155,125 @@ BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
   BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
 }
 
+BOOST_AUTO_TEST_SUITE(Filter)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  Name nameA("ndn:/A");
+  Name nameB("ndn:/B");
+  const uint32_t nonce1 = 0x53b4eaa8;
+  const uint32_t nonce2 = 0x1f46372b;
+
+  DeadNonceList dnl;
+  dnl.enableFilter(1000, 0.0001);
+  BOOST_REQUIRE(dnl.getFilter() != nullptr);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidParameters)
+{
+  DeadNonceList dnl;
+  BOOST_CHECK_THROW(dnl.enableFilter(0, 0.0001), std::invalid_argument);
+  BOOST_CHECK_THROW(dnl.enableFilter(1000, 0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(dnl.enableFilter(1000, 1.0), std::invalid_argument);
+  BOOST_CHECK(dnl.getFilter() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(EnableDisable)
+{
+  Name name("ndn:/N");
+
+  DeadNonceList dnl;
+  dnl.add(name, 1);
+  dnl.add(name, 2);
+
+  dnl.enableFilter(1000, 0.0001);
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), true);
+  BOOST_CHECK_EQUAL(dnl.has(name, 2), true);
+  const DeadNonceFilter* filter = dnl.getFilter();
+
+  dnl.enableFilter(1000, 0.0001); // same parameters, no effect
+  BOOST_CHECK_EQUAL(dnl.getFilter(), filter);
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), true);
+
+  dnl.enableFilter(2000, 0.0001); // different parameters, entries discarded
+  BOOST_CHECK_EQUAL(dnl.getFilter()->getCapacity(), 2000);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+
+  dnl.add(name, 3);
+  dnl.disableFilter();
+  BOOST_CHECK(dnl.getFilter() == nullptr);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(name, 3), false);
+
+  dnl.add(name, 4);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(name, 4), true);
+}
+
+BOOST_AUTO_TEST_CASE(FixedMemory)
+{
+  DeadNonceList dnl;
+  dnl.enableFilter(10000, 0.001);
+  size_t memory = dnl.getFilter()->getMemoryUsage();
+  BOOST_CHECK_GT(memory, 0);
+
+  Name name("ndn:/N");
+  for (uint32_t nonce = 0; nonce < 2000; ++nonce) {
+    dnl.add(name, nonce);
+  }
+  BOOST_CHECK_EQUAL(dnl.getFilter()->getMemoryUsage(), memory);
+  BOOST_CHECK_EQUAL(dnl.getFilter()->getNOverflows(), 0);
+
+  size_t nMissing = 0;
+  for (uint32_t nonce = 0; nonce < 2000; ++nonce) {
+    nMissing += dnl.has(name, nonce) ? 0 : 1;
+  }
+  BOOST_CHECK_EQUAL(nMissing, 0);
+
+  size_t nFalsePositives = 0;
+  for (uint32_t nonce = 100000; nonce < 110000; ++nonce) {
+    nFalsePositives += dnl.has(name, nonce) ? 1 : 0;
+  }
+  BOOST_CHECK_LE(nFalsePositives, 10 * 0.001 * 10000);
+}
+
+BOOST_FIXTURE_TEST_CASE(Lifetime, PeriodicalInsertionFixture)
+{
+  dnl.enableFilter(DeadNonceList::INITIAL_CAPACITY, 0.0001);
+
+  const int RATE = DeadNonceList::INITIAL_CAPACITY / 2;
+  this->setRate(RATE);
+  this->advanceClocksByLifetime(10.0);
+
+  Name nameC("ndn:/C");
+  const uint32_t nonceC = 0x25390656;
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.5); // -50%, entry should exist
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(1.0); // +50%, entry should be gone
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+
+  BOOST_CHECK_EQUAL(dnl.getFilter()->getNOverflows(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Filter
+
 BOOST_AUTO_TEST_SUITE_END() // TestDeadNonceList
 BOOST_AUTO_TEST_SUITE_END() // Table
 
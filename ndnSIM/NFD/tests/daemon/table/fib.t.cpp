@@ -359,6 +359,110 @@ BOOST_AUTO_TEST_CASE(Iterator)
   BOOST_CHECK_EQUAL(expected.size(), 0);
 }
 
+BOOST_AUTO_TEST_SUITE(TrieIndex)
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.insert("/A");
+  fib.insert("/A/B/C/D");
+  fib.setTrieIndexEnabled(true);
+  BOOST_CHECK_EQUAL(fib.isTrieIndexEnabled(), true);
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/").getPrefix(), "/"); // the empty entry
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A/B/C/D");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/X/D").getPrefix(), "/A");
+
+  // splits the /B/C/D edge
+  fib.insert("/A/B/X");
+  fib.insert("/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/X/D").getPrefix(), "/A/B/X");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A/B/C/D");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/E").getPrefix(), "/");
+
+  // merges /B and /C/D again
+  fib.erase("/A/B/X");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/X/D").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A/B/C/D");
+
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C").getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D").getPrefix(), "/A/B/C/D");
+
+  fib.setTrieIndexEnabled(false);
+  BOOST_CHECK_EQUAL(fib.isTrieIndexEnabled(), false);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D").getPrefix(), "/A/B/C/D");
+}
+
+BOOST_AUTO_TEST_CASE(RemoveNextHop)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.setTrieIndexEnabled(true);
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+
+  Entry* entryAB = fib.insert("/A/B").first;
+  entryAB->addNextHop(*face1, 0);
+  fib.insert("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C").getPrefix(), "/A/B");
+
+  fib.removeNextHop(*entryAB, *face1);
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C").getPrefix(), "/A");
+}
+
+BOOST_AUTO_TEST_CASE(SameAsNameTree)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  for (int i = 0; i < 50; ++i) {
+    Name prefix("/P");
+    prefix.appendNumber(i % 7);
+    if (i % 3 == 0) {
+      prefix.appendNumber(i);
+    }
+    if (i % 5 == 0) {
+      prefix.append("X").appendNumber(i % 2);
+    }
+    fib.insert(prefix);
+  }
+
+  std::vector<Name> names;
+  for (int i = 0; i < 100; ++i) {
+    Name name("/P");
+    name.appendNumber(i % 9).appendNumber(i % 13).append("X").appendNumber(i % 2);
+    names.push_back(name);
+  }
+
+  std::vector<const Entry*> expected;
+  for (const Name& name : names) {
+    expected.push_back(&fib.findLongestPrefixMatch(name));
+  }
+  BOOST_CHECK(fib.findLongestPrefixMatch(names) == expected);
+
+  fib.setTrieIndexEnabled(true);
+  for (size_t i = 0; i < names.size(); ++i) {
+    BOOST_CHECK_EQUAL(&fib.findLongestPrefixMatch(names[i]), expected[i]);
+  }
+  BOOST_CHECK(fib.findLongestPrefixMatch(names) == expected);
+
+  std::sort(names.begin(), names.end());
+  std::vector<shared_ptr<Interest>> interests;
+  for (const Name& name : names) {
+    interests.push_back(makeInterest(name));
+  }
+  std::vector<const Entry*> matches = fib.findLongestPrefixMatch(interests);
+  BOOST_REQUIRE_EQUAL(matches.size(), names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    BOOST_CHECK_EQUAL(matches[i]->getPrefix(), fib.findLongestPrefixMatch(names[i]).getPrefix());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TrieIndex
+
 BOOST_AUTO_TEST_SUITE_END() // TestFib
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <cmath>
+#include <random>
+
+namespace nfd {
+namespace tests {
+
+/** \brief replays Zipf-Mandelbrot request traces against each CS replacement policy
+ *
+ *  Requests follow the distribution of ns3::ndn::ConsumerZipfMandelbrot: content i (1-based)
+ *  is requested with probability proportional to 1 / (i + q)^s. Every request looks up the CS,
+ *  and a miss inserts the Data, as a forwarder does when the Data comes back.
+ */
+class CsPolicyBenchmarkFixture : public BaseFixture
+{
+protected:
+  CsPolicyBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif
+
+    dataWorkload.reserve(N_CONTENTS);
+    for (size_t i = 0; i < N_CONTENTS; ++i) {
+      dataWorkload.push_back(makeData(Name("/cs/benchmark").appendNumber(i)));
+    }
+  }
+
+  /** \return a trace of content indexes
+   */
+  static std::vector<size_t>
+  makeZipfMandelbrotTrace(size_t nRequests, double q, double s)
+  {
+    std::vector<double> cdf(N_CONTENTS);
+    double sum = 0.0;
+    for (size_t i = 0; i < N_CONTENTS; ++i) {
+      sum += 1.0 / std::pow(i + 1 + q, s);
+      cdf[i] = sum;
+    }
+
+    std::mt19937 rng(N_CONTENTS);
+    std::uniform_real_distribution<double> dist(0.0, sum);
+    std::vector<size_t> trace(nRequests);
+    for (size_t& content : trace) {
+      auto it = std::lower_bound(cdf.begin(), cdf.end(), dist(rng));
+      content = std::min<size_t>(std::distance(cdf.begin(), it), N_CONTENTS - 1);
+    }
+    return trace;
+  }
+
+  void
+  run(const std::string& policyName, const std::vector<size_t>& trace, size_t capacity)
+  {
+    std::vector<shared_ptr<Interest>> interests;
+    interests.reserve(trace.size());
+    for (size_t content : trace) {
+      interests.push_back(makeInterest(dataWorkload[content]->getName()));
+    }
+
+    Cs cs(capacity, cs::Policy::create(policyName));
+    size_t nHits = 0;
+
+    auto t1 = time::steady_clock::now();
+    for (size_t i = 0; i < trace.size(); ++i) {
+      bool isHit = false;
+      cs.find(*interests[i], bind([&isHit] { isHit = true; }), bind([]{}));
+      if (isHit) {
+        ++nHits;
+      }
+      else {
+        cs.insert(*dataWorkload[trace[i]]);
+      }
+    }
+    auto t2 = time::steady_clock::now();
+
+    auto d = time::duration_cast<time::nanoseconds>(t2 - t1);
+    BOOST_TEST_MESSAGE(policyName << " capacity=" << capacity <<
+                       " hit-ratio=" << static_cast<double>(nHits) / trace.size() <<
+                       " ns/request=" << d.count() / static_cast<double>(trace.size()));
+  }
+
+protected:
+  std::vector<shared_ptr<Data>> dataWorkload;
+
+  static constexpr size_t N_CONTENTS = 100000;
+  static constexpr size_t N_REQUESTS = 500000;
+};
+
+static const std::vector<std::string> POLICIES = {
+  "lru", "priority_fifo", "gdsf", "gds", "slru", "arc", "s3fifo", "tinylfu"
+};
+
+BOOST_FIXTURE_TEST_SUITE(TableCsPolicyBenchmark, CsPolicyBenchmarkFixture)
+
+// ConsumerZipfMandelbrot defaults
+BOOST_AUTO_TEST_CASE(ZipfMandelbrotDefault)
+{
+  std::vector<size_t> trace = makeZipfMandelbrotTrace(N_REQUESTS, 0.7, 0.7);
+  for (size_t capacity : {1000, 10000}) {
+    for (const std::string& policyName : POLICIES) {
+      run(policyName, trace, capacity);
+    }
+  }
+}
+
+// skewed popularity, typical of web and video workloads
+BOOST_AUTO_TEST_CASE(ZipfMandelbrotSkewed)
+{
+  std::vector<size_t> trace = makeZipfMandelbrotTrace(N_REQUESTS, 5.0, 1.0);
+  for (size_t capacity : {1000, 10000}) {
+    for (const std::string& policyName : POLICIES) {
+      run(policyName, trace, capacity);
+    }
+  }
+}
+
+// popular contents interleaved with a scan of contents requested once
+BOOST_AUTO_TEST_CASE(ZipfMandelbrotWithScan)
+{
+  std::vector<size_t> trace = makeZipfMandelbrotTrace(N_REQUESTS, 5.0, 1.0);
+  for (size_t i = 0; i < trace.size(); i += 2) {
+    trace[i] = N_CONTENTS / 2 + (i / 2) % (N_CONTENTS / 2);
+  }
+  for (size_t capacity : {1000, 10000}) {
+    for (const std::string& policyName : POLICIES) {
+      run(policyName, trace, capacity);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
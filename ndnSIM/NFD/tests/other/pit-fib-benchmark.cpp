@@ -153,5 +153,61 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   BOOST_TEST_MESSAGE(time::duration_cast<time::microseconds>(t2 - t1));
 }
 
+// This test case compares longest prefix match by name through the NameTree, the FIB trie index,
+// and the batched trie lookup, on a large FIB such as one installed by a global routing helper.
+BOOST_FIXTURE_TEST_CASE(LongestPrefixMatchByName, PitFibBenchmarkFixture)
+{
+  // number of FIB entries
+  const size_t nFibEntries = 100000;
+  // number of lookups
+  const size_t nLookups = 1000000;
+  // number of names per batch in batched lookups
+  const size_t batchSize = 64;
+
+  for (size_t i = 0; i < nFibEntries; ++i) {
+    Name prefix("/net");
+    prefix.append(to_string(i % 100)).append(to_string(i));
+    m_fib.insert(prefix);
+  }
+
+  std::vector<Name> names;
+  std::vector<std::vector<Name>> batches;
+  names.reserve(nLookups);
+  for (size_t i = 0; i < nLookups; ++i) {
+    size_t producer = (i / batchSize * 7919) % nFibEntries;
+    Name name("/net");
+    name.append(to_string(producer % 100)).append(to_string(producer))
+        .append("ipoc").appendSegment(i);
+    names.push_back(name);
+
+    if (i % batchSize == 0) {
+      batches.emplace_back();
+    }
+    batches.back().push_back(name);
+  }
+
+  auto measure = [&] (const std::string& label, bool isBatched) {
+    auto t1 = time::steady_clock::now();
+    if (isBatched) {
+      for (const std::vector<Name>& batch : batches) {
+        m_fib.findLongestPrefixMatch(batch);
+      }
+    }
+    else {
+      for (const Name& name : names) {
+        m_fib.findLongestPrefixMatch(name);
+      }
+    }
+    auto t2 = time::steady_clock::now();
+    BOOST_TEST_MESSAGE(label << ": " << time::duration_cast<time::microseconds>(t2 - t1));
+  };
+
+  measure("name tree", false);
+
+  m_fib.setTrieIndexEnabled(true);
+  measure("trie index", false);
+  measure("trie index, batched", true);
+}
+
 } // namespace tests
 } // namespace nfd
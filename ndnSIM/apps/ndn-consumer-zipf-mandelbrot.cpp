@@ -23,6 +23,11 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -30,6 +35,55 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfMandelbrot);
 
+/**
+ * @brief Get the cumulative probabilities of the Zipf-Mandelbrot distribution
+ *
+ * Tables are computed once and shared by all consumers with the same parameters, for as long
+ * as at least one of them keeps a reference.  The cache is guarded by a mutex, as consumers on
+ * different nodes may be started concurrently in a parallel simulation.
+ */
+static shared_ptr<const std::vector<double>>
+getCumulativeProbabilities(uint32_t n, double q, double s)
+{
+  typedef std::tuple<uint32_t, double, double> Key;
+  static std::map<Key, std::weak_ptr<const std::vector<double>>> cache;
+  static std::mutex cacheMutex;
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+
+  std::weak_ptr<const std::vector<double>>& cached = cache[Key(n, q, s)];
+  shared_ptr<const std::vector<double>> table = cached.lock();
+  if (table != nullptr) {
+    return table;
+  }
+
+  NS_LOG_DEBUG(q << " and " << s << " and " << n);
+
+  auto pcum = make_shared<std::vector<double>>(n + 1);
+  (*pcum)[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+
+  for (uint32_t i = 1; i <= n; i++) {
+    (*pcum)[i] = (*pcum)[i] / (*pcum)[n];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << (*pcum)[i]);
+  }
+
+  // drop tables that are no longer used by any consumer
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (it->second.expired()) {
+      it = cache.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  cache[Key(n, q, s)] = pcum;
+  return pcum;
+}
+
 TypeId
 ConsumerZipfMandelbrot::GetTypeId(void)
 {
@@ -74,20 +128,7 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
-
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_Pcum = nullptr; // fetched on the first request, after all attributes are set
 }
 
 uint32_t
@@ -100,7 +141,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -113,7 +154,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -195,27 +236,41 @@ ConsumerZipfMandelbrot::SendPacket()
   ConsumerZipfMandelbrot::ScheduleNextPacket();
 }
 
+shared_ptr<const std::vector<double>>
+ConsumerZipfMandelbrot::GetCumulativeProbabilities()
+{
+  if (m_Pcum == nullptr) {
+    m_Pcum = getCumulativeProbabilities(m_N, m_q, m_s);
+  }
+  return m_Pcum;
+}
+
+int64_t
+ConsumerZipfMandelbrot::AssignStreams(int64_t stream)
+{
+  m_seqRng->SetStream(stream);
+  return 1;
+}
+
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  GetCumulativeProbabilities();
+
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
+  // content_index is the first i in [1, m_N] with p_random <= m_Pcum[i]
+  auto found = std::lower_bound(m_Pcum->begin() + 1, m_Pcum->end(), p_random);
+  if (found != m_Pcum->end()) {
+    content_index = static_cast<uint32_t>(found - m_Pcum->begin());
+  }
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
@@ -67,6 +67,22 @@ public:
   uint32_t
   GetNextSeq();
 
+  /**
+   * @brief Get cumulative probabilities of content ranks 1..NumberOfContents
+   *
+   * The table is computed on first use and shared by all consumers with the same
+   * NumberOfContents, q and s, until the last of them releases it.
+   */
+  shared_ptr<const std::vector<double>>
+  GetCumulativeProbabilities();
+
+  /**
+   * @brief Assign a fixed random variable stream number to the RNG picking content ranks
+   * @return the number of stream indices assigned (1)
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
 protected:
   virtual void
   ScheduleNextPacket();
@@ -94,7 +110,8 @@ private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  // cumulative probability, shared by all consumers with the same N, q and s
+  shared_ptr<const std::vector<double>> m_Pcum;
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
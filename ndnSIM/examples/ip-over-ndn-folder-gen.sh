@@ -18,6 +18,8 @@ echo "ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-multi-tcp-download-nsc"
 ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-multi-tcp-download-nsc
 echo "ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-multi-tcp-upload-nsc"
 ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-multi-tcp-upload-nsc
+echo "ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-pcap-replay"
+ln -s $curPath/ip-over-ndn $curPath/ip-over-ndn-pcap-replay
 
 
 ln -s ip-over-ndn ip-over-ndn-multi-tcp-upload-nsc
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+*
+* Copyright (c) 2017 Cable Television Laboratories, Inc.
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/internet-module.h"
+#include "ns3/virtual-net-device.h"
+
+#include "ns3/ndnSIM-module.h"
+
+#include "ip-over-ndn/ipoc-client.hpp"
+#include "ip-over-ndn/gateway-app.hpp"
+#include "ip-over-ndn/pcap-replay-app.hpp"
+#include "ip-over-ndn/parse-config.hpp"
+
+/**
+ * This scenario replays a packet capture through the IP-over-NDN tunnel:
+ *
+ *
+ *    (pcap replay + Ipoc-Client) ----- (NDN-Router) ------ (Ipoc-Gateway + pcap replay)
+ *
+ *
+ * With direction "download", IPv4 packets of the capture are injected into the virtual net
+ * device of the gateway and tunneled towards the client; with "upload", they are injected on the
+ * client side.  Packets are injected at their captured timestamps, optionally scaled with
+ * timeScale, starting at 2 seconds of simulated time.  Only RequestHelper and ProducerHelper
+ * sections of the config file are used.
+ *
+ * With signing other than "fake" (sha256, hmac, ecdsa, or merkle), the gateway signs Data for
+ * real and the client verifies them with the same scheme, so the cost of signing a realistic
+ * traffic mix can be measured.
+ *
+ * To run scenario and see what is happening, use the following command (the folder with sources
+ * is created by ip-over-ndn-folder-gen.sh):
+ *
+ *  NS_LOG=ndn.PcapReplayApp ./waf --run "ip-over-ndn-pcap-replay
+ *      --configName=src/ndnSIM/examples/ip-over-ndn/config.conf --pcap=ue-traffic.pcap"
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ndn.IpOverNdnPcapReplay");
+
+int
+main(int argc, char* argv[])
+{
+    std::string m_config = "";
+    std::string pcapFile = "";
+    std::string direction = "download";
+    double timeScale = 1.0;
+    double stopTime = 400.0;
+    std::string signing = "fake";
+
+    CommandLine cmd;
+    cmd.AddValue("configName", "config name", m_config);
+    cmd.AddValue("pcap", "pcap file to replay", pcapFile);
+    cmd.AddValue("direction", "download (inject at the gateway) or upload (inject at the client)",
+                 direction);
+    cmd.AddValue("timeScale", "factor applied to intervals between captured packets", timeScale);
+    cmd.AddValue("stopTime", "simulation stop time in seconds", stopTime);
+    cmd.AddValue("signing", "Data signing scheme: fake, sha256, hmac, ecdsa, or merkle", signing);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(pcapFile.empty(), "--pcap is required");
+    NS_ABORT_MSG_IF(direction != "download" && direction != "upload",
+                    "--direction must be download or upload");
+
+    ParseConfig pc(m_config);
+    pc.setVariables();
+
+    Time::SetResolution (Time::NS);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("40Gbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("5ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20000"));
+
+    // Creating nodes
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    // Connecting nodes using two links
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+    p2p.SetDeviceAttribute("DataRate", StringValue("40Gbps"));
+    p2p.Install(nodes.Get(1), nodes.Get(2));
+
+    // IP stack on both ends of the tunnel delivers tunneled packets
+    InternetStackHelper ipHelper;
+    ipHelper.Install (nodes.Get(0));
+    ipHelper.Install (nodes.Get(2));
+
+    // Install NDN stack on nodes 0, 1, 2
+    NS_LOG_INFO("Installing NDN Stack");
+    ndn::StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    ndnHelper.InstallAll();
+
+    // Install NDN Routes Manually
+    ndn::FibHelper::AddRoute(nodes.Get(0), ndn::Name("/ndnSIM"), nodes.Get(1), 1);
+    ndn::FibHelper::AddRoute(nodes.Get(1), ndn::Name("/ndnSIM"), nodes.Get(2), 1);
+
+    // create interface between client application and virtual netdevice on the client side
+    Ptr<VirtualNetDevice> tapClt = CreateObject<VirtualNetDevice> ();
+    tapClt->SetAddress (Mac48Address ("11:00:01:02:03:01"));
+    tapClt->SetNeedsArp(false);
+    nodes.Get(0)->AddDevice (tapClt);
+    Ptr<Ipv4> ipv4n0 = nodes.Get(0)->GetObject<Ipv4> ();
+    uint32_t i = ipv4n0->AddInterface (tapClt);
+    ipv4n0->AddAddress (i, Ipv4InterfaceAddress (Ipv4Address ("11.0.0.12"), Ipv4Mask ("255.255.255.0")));
+    ipv4n0->SetUp (i);
+
+    // create interface for the gateway
+    Ptr<VirtualNetDevice> tapGw = CreateObject<VirtualNetDevice> ();
+    tapGw->SetAddress (Mac48Address ("11:00:01:02:03:02"));
+    tapGw->SetNeedsArp(false);
+    nodes.Get(2)->AddDevice (tapGw);
+    Ptr<Ipv4> ipv4n2 = nodes.Get(2)->GetObject<Ipv4> ();
+    i = ipv4n2->AddInterface (tapGw);
+    ipv4n2->AddAddress (i, Ipv4InterfaceAddress (Ipv4Address ("11.0.0.1"), Ipv4Mask ("255.255.255.0")));
+    ipv4n2->SetUp (i);
+
+    // Install NDN app on the client side; encap/decap
+    ndn::AppHelper requesterHelper("ns3::ndn::IpocClient");
+    requesterHelper.SetAttribute("VirtualNetDevice", (PointerValue)tapClt);
+    requesterHelper.SetAttribute("Name", StringValue(pc.p_name));
+    requesterHelper.SetAttribute("timer0", UintegerValue(pc.p_timer0));
+    requesterHelper.SetAttribute("timer1", UintegerValue(pc.p_timer1));
+    requesterHelper.SetAttribute("MaxIDC", UintegerValue(pc.p_MaxIDC));
+    requesterHelper.SetAttribute("reseqLen", UintegerValue(pc.p_reseqLen));
+    requesterHelper.SetAttribute("waitForGap", UintegerValue(pc.p_waitForGap));
+    requesterHelper.SetAttribute("VerifySignatures", BooleanValue(signing != "fake"));
+    requesterHelper.SetAttribute("SigningScheme", StringValue(signing));
+    requesterHelper.SetAttribute("HmacKey", StringValue("ip-over-ndn"));
+    ApplicationContainer ipocClt = requesterHelper.Install(nodes.Get(0));
+    ipocClt.Start (Seconds(1.0));
+
+    // Install NDN app on the gateway
+    ndn::AppHelper producerHelper("ns3::ndn::GatewayApp");
+    producerHelper.SetPrefix(pc.p_prefix);
+    producerHelper.SetAttribute("PayloadSize", UintegerValue(pc.p_payloadSize));
+    producerHelper.SetAttribute("ContentFreshness", TimeValue(Seconds(pc.p_contentFreshness)));
+    producerHelper.SetAttribute("CitTableWait", UintegerValue(pc.p_citTableWait));
+    producerHelper.SetAttribute("MaxCitEntrySize", UintegerValue(pc.p_maxCitEntrySize));
+    producerHelper.SetAttribute("MinCitEntrySize", UintegerValue(pc.p_minCitEntrySize));
+    producerHelper.SetAttribute("VirtualNetDevice", (PointerValue)tapGw);
+    producerHelper.SetAttribute("waitForGap", UintegerValue(pc.p_waitForGap));
+    producerHelper.SetAttribute("SigningScheme", StringValue(signing));
+    producerHelper.SetAttribute("HmacKey", StringValue("ip-over-ndn"));
+    ApplicationContainer ipocGw = producerHelper.Install(nodes.Get(2));
+    ipocGw.Start (Seconds(1.0));
+
+    // Replay the capture into the tunnel
+    bool isDownload = (direction == "download");
+    Ptr<ndn::PcapReplayApp> replay = CreateObject<ndn::PcapReplayApp> ();
+    replay->SetAttribute("File", StringValue(pcapFile));
+    replay->SetAttribute("VirtualNetDevice", PointerValue(isDownload ? tapGw : tapClt));
+    replay->SetAttribute("TimeScale", DoubleValue(timeScale));
+    nodes.Get(isDownload ? 2 : 0)->AddApplication(replay);
+    replay->SetStartTime(Seconds(2.0));
+
+    Simulator::Stop(Seconds(stopTime));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::cout << "Finished: " << "Config File " << m_config << " pcap " << pcapFile << std::endl;
+    return 0;
+}
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+    return ns3::main(argc, argv);
+}
@@ -77,7 +77,7 @@ CitEntry::getIpPkts(const size_t n)
     size_t cnt = 0;
     while (!m_ipPktBuffer.empty() && cnt < n) {
         auto pkt = m_ipPktBuffer.front();
-        m_ipPktBuffer.pop();
+        m_ipPktBuffer.pop_front();
         pkts->push_back(pkt);
         cnt++;
     }
@@ -109,7 +109,7 @@ CitEntry::pushInterestRecord(shared_ptr<InterestRecord>& record)
 void
 CitEntry::pushIpPacket(Ptr<Packet>& ipPkt)
 {
-    m_ipPktBuffer.push(ipPkt);
+    m_ipPktBuffer.push_back(ipPkt);
 }
 
 shared_ptr<InterestRecord>
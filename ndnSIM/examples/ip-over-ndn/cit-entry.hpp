@@ -28,6 +28,7 @@
 #include "interest-record.hpp"
 #include "ns3/packet.h"
 #include "ns3/object.h"
+#include <deque>
 #include <queue>
 
 namespace ns3 {
@@ -105,7 +106,7 @@ public:
         return m_ipPktBuffer.size();
     }
 
-    std::queue<Ptr<Packet>>&
+    std::deque<Ptr<Packet>>&
     getIpPktBuffer()
     {
         return m_ipPktBuffer;
@@ -114,7 +115,7 @@ public:
 private:
     uint32_t m_id;
     std::queue<shared_ptr<InterestRecord>> m_interestRecords;
-    std::queue<Ptr<Packet>> m_ipPktBuffer;
+    std::deque<Ptr<Packet>> m_ipPktBuffer;
     uint32_t m_maxLen;
     uint32_t m_minLen;
     uint32_t m_curSeqNum;
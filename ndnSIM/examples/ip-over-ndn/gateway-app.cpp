@@ -31,6 +31,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-profiler.hpp"
 
 #include "ns3/udp-header.h"
 #include "ns3/tcp-header.h"
@@ -43,6 +44,7 @@
 #include "ns3/tcp-l4-protocol.h"
 #include "ns3/udp-l4-protocol.h"
 
+#include <algorithm>
 #include <memory>
 
 NS_LOG_COMPONENT_DEFINE("ndn.GatewayApp");
@@ -52,6 +54,9 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(GatewayApp);
 
+// IP packets are packed into a Data as long as the encoded Data does not exceed this size
+static const size_t MAX_DATA_SIZE = 8000;
+
 TypeId
 GatewayApp::GetTypeId(void)
 {
@@ -90,12 +95,35 @@ GatewayApp::GetTypeId(void)
         .AddAttribute("waitForGap", "waitForGap", UintegerValue(0),
                       MakeUintegerAccessor(&GatewayApp::m_waitForGap),
                       MakeUintegerChecker<uint32_t>())
+        .AddAttribute("PackBursts",
+                      "Answer pending Interests after all IP packets arriving at the same time, "
+                      "packing several IP packets into each Data, instead of one IP packet per Data",
+                      BooleanValue(true), MakeBooleanAccessor(&GatewayApp::m_packBursts),
+                      MakeBooleanChecker())
+        .AddAttribute("SigningScheme",
+                      "Signature of Data: fake (Signature attribute as SignatureValue), sha256, hmac, "
+                      "ecdsa, or merkle (one ECDSA signature per batch of Data)",
+                      StringValue("fake"), MakeStringAccessor(&GatewayApp::m_signingScheme),
+                      MakeStringChecker())
+        .AddAttribute("HmacKey", "Key shared with the clients for the hmac signing scheme",
+                      StringValue(""), MakeStringAccessor(&GatewayApp::m_hmacKey),
+                      MakeStringChecker())
+        .AddAttribute("SigningBatchSize", "Max number of Data signed with one Merkle tree",
+                      UintegerValue(16), MakeUintegerAccessor(&GatewayApp::m_signingBatchSize),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("SigningThreads",
+                      "Number of threads signing a batch of Data, 0 for the number of hardware threads",
+                      UintegerValue(0), MakeUintegerAccessor(&GatewayApp::m_signingThreads),
+                      MakeUintegerChecker<uint32_t>())
  
         ;
     return tid;
 }
 
 GatewayApp::GatewayApp()
+    : m_packBursts(true)
+    , m_signingBatchSize(16)
+    , m_signingThreads(0)
 {
     NS_LOG_FUNCTION_NOARGS();
     m_cit = make_unique<Cit>();
@@ -152,13 +180,13 @@ GatewayApp::StartApplication()
     //add NDN route back to the client
     FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 
-    //set up NDN signature on this node
-    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-    if (m_keyLocator.size() > 0) {
-        signatureInfo.setKeyLocator(m_keyLocator);
+    //set up NDN signature on this node; real signatures need a key name to be verified
+    Name keyName = m_keyLocator;
+    if (keyName.empty() && m_signingScheme != "fake") {
+        keyName = Name(m_prefix).append("KEY").appendNumber(GetNode()->GetId());
     }
-    gwSignature.setInfo(signatureInfo);
-    gwSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+    m_signer = make_unique<IpocSigner>(m_signingScheme, keyName, m_hmacKey, m_signature,
+                                       m_signingBatchSize, m_signingThreads);
 
     //std::cout << "params in GatewayApp::StartApplication():" << std::endl;
     //std::cout << "maxCitEntrySize = " << m_maxCitEntrySize << std::endl;
@@ -176,6 +204,7 @@ bool
 GatewayApp::GetIpPackets(Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION (this);
+    NDNSIM_PROFILE_SCOPE(IPOC);
     //this->Printpacket(packet);
 
     // **** TODO: need to parse the correct addr
@@ -206,6 +235,13 @@ GatewayApp::GetIpPackets(Ptr<Packet> packet, const Address& source, const Addres
         NS_LOG_DEBUG("Before: IP Packet buffer size = " << entry->getIpPktBufSize());
         entry->pushIpPacket(packet);
         NS_LOG_DEBUG("After: IP Packet buffer size = " << entry->getIpPktBufSize());
+    } else if (m_packBursts) {
+        // packets of a burst (e.g., TCP segments sent together) arrive at the same time; answer
+        // pending Interests once all of them are buffered
+        entry->pushIpPacket(packet);
+        if (!m_drainEvent.IsRunning()) {
+            m_drainEvent = Simulator::ScheduleNow(&GatewayApp::DrainIpPackets, this, entry);
+        }
     } else {
         NS_LOG_DEBUG("CitEntry size != 0; n = " << entry->getMin());
         // 2. len != 0
@@ -244,43 +280,94 @@ size_t
 GatewayApp::EstimatePktNumber (shared_ptr<Data>& data, shared_ptr<IPoCPacket>& ipocPkt, shared_ptr<CitEntry>& citEntry)
 {
     NS_LOG_FUNCTION (this);
-    NS_LOG_DEBUG("IP packet buffer size = " << citEntry->getIpPktBuffer().size());
-    auto ipPktBuffer(citEntry->getIpPktBuffer());
+    using ::ndn::tlv::sizeOfVarNumber;
+
+    const auto& ipPktBuffer = citEntry->getIpPktBuffer();
     NS_LOG_DEBUG("#IP Packets in IP Packet Buffer " << ipPktBuffer.size());
-    size_t cnt = 0;
-    IpPacketList pktls;
-    uint8_t buf[65535];
-    while (!ipPktBuffer.empty()) {
-        auto tmpData = make_shared<Data>(*data);
-        auto pkt = ipPktBuffer.front();
-        ipPktBuffer.pop();
-        // test if the added pkt within the MTU
-        size_t len = pkt->CopyData(buf, pkt->GetSize());
-        Block blk = ::ndn::makeBinaryBlock(::ndn::tlv::IpPacket, buf, len);
-        pktls.addIpPacketBlock(blk);
-        std::fill( std::begin(buf), std::end(buf), 0 );
-       
-        NS_LOG_DEBUG("Current #IP Packets in IP Packet list " << pktls.size());
 
-        ipocPkt->setPayload(pktls.wireEncode());
-        Block ipocBlk = ipocPkt->wireEncode();
+    // Encode the Data once without IP packets.  Every added IP packet only appends its block to
+    // the IP packet list and may widen TLV-LENGTH of the list, the Content, and the Data.
+    IPoCPacket header;
+    header.setControlBits(ipocPkt->getControlBits());
+    header.setSequenceNumber(ipocPkt->getSequenceNumber());
+    Block headerBlk = header.wireEncode();
+
+    Data tmpData(*data);
+    tmpData.setContent(headerBlk.value(), headerBlk.value_size());
+    tmpData.setSignature(m_signer->getPlaceholder());
+    size_t headerSize = headerBlk.value_size();
+    size_t dataValueSize = tmpData.wireEncode().value_size() -
+                           (sizeOfVarNumber(::ndn::tlv::Content) + sizeOfVarNumber(headerSize) + headerSize);
 
-        tmpData->setContent(ipocBlk.value(), ipocBlk.value_size());
-        tmpData->setSignature(gwSignature);
-        auto resBlk = tmpData->wireEncode();
-        NS_LOG_DEBUG("Result block size after adding another IP Packet " << resBlk.size());
-        if (resBlk.size() > 8000)
+    size_t cnt = 0;
+    size_t listValueSize = 0;
+    for (const auto& pkt : ipPktBuffer) {
+        size_t pktSize = pkt->GetSize();
+        listValueSize += sizeOfVarNumber(::ndn::tlv::IpPacket) + sizeOfVarNumber(pktSize) + pktSize;
+
+        size_t contentSize = headerSize + sizeOfVarNumber(::ndn::tlv::IpPacketList) +
+                             sizeOfVarNumber(listValueSize) + listValueSize;
+        size_t valueSize = dataValueSize + sizeOfVarNumber(::ndn::tlv::Content) +
+                           sizeOfVarNumber(contentSize) + contentSize;
+        size_t resSize = sizeOfVarNumber(::ndn::tlv::Data) + sizeOfVarNumber(valueSize) + valueSize;
+        NS_LOG_DEBUG("Result block size after adding another IP Packet " << resSize);
+        if (resSize > MAX_DATA_SIZE)
             break;
         cnt++;
     }
     NS_LOG_DEBUG("Estimated #IP packets " << cnt);
-    NS_LOG_DEBUG("IP packet buffer size = " << citEntry->getIpPktBuffer().size());
 
     return cnt;
 }
 
+void
+GatewayApp::DrainIpPackets(shared_ptr<CitEntry> entry)
+{
+    NS_LOG_FUNCTION (this);
+    NDNSIM_PROFILE_SCOPE(IPOC);
+    NS_LOG_DEBUG("Draining IP packet buffer size = " << entry->getIpPktBufSize() << " over CitEntry size = " << entry->sizeOfIntRec());
+
+    std::vector<shared_ptr<Data>> batch;
+    while (entry->sizeOfIntRec() != 0 && !entry->isIpPktBufEmpty()) {
+        // same IDR as for a single IP packet: +1 if fewer than n Interests are pending
+        uint8_t idr = entry->sizeOfIntRec() < entry->getMin() ? 1 : 0;
+        auto record = entry->popInterestRecord();
+        Simulator::Remove(record->m_timeoutId);
+        NS_LOG_DEBUG("Remove event " << record->m_timeoutId.GetUid());
+
+        auto data = make_shared<Data>(Name(m_prefix).append(entry->getCltAddr()).appendSegment(record->getSeqNumber()));
+        data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+
+        auto ipocPkt = make_shared<IPoCPacket>();
+        ipocPkt->setControlBits(idr);
+        uint64_t seqNu = entry->getSeqNumber();
+        ipocPkt->setSequenceNumber(seqNu);
+        NS_LOG_DEBUG("node(" << GetNode()->GetId() << ") Data contains: ipocSN = " << seqNu);
+
+        // an IP packet too large to fit the limit alone is still sent, not to block the buffer
+        size_t pktN = std::max<size_t>(EstimatePktNumber(data, ipocPkt, entry), 1);
+        auto pkts = entry->getIpPkts(pktN);
+        EncodeData(pkts, data, ipocPkt);
+        batch.push_back(data);
+    }
+    m_signer->signBatch(batch);
+
+    NS_LOG_DEBUG("Sending " << batch.size() << " Data, IP packets left in buffer = " << entry->getIpPktBufSize());
+    for (auto& data : batch) {
+        SendData(data);
+    }
+}
+
 void
 GatewayApp::PutData(shared_ptr<std::vector<Ptr<Packet>>>& pkts, shared_ptr<Data>& data, shared_ptr<IPoCPacket>& ipocPkt)
+{
+    EncodeData(pkts, data, ipocPkt);
+    m_signer->signBatch({data});
+    SendData(data);
+}
+
+void
+GatewayApp::EncodeData(shared_ptr<std::vector<Ptr<Packet>>>& pkts, shared_ptr<Data>& data, shared_ptr<IPoCPacket>& ipocPkt)
 {
     NS_LOG_FUNCTION (this);
     // return NDN data to the client node
@@ -317,11 +404,13 @@ GatewayApp::PutData(shared_ptr<std::vector<Ptr<Packet>>>& pkts, shared_ptr<Data>
     Block ipocBlk = ipocPkt->wireEncode();
 
     data->setContent(ipocBlk.value(), ipocBlk.value_size());
-    data->setSignature(gwSignature);
-    Block dataBlk = data->wireEncode();
+}
 
+void
+GatewayApp::SendData(const shared_ptr<Data>& data)
+{
     NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
-    NS_LOG_INFO("Data size = " << dataBlk.size());
+    NS_LOG_INFO("Data size = " << data->wireEncode().size());
     m_transmittedDatas(data, this, m_face);
     //send data to NDN stack 
     m_appLink->onReceiveData(*data);
@@ -331,6 +420,7 @@ void
 GatewayApp::StopApplication()
 {
     NS_LOG_FUNCTION_NOARGS();
+    Simulator::Cancel(m_drainEvent);
     App::StopApplication();
 }
 
@@ -474,6 +564,7 @@ void
 GatewayApp::OnInterest(shared_ptr<const Interest> interest)
 {
     NS_LOG_FUNCTION (this);
+    NDNSIM_PROFILE_SCOPE(IPOC);
     App::OnInterest(interest); // tracing inside
     //handle received Interest from the clients
     NS_LOG_DEBUG("Recvd Interest " << interest->getName());
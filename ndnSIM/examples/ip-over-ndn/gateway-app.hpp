@@ -28,14 +28,18 @@
 
 #include "ns3/ndnSIM/apps/ndn-app.hpp"
 
+#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/socket.h"
 #include "ns3/virtual-net-device.h"
 
 #include "cit.hpp"
+#include "ipoc-security.hpp"
 #include "resequencer.hpp"
 
+#include <string>
+
 #include <memory>
 #include <vector>
 
@@ -79,6 +83,25 @@ protected:
     void
     PutData (shared_ptr<std::vector<Ptr<Packet>>>& pkts, shared_ptr<Data>& data, shared_ptr<IPoCPacket>& ipocPkt);
 
+    /**
+     * @brief Put IP packets @p pkts into @p data, which is signed afterwards
+     */
+    void
+    EncodeData (shared_ptr<std::vector<Ptr<Packet>>>& pkts, shared_ptr<Data>& data, shared_ptr<IPoCPacket>& ipocPkt);
+
+    void
+    SendData (const shared_ptr<Data>& data);
+
+    /**
+     * @brief Answer pending Interests of @p entry with buffered IP packets in one pass
+     *
+     * Every Data is packed with as many IP packets as EstimatePktNumber allows, and all Data are
+     * signed as one batch and passed to the NDN stack together.  IP packets left when there are no
+     * more pending Interests stay in the buffer for the next Interests.
+     */
+    void
+    DrainIpPackets (shared_ptr<CitEntry> entry);
+
     void
     OnCitEntryTimeout (shared_ptr<const Interest>& interest);
 
@@ -99,7 +122,6 @@ private:
     uint32_t m_maxCitEntrySize;
     uint32_t m_minCitEntrySize;
 
-    Signature gwSignature;
     uint32_t m_signature;
     Name m_keyLocator;
     Ptr<VirtualNetDevice> m_vnd;
@@ -108,6 +130,15 @@ private:
 	uint32_t m_waitForGap;
 
     std::unique_ptr<Resequencer<shared_ptr<const Interest>>> m_interestsReseq;
+
+    bool m_packBursts;
+    EventId m_drainEvent;
+
+    std::string m_signingScheme;
+    std::string m_hmacKey;
+    uint32_t m_signingBatchSize;
+    uint32_t m_signingThreads;
+    std::unique_ptr<IpocSigner> m_signer;
 };
 
 } // namespace ndn
@@ -23,6 +23,8 @@
 #include "ipoc-client.hpp"
 
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/utils/ndn-profiler.hpp"
+#include "ns3/boolean.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
@@ -77,6 +79,26 @@ IpocClient::GetTypeId()
                         .AddAttribute("waitForGap", "waitForGap", UintegerValue(0),
                                       MakeUintegerAccessor(&IpocClient::m_waitForGap),
                                       MakeUintegerChecker<uint32_t>())
+                        .AddAttribute("VerifySignatures",
+                                      "Verify signatures of Data and drop Data that fail verification",
+                                      BooleanValue(false),
+                                      MakeBooleanAccessor(&IpocClient::m_verifySignatures),
+                                      MakeBooleanChecker())
+                        .AddAttribute("SigningScheme",
+                                      "Signing scheme of the gateway (fake, sha256, hmac, ecdsa, or merkle); "
+                                      "Data signed otherwise fail verification",
+                                      StringValue("fake"),
+                                      MakeStringAccessor(&IpocClient::m_signingScheme),
+                                      MakeStringChecker())
+                        .AddAttribute("HmacKey", "Key shared with the gateway for hmac signatures",
+                                      StringValue(""),
+                                      MakeStringAccessor(&IpocClient::m_hmacKey),
+                                      MakeStringChecker())
+                        .AddAttribute("VerificationThreads",
+                                      "Number of threads verifying released Data, 0 for the number of hardware threads",
+                                      UintegerValue(0),
+                                      MakeUintegerAccessor(&IpocClient::m_verificationThreads),
+                                      MakeUintegerChecker<uint32_t>())
  
                         ;
     return tid;
@@ -88,6 +110,9 @@ IpocClient::IpocClient()
     , m_dataPktRecvdCnt(0)
     , m_ipPktRecvdCnt(0)
     , m_ipPktSentCnt(0)
+    , m_verifySignatures(false)
+    , m_verificationThreads(0)
+    , m_invalidDataCnt(0)
 {
     // setting up things
     m_dataReseq = make_shared<Resequencer<shared_ptr<const Data>>>();
@@ -170,6 +195,10 @@ IpocClient::StartApplication()
     NS_LOG_DEBUG("Wait for gap " << m_waitForGap << " ms");
     m_dataReseq->SetWaitForGap(m_waitForGap);
 
+    if (m_verifySignatures) {
+        m_verifier = make_unique<IpocVerifier>(m_signingScheme, m_hmacKey,
+                                                m_verificationThreads);
+    }
 
     // the callback must be here, after the IpocClient app is created
     m_vnd->SetSendCallback (MakeCallback (&IpocClient::GetIpPackets, this));
@@ -212,6 +241,7 @@ bool
 IpocClient::GetIpPackets(Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION (this);
+    NDNSIM_PROFILE_SCOPE(IPOC);
     m_ipPktRecvdCnt++;
     NS_LOG_DEBUG("Upstream ipPktCnt = " << m_ipPktRecvdCnt);
     NS_LOG_INFO("IP pkt size =  " << packet->GetSize());
@@ -313,7 +343,20 @@ IpocClient::SendInterest(Ptr<Packet> packet)
 void
 IpocClient::ResequencerCallback(shared_ptr<std::vector<shared_ptr<const Data>>> pktls) {
     NS_LOG_FUNCTION (this);
+    // Data released together are verified as one batch
+    std::vector<bool> isValid;
+    if (m_verifier != nullptr) {
+        isValid = m_verifier->verifyBatch(*pktls);
+    }
+
     for (auto pkt = pktls->begin(); pkt != pktls->end(); pkt++) {
+        if (!isValid.empty() && !isValid[pkt - pktls->begin()]) {
+            m_invalidDataCnt++;
+            NS_LOG_WARN("Dropping Data with invalid signature " << (*pkt)->getName()
+                        << ", #invalid Data = " << m_invalidDataCnt);
+            continue;
+        }
+
         IPoCPacket ipocPkt((*pkt)->getContent());
 
         if (ipocPkt.getPayload().value_size() == 0)
@@ -394,6 +437,7 @@ void
 IpocClient::OnData(std::shared_ptr<const ndn::Data> data)
 {
     NS_LOG_FUNCTION (this);
+    NDNSIM_PROFILE_SCOPE(IPOC);
     m_dataPktRecvdCnt++;
     NS_LOG_INFO("Data name : " << data->getName());
     NS_LOG_DEBUG( "Name: " << m_name <<  "IDC = " << m_idc << " Cur IDC " << m_curIdc << " Reseq len" <<  m_reseqLen);
@@ -24,6 +24,7 @@
 #ifndef NDN_IPOC_CLIENT_H
 #define NDN_IPOC_CLIENT_H
 
+#include "ipoc-security.hpp"
 #include "resequencer.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
@@ -114,6 +115,13 @@ private:
     ns3::EventId m_t0SchID;
     ns3::EventId m_t1SchID;
     std::shared_ptr<Resequencer<shared_ptr<const Data>>> m_dataReseq;
+
+    bool m_verifySignatures;
+    std::string m_signingScheme;
+    std::string m_hmacKey;
+    uint32_t m_verificationThreads;
+    uint64_t m_invalidDataCnt; // dropped Data with invalid signatures
+    std::unique_ptr<IpocVerifier> m_verifier;
 };
 
 } // namespace ndn
@@ -0,0 +1,605 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+*
+* Copyright (c) 2017 Cable Television Laboratories, Inc.
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+#include "ipoc-security.hpp"
+
+#include "ns3/log.h"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/buffer-stream.hpp>
+#include <ndn-cxx/security/key-params.hpp>
+#include <ndn-cxx/security/transform/bool-sink.hpp>
+#include <ndn-cxx/security/transform/buffer-source.hpp>
+#include <ndn-cxx/security/transform/digest-filter.hpp>
+#include <ndn-cxx/security/transform/hmac-filter.hpp>
+#include <ndn-cxx/security/transform/public-key.hpp>
+#include <ndn-cxx/security/transform/signer-filter.hpp>
+#include <ndn-cxx/security/transform/stream-sink.hpp>
+#include <ndn-cxx/security/transform/verifier-filter.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE("ndn.IpocSecurity");
+
+namespace ns3 {
+namespace ndn {
+
+namespace transform = ::ndn::security::transform;
+using ::ndn::Buffer;
+using ::ndn::ConstBufferPtr;
+using ::ndn::DigestAlgorithm;
+using ::ndn::EncodingBuffer;
+using ::ndn::OBufferStream;
+
+static const uint32_t SIGNATURE_TYPE_HMAC_SHA256 = 4;
+// application-specific types
+static const uint32_t SIGNATURE_TYPE_MERKLE = 200;
+static const uint32_t SIGNATURE_TYPE_FAKE = 255;
+
+// TLV-TYPEs inside SignatureValue of the "merkle" scheme
+enum {
+    MerkleSignature_RootSignature = 1,
+    MerkleSignature_LeafIndex = 2,
+    MerkleSignature_LeafCount = 3,
+    MerkleSignature_PathHash = 4
+};
+
+static const size_t HASH_SIZE = 32;
+// largest DER encoding of a P-256 ECDSA signature
+static const size_t ECDSA_MAX_SIGNATURE_SIZE = 72;
+static const size_t MAX_VERIFIED_ROOTS = 1024;
+
+/**
+ * @brief Get SignatureType of Data signed with @p scheme
+ */
+static uint32_t
+getSignatureType(IpocSigner::Scheme scheme)
+{
+    switch (scheme) {
+    case IpocSigner::FAKE:
+        return SIGNATURE_TYPE_FAKE;
+    case IpocSigner::DIGEST_SHA256:
+        return ::ndn::tlv::DigestSha256;
+    case IpocSigner::HMAC_SHA256:
+        return SIGNATURE_TYPE_HMAC_SHA256;
+    case IpocSigner::ECDSA:
+        return ::ndn::tlv::SignatureSha256WithEcdsa;
+    case IpocSigner::MERKLE:
+        return SIGNATURE_TYPE_MERKLE;
+    }
+    return SIGNATURE_TYPE_FAKE;
+}
+
+/**
+ * @brief Public keys of all IpocSigner instances, a stand-in for certificate retrieval
+ */
+static std::map<Name, shared_ptr<transform::PublicKey>>&
+getPublicKeys()
+{
+    static std::map<Name, shared_ptr<transform::PublicKey>> keys;
+    return keys;
+}
+
+static std::mutex g_publicKeysMutex;
+
+static shared_ptr<transform::PublicKey>
+findPublicKey(const Signature& signature)
+{
+    if (!signature.hasKeyLocator() ||
+        signature.getKeyLocator().getType() != KeyLocator::KeyLocator_Name) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_publicKeysMutex);
+    auto it = getPublicKeys().find(signature.getKeyLocator().getName());
+    return it != getPublicKeys().end() ? it->second : nullptr;
+}
+
+/**
+ * @brief Invoke @p task for every index in [0, nTasks) on up to @p nThreads threads
+ */
+static void
+runParallel(size_t nTasks, size_t nThreads, const std::function<void(size_t)>& task)
+{
+    if (nThreads == 0) {
+        nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    nThreads = std::min(nThreads, nTasks);
+
+    std::atomic<size_t> nextTask(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&] {
+        for (size_t i = nextTask++; i < nTasks; i = nextTask++) {
+            try {
+                task(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+                nextTask = nTasks;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+static ConstBufferPtr
+computeSha256(const uint8_t* buf, size_t size)
+{
+    OBufferStream os;
+    transform::bufferSource(buf, size) >> transform::digestFilter(DigestAlgorithm::SHA256)
+                                       >> transform::streamSink(os);
+    return os.buf();
+}
+
+static ConstBufferPtr
+computeHmac(const std::string& key, const uint8_t* buf, size_t size)
+{
+    OBufferStream os;
+    transform::bufferSource(buf, size)
+      >> transform::hmacFilter(DigestAlgorithm::SHA256,
+                               reinterpret_cast<const uint8_t*>(key.data()), key.size())
+      >> transform::streamSink(os);
+    return os.buf();
+}
+
+/**
+ * @brief Hash of an inner node of the Merkle tree
+ *
+ * Leaves are hashes of the signed portions of Data, which start with the Name TLV-TYPE (7), so
+ * the prefix byte 1 keeps inner nodes and leaves apart.
+ */
+static ConstBufferPtr
+computeNodeHash(const Buffer& left, const Buffer& right)
+{
+    uint8_t buf[1 + 2 * HASH_SIZE];
+    buf[0] = 1;
+    std::memcpy(buf + 1, left.data(), HASH_SIZE);
+    std::memcpy(buf + 1 + HASH_SIZE, right.data(), HASH_SIZE);
+    return computeSha256(buf, sizeof(buf));
+}
+
+static bool
+isEqual(const Buffer& buffer, const uint8_t* buf, size_t size)
+{
+    return buffer.size() == size && std::memcmp(buffer.data(), buf, size) == 0;
+}
+
+/**
+ * @brief Verify ECDSA signature @p sig, which may be padded after its DER encoding
+ */
+static bool
+verifyEcdsa(const transform::PublicKey& key, const uint8_t* buf, size_t size,
+            const uint8_t* sig, size_t sigSize)
+{
+    // DER SEQUENCE of a P-256 signature has a single-byte length
+    if (sigSize < 2 || sig[0] != 0x30 || sig[1] + 2u > sigSize) {
+        return false;
+    }
+
+    bool isValid = false;
+    try {
+        transform::bufferSource(buf, size)
+          >> transform::verifierFilter(DigestAlgorithm::SHA256, key, sig, sig[1] + 2u)
+          >> transform::boolSink(isValid);
+    }
+    catch (const transform::Error&) {
+        return false;
+    }
+    return isValid;
+}
+
+IpocSigner::Scheme
+IpocSigner::parseScheme(const std::string& scheme)
+{
+    if (scheme == "fake") {
+        return FAKE;
+    }
+    else if (scheme == "sha256") {
+        return DIGEST_SHA256;
+    }
+    else if (scheme == "hmac") {
+        return HMAC_SHA256;
+    }
+    else if (scheme == "ecdsa") {
+        return ECDSA;
+    }
+    else if (scheme == "merkle") {
+        return MERKLE;
+    }
+    NS_FATAL_ERROR("Unknown IPoC signing scheme " << scheme);
+    return FAKE;
+}
+
+IpocSigner::IpocSigner(const std::string& scheme, const Name& keyName, const std::string& hmacKey,
+                       uint32_t fakeValue, size_t maxBatchSize, size_t nThreads)
+    : m_scheme(parseScheme(scheme))
+    , m_keyName(keyName)
+    , m_hmacKey(hmacKey)
+    , m_fakeValue(fakeValue)
+    , m_maxBatchSize(std::max<size_t>(maxBatchSize, 1))
+    , m_nThreads(nThreads)
+{
+    if (m_scheme == HMAC_SHA256 && m_hmacKey.empty()) {
+        NS_FATAL_ERROR("HMAC signing requires a non-empty key");
+    }
+
+    size_t maxValueSize = 0;
+    switch (m_scheme) {
+    case FAKE:
+        m_placeholder = Signature(makeSignatureInfo(),
+                                  ::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                                     m_fakeValue));
+        return;
+    case DIGEST_SHA256:
+    case HMAC_SHA256:
+        maxValueSize = HASH_SIZE;
+        break;
+    case ECDSA:
+        maxValueSize = ECDSA_MAX_SIGNATURE_SIZE;
+        break;
+    case MERKLE: {
+        size_t depth = 0;
+        while ((size_t(1) << depth) < m_maxBatchSize) {
+            ++depth;
+        }
+        Block value(::ndn::tlv::SignatureValue);
+        value.push_back(::ndn::makeBinaryBlock(MerkleSignature_RootSignature,
+                                               Buffer(ECDSA_MAX_SIGNATURE_SIZE).data(),
+                                               ECDSA_MAX_SIGNATURE_SIZE));
+        value.push_back(::ndn::makeNonNegativeIntegerBlock(MerkleSignature_LeafIndex,
+                                                           m_maxBatchSize - 1));
+        value.push_back(::ndn::makeNonNegativeIntegerBlock(MerkleSignature_LeafCount,
+                                                           m_maxBatchSize));
+        for (size_t i = 0; i < depth; ++i) {
+            value.push_back(::ndn::makeBinaryBlock(MerkleSignature_PathHash,
+                                                   Buffer(HASH_SIZE).data(), HASH_SIZE));
+        }
+        value.encode();
+        maxValueSize = value.value_size();
+        break;
+    }
+    }
+    Buffer zeros(maxValueSize);
+    m_placeholder = Signature(makeSignatureInfo(),
+                              ::ndn::makeBinaryBlock(::ndn::tlv::SignatureValue,
+                                                     zeros.data(), zeros.size()));
+
+    if (m_scheme == ECDSA || m_scheme == MERKLE) {
+        m_key = transform::generatePrivateKey(::ndn::EcdsaKeyParams(256));
+        auto publicKey = make_shared<transform::PublicKey>();
+        ConstBufferPtr publicKeyBits = m_key->derivePublicKey();
+        publicKey->loadPkcs8(publicKeyBits->data(), publicKeyBits->size());
+
+        std::lock_guard<std::mutex> lock(g_publicKeysMutex);
+        getPublicKeys()[m_keyName] = publicKey;
+    }
+}
+
+SignatureInfo
+IpocSigner::makeSignatureInfo() const
+{
+    SignatureInfo info(static_cast< ::ndn::tlv::SignatureTypeValue>(getSignatureType(m_scheme)));
+    if (m_scheme != DIGEST_SHA256 && !m_keyName.empty()) {
+        info.setKeyLocator(m_keyName);
+    }
+    return info;
+}
+
+ConstBufferPtr
+IpocSigner::signEcdsa(const uint8_t* buf, size_t size) const
+{
+    OBufferStream os;
+    transform::bufferSource(buf, size) >> transform::signerFilter(DigestAlgorithm::SHA256, *m_key)
+                                       >> transform::streamSink(os);
+    ConstBufferPtr signature = os.buf();
+    BOOST_ASSERT(signature->size() <= ECDSA_MAX_SIGNATURE_SIZE);
+
+    auto padded = make_shared<Buffer>(ECDSA_MAX_SIGNATURE_SIZE);
+    std::copy(signature->begin(), signature->end(), padded->begin());
+    return padded;
+}
+
+void
+IpocSigner::signBatch(const std::vector<shared_ptr<Data>>& batch)
+{
+    switch (m_scheme) {
+    case FAKE:
+        for (const auto& data : batch) {
+            data->setSignature(m_placeholder);
+            data->wireEncode();
+        }
+        break;
+    case DIGEST_SHA256:
+    case HMAC_SHA256:
+        // hashing is cheaper than handing the work over to other threads
+        for (const auto& data : batch) {
+            signOne(*data);
+        }
+        break;
+    case ECDSA:
+        runParallel(batch.size(), m_nThreads, [&] (size_t i) { signOne(*batch[i]); });
+        break;
+    case MERKLE:
+        for (size_t begin = 0; begin < batch.size(); begin += m_maxBatchSize) {
+            signTree(batch, begin, std::min(begin + m_maxBatchSize, batch.size()));
+        }
+        break;
+    }
+}
+
+void
+IpocSigner::signOne(Data& data) const
+{
+    data.setSignature(Signature(makeSignatureInfo()));
+    EncodingBuffer encoder;
+    data.wireEncode(encoder, true);
+
+    ConstBufferPtr value;
+    switch (m_scheme) {
+    case DIGEST_SHA256:
+        value = computeSha256(encoder.buf(), encoder.size());
+        break;
+    case HMAC_SHA256:
+        value = computeHmac(m_hmacKey, encoder.buf(), encoder.size());
+        break;
+    case ECDSA:
+        value = signEcdsa(encoder.buf(), encoder.size());
+        break;
+    default:
+        BOOST_ASSERT(false);
+        return;
+    }
+    data.wireEncode(encoder, ::ndn::makeBinaryBlock(::ndn::tlv::SignatureValue,
+                                                    value->data(), value->size()));
+}
+
+void
+IpocSigner::signTree(const std::vector<shared_ptr<Data>>& batch, size_t begin, size_t end) const
+{
+    size_t nLeaves = end - begin;
+    SignatureInfo info = makeSignatureInfo();
+
+    // levels[0] are leaves; an unpaired node is carried to the next level unchanged
+    std::vector<std::vector<ConstBufferPtr>> levels(1);
+    std::vector<std::unique_ptr<EncodingBuffer>> encoders;
+    for (size_t i = begin; i < end; ++i) {
+        batch[i]->setSignature(Signature(info));
+        encoders.push_back(make_unique<EncodingBuffer>());
+        batch[i]->wireEncode(*encoders.back(), true);
+        levels[0].push_back(computeSha256(encoders.back()->buf(), encoders.back()->size()));
+    }
+    while (levels.back().size() > 1) {
+        const auto& level = levels.back();
+        std::vector<ConstBufferPtr> next;
+        for (size_t j = 0; j < level.size(); j += 2) {
+            next.push_back(j + 1 < level.size() ? computeNodeHash(*level[j], *level[j + 1])
+                                                : level[j]);
+        }
+        levels.push_back(std::move(next));
+    }
+
+    ConstBufferPtr rootSignature = signEcdsa(levels.back()[0]->data(), HASH_SIZE);
+    for (size_t i = 0; i < nLeaves; ++i) {
+        Block value(::ndn::tlv::SignatureValue);
+        value.push_back(::ndn::makeBinaryBlock(MerkleSignature_RootSignature,
+                                               rootSignature->data(), rootSignature->size()));
+        value.push_back(::ndn::makeNonNegativeIntegerBlock(MerkleSignature_LeafIndex, i));
+        value.push_back(::ndn::makeNonNegativeIntegerBlock(MerkleSignature_LeafCount, nLeaves));
+        size_t index = i;
+        for (size_t l = 0; l + 1 < levels.size(); ++l) {
+            size_t sibling = index ^ 1;
+            if (sibling < levels[l].size()) {
+                value.push_back(::ndn::makeBinaryBlock(MerkleSignature_PathHash,
+                                                       levels[l][sibling]->data(), HASH_SIZE));
+            }
+            index >>= 1;
+        }
+        value.encode();
+        batch[begin + i]->wireEncode(*encoders[i], value);
+    }
+    NS_LOG_DEBUG("Signed Merkle tree of " << nLeaves << " Data");
+}
+
+IpocVerifier::IpocVerifier(const std::string& scheme, const std::string& hmacKey, size_t nThreads)
+    : m_scheme(IpocSigner::parseScheme(scheme))
+    , m_hmacKey(hmacKey)
+    , m_nThreads(nThreads)
+    , m_nRootVerifications(0)
+{
+    if (m_scheme == IpocSigner::HMAC_SHA256 && m_hmacKey.empty()) {
+        NS_FATAL_ERROR("HMAC verification requires a non-empty key");
+    }
+}
+
+bool
+IpocVerifier::verifyOne(const Data& data, TreeRoot& root) const
+{
+    const Signature& signature = data.getSignature();
+    const Block& wire = data.wireEncode();
+    // signed portion is everything but SignatureValue, which is the last element of Data
+    const uint8_t* signedBuf = wire.value();
+    size_t signedSize = wire.value_size() - signature.getValue().size();
+    const Block& value = signature.getValue();
+
+    // a Data signed with another scheme, however valid, may come from anyone
+    if (signature.getType() != getSignatureType(m_scheme)) {
+        return false;
+    }
+
+    switch (signature.getType()) {
+    case SIGNATURE_TYPE_FAKE:
+        return true;
+    case ::ndn::tlv::DigestSha256:
+        return isEqual(*computeSha256(signedBuf, signedSize), value.value(), value.value_size());
+    case SIGNATURE_TYPE_HMAC_SHA256:
+        return !m_hmacKey.empty() &&
+               isEqual(*computeHmac(m_hmacKey, signedBuf, signedSize), value.value(),
+                       value.value_size());
+    case ::ndn::tlv::SignatureSha256WithEcdsa: {
+        auto key = findPublicKey(signature);
+        return key != nullptr &&
+               verifyEcdsa(*key, signedBuf, signedSize, value.value(), value.value_size());
+    }
+    case SIGNATURE_TYPE_MERKLE:
+        break;
+    default:
+        return false;
+    }
+
+    if (!signature.hasKeyLocator() ||
+        signature.getKeyLocator().getType() != KeyLocator::KeyLocator_Name) {
+        return false;
+    }
+
+    try {
+        Block elements = value;
+        elements.parse();
+        auto element = elements.elements_begin();
+        if (elements.elements_size() < 3 ||
+            element[0].type() != MerkleSignature_RootSignature ||
+            element[1].type() != MerkleSignature_LeafIndex ||
+            element[2].type() != MerkleSignature_LeafCount) {
+            return false;
+        }
+        root.signature = element[0];
+        uint64_t index = ::ndn::readNonNegativeInteger(element[1]);
+        uint64_t width = ::ndn::readNonNegativeInteger(element[2]);
+        if (index >= width) {
+            return false;
+        }
+
+        ConstBufferPtr node = computeSha256(signedBuf, signedSize);
+        auto pathHash = element + 3;
+        for (; width > 1; index >>= 1, width = (width + 1) / 2) {
+            if ((index ^ 1) >= width) {
+                continue; // unpaired node
+            }
+            if (pathHash == elements.elements_end() ||
+                pathHash->type() != MerkleSignature_PathHash || pathHash->value_size() != HASH_SIZE) {
+                return false;
+            }
+            Buffer sibling(pathHash->value(), HASH_SIZE);
+            node = (index & 1) ? computeNodeHash(sibling, *node) : computeNodeHash(*node, sibling);
+            ++pathHash;
+        }
+        if (pathHash != elements.elements_end()) {
+            return false;
+        }
+
+        root.hash = node;
+        root.key = signature.getKeyLocator().getName().toUri();
+        root.key.push_back('\0');
+        root.key.append(reinterpret_cast<const char*>(node->data()), node->size());
+        return true;
+    }
+    catch (const ::ndn::tlv::Error&) {
+        return false;
+    }
+}
+
+bool
+IpocVerifier::isRootVerified(const std::string& rootKey) const
+{
+    return m_verifiedRoots.count(rootKey) > 0;
+}
+
+void
+IpocVerifier::addVerifiedRoot(const std::string& rootKey)
+{
+    if (!m_verifiedRoots.insert(rootKey).second) {
+        return;
+    }
+    m_verifiedRootsOrder.push_back(rootKey);
+    if (m_verifiedRootsOrder.size() > MAX_VERIFIED_ROOTS) {
+        m_verifiedRoots.erase(m_verifiedRootsOrder.front());
+        m_verifiedRootsOrder.pop_front();
+    }
+}
+
+std::vector<bool>
+IpocVerifier::verifyBatch(const std::vector<shared_ptr<const Data>>& batch)
+{
+    std::vector<char> isValid(batch.size());
+    std::vector<TreeRoot> roots(batch.size());
+    runParallel(batch.size(), m_nThreads, [&] (size_t i) {
+        isValid[i] = verifyOne(*batch[i], roots[i]);
+    });
+
+    // signature of every distinct root is verified once
+    std::map<std::string, bool> rootResults;
+    std::vector<size_t> rootOwners;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (isValid[i] && !roots[i].key.empty() && !isRootVerified(roots[i].key) &&
+            rootResults.emplace(roots[i].key, false).second) {
+            rootOwners.push_back(i);
+        }
+    }
+    std::vector<char> isRootValid(rootOwners.size());
+    runParallel(rootOwners.size(), m_nThreads, [&] (size_t j) {
+        const TreeRoot& root = roots[rootOwners[j]];
+        auto key = findPublicKey(batch[rootOwners[j]]->getSignature());
+        isRootValid[j] = key != nullptr &&
+                         verifyEcdsa(*key, root.hash->data(), root.hash->size(),
+                                     root.signature.value(), root.signature.value_size());
+    });
+    m_nRootVerifications += rootOwners.size();
+    for (size_t j = 0; j < rootOwners.size(); ++j) {
+        const std::string& rootKey = roots[rootOwners[j]].key;
+        rootResults[rootKey] = isRootValid[j];
+        if (isRootValid[j]) {
+            addVerifiedRoot(rootKey);
+        }
+    }
+
+    std::vector<bool> results(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!isValid[i]) {
+            continue;
+        }
+        auto rootResult = rootResults.find(roots[i].key);
+        results[i] = roots[i].key.empty() ||
+                     (rootResult != rootResults.end() ? rootResult->second : isRootVerified(roots[i].key));
+    }
+    return results;
+}
+
+} // namespace ndn
+} // namespace ns3
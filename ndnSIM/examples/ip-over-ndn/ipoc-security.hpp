@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+*
+* Copyright (c) 2017 Cable Television Laboratories, Inc.
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef NDN_IPOC_SECURITY_H
+#define NDN_IPOC_SECURITY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/security/transform/private-key.hpp>
+
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Signs IPoC Data on the gateway
+ *
+ * Supported schemes:
+ *  - "fake": SignatureInfo of type 255 and a constant SignatureValue, which costs nothing;
+ *  - "sha256": DigestSha256;
+ *  - "hmac": HMAC-SHA256 with a key shared with the clients;
+ *  - "ecdsa": SHA256withECDSA (P-256) signature of every Data;
+ *  - "merkle": one ECDSA signature over the root of a Merkle tree of up to maxBatchSize Data.
+ *    SignatureValue of every Data contains the root signature and the authentication path
+ *    from the Data to the root (see IpocVerifier).
+ *
+ * ECDSA signatures are padded with zeros to the largest DER size, so that Data sizes, and thus
+ * simulation results, do not depend on random bits of the signatures.
+ *
+ * Data of a batch are signed on up to nThreads threads (0 for the number of hardware threads)
+ * before signBatch returns, so signing does not change simulated time, but uses idle cores
+ * instead of the simulator thread.
+ */
+class IpocSigner
+{
+public:
+    enum Scheme {
+        FAKE,
+        DIGEST_SHA256,
+        HMAC_SHA256,
+        ECDSA,
+        MERKLE
+    };
+
+    /**
+     * @brief Create signer, which publishes its public key under @p keyName for IpocVerifier
+     * @param fakeValue SignatureValue of the "fake" scheme
+     */
+    IpocSigner(const std::string& scheme, const Name& keyName, const std::string& hmacKey,
+               uint32_t fakeValue, size_t maxBatchSize, size_t nThreads);
+
+    /**
+     * @brief Get scheme from its name, fail the simulation if the name is unknown
+     */
+    static Scheme
+    parseScheme(const std::string& scheme);
+
+    Scheme
+    getScheme() const
+    {
+        return m_scheme;
+    }
+
+    /**
+     * @brief Get signature of the largest size produced by the scheme
+     *
+     * Encoding a Data with this signature gives an upper bound of the size of the signed Data.
+     */
+    const Signature&
+    getPlaceholder() const
+    {
+        return m_placeholder;
+    }
+
+    /**
+     * @brief Sign and encode every Data of @p batch
+     *
+     * With the "merkle" scheme, the batch is split into trees of at most maxBatchSize Data.
+     */
+    void
+    signBatch(const std::vector<shared_ptr<Data>>& batch);
+
+private:
+    SignatureInfo
+    makeSignatureInfo() const;
+
+    void
+    signOne(Data& data) const;
+
+    void
+    signTree(const std::vector<shared_ptr<Data>>& batch, size_t begin, size_t end) const;
+
+    ::ndn::ConstBufferPtr
+    signEcdsa(const uint8_t* buf, size_t size) const;
+
+private:
+    Scheme m_scheme;
+    Name m_keyName;
+    std::string m_hmacKey;
+    uint32_t m_fakeValue;
+    size_t m_maxBatchSize;
+    size_t m_nThreads;
+    std::unique_ptr<::ndn::security::transform::PrivateKey> m_key;
+    Signature m_placeholder;
+};
+
+/**
+ * @brief Verifies Data signed by IpocSigner on the client
+ *
+ * Only Data signed with the scheme the verifier expects are accepted; in particular, Data with
+ * the "fake" or DigestSha256 signature are rejected unless that scheme is expected.  Public keys
+ * of ECDSA schemes are looked up by KeyLocator among the keys published by IpocSigner instances.
+ *
+ * verifyBatch checks Merkle authentication paths of all Data first, and then verifies the
+ * signature of every distinct tree root only once.  Verified roots are remembered, so Data of a
+ * tree that arrive in later batches cost two hashes per tree level.
+ */
+class IpocVerifier
+{
+public:
+    /**
+     * @param scheme signing scheme of the gateway, as accepted by IpocSigner
+     */
+    IpocVerifier(const std::string& scheme, const std::string& hmacKey, size_t nThreads);
+
+    /**
+     * @return whether each Data of @p batch has a valid signature
+     */
+    std::vector<bool>
+    verifyBatch(const std::vector<shared_ptr<const Data>>& batch);
+
+    /**
+     * @brief Get number of ECDSA verifications done for Merkle tree roots
+     */
+    uint64_t
+    getNRootVerifications() const
+    {
+        return m_nRootVerifications;
+    }
+
+private:
+    /// Merkle tree root, whose signature is verified once for all Data of the tree
+    struct TreeRoot
+    {
+        std::string key; // key name and root hash, empty if there is no tree
+        ::ndn::ConstBufferPtr hash;
+        Block signature;
+    };
+
+    /**
+     * @brief Verify @p data, except for the root signature of the "merkle" scheme
+     */
+    bool
+    verifyOne(const Data& data, TreeRoot& root) const;
+
+    bool
+    isRootVerified(const std::string& rootKey) const;
+
+    void
+    addVerifiedRoot(const std::string& rootKey);
+
+private:
+    IpocSigner::Scheme m_scheme;
+    std::string m_hmacKey;
+    size_t m_nThreads;
+    std::set<std::string> m_verifiedRoots;
+    std::deque<std::string> m_verifiedRootsOrder;
+    uint64_t m_nRootVerifications;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_IPOC_SECURITY_H
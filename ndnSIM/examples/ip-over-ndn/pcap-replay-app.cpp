@@ -0,0 +1,357 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+*
+* Copyright (c) 2017 Cable Television Laboratories, Inc.
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+#include "pcap-replay-app.hpp"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PcapReplayApp");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(PcapReplayApp);
+
+static const uint32_t PCAP_MAGIC_MICROSECONDS = 0xa1b2c3d4;
+static const uint32_t PCAP_MAGIC_NANOSECONDS = 0xa1b23c4d;
+static const size_t PCAP_FILE_HEADER_SIZE = 24;
+static const size_t PCAP_RECORD_HEADER_SIZE = 16;
+
+static const uint32_t LINKTYPE_ETHERNET = 1;
+static const uint32_t LINKTYPE_RAW = 101;
+static const uint32_t LINKTYPE_LINUX_SLL = 113;
+static const uint32_t LINKTYPE_IPV4 = 228;
+static const uint32_t LINKTYPE_LINUX_SLL2 = 276;
+
+static const uint16_t ETHERTYPE_IPV4 = 0x0800;
+static const uint16_t ETHERTYPE_VLAN = 0x8100;
+static const uint16_t ETHERTYPE_QINQ = 0x88a8;
+
+// replayed pages are released in chunks of this size
+static const size_t RELEASE_CHUNK_SIZE = 16 * 1024 * 1024;
+
+static uint16_t
+readUint16BigEndian(const uint8_t* data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+TypeId
+PcapReplayApp::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ndn::PcapReplayApp")
+                        .SetParent<Application>()
+                        .AddConstructor<PcapReplayApp>()
+                        .AddAttribute("File", "Name of the pcap file to replay",
+                                      StringValue(""),
+                                      MakeStringAccessor(&PcapReplayApp::m_fileName),
+                                      MakeStringChecker())
+                        .AddAttribute("VirtualNetDevice",
+                                      "VirtualNetDevice (of IpocClient or GatewayApp) to inject packets to",
+                                      PointerValue(),
+                                      MakePointerAccessor(&PcapReplayApp::m_vnd),
+                                      MakePointerChecker<VirtualNetDevice>())
+                        .AddAttribute("TimeScale",
+                                      "Factor applied to the intervals between captured packets "
+                                      "(e.g., 0.5 to replay twice as fast)",
+                                      DoubleValue(1.0),
+                                      MakeDoubleAccessor(&PcapReplayApp::m_timeScale),
+                                      MakeDoubleChecker<double>(0.0))
+                        .AddAttribute("PadTruncated",
+                                      "Pad packets truncated by the capture to their original length",
+                                      BooleanValue(true),
+                                      MakeBooleanAccessor(&PcapReplayApp::m_padTruncated),
+                                      MakeBooleanChecker())
+
+                        .AddTraceSource("Tx", "A packet has been injected",
+                                        MakeTraceSourceAccessor(&PcapReplayApp::m_txTrace),
+                                        "ns3::Packet::TracedCallback")
+                        ;
+    return tid;
+}
+
+PcapReplayApp::PcapReplayApp()
+    : m_timeScale(1.0)
+    , m_padTruncated(true)
+    , m_fd(-1)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_offset(0)
+    , m_releasedOffset(0)
+    , m_isSwapped(false)
+    , m_hasNanoseconds(false)
+    , m_linkType(0)
+    , m_hasFirstTimestamp(false)
+    , m_firstTimestamp(0)
+    , m_nSkipped(0)
+    , m_nSent(0)
+{
+}
+
+PcapReplayApp::~PcapReplayApp()
+{
+    CloseCapture();
+}
+
+void
+PcapReplayApp::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_vnd == nullptr, "VirtualNetDevice attribute is not set");
+
+    OpenCapture();
+    m_hasFirstTimestamp = false;
+    m_startTime = Simulator::Now();
+    m_nSkipped = 0;
+    m_nSent = 0;
+    ScheduleNextPacket();
+}
+
+void
+PcapReplayApp::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_sendEvent);
+    CloseCapture();
+}
+
+void
+PcapReplayApp::OpenCapture()
+{
+    CloseCapture();
+
+    m_fd = ::open(m_fileName.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        NS_FATAL_ERROR("Cannot open pcap file " << m_fileName << ": " << std::strerror(errno));
+    }
+
+    struct stat status;
+    if (::fstat(m_fd, &status) != 0 || static_cast<size_t>(status.st_size) < PCAP_FILE_HEADER_SIZE) {
+        NS_FATAL_ERROR(m_fileName << " is not a pcap file");
+    }
+    m_size = status.st_size;
+
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+        NS_FATAL_ERROR("Cannot map pcap file " << m_fileName << ": " << std::strerror(errno));
+    }
+    m_data = static_cast<const uint8_t*>(data);
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+
+    uint32_t magic;
+    std::memcpy(&magic, m_data, sizeof(magic));
+    if (magic == PCAP_MAGIC_MICROSECONDS || magic == PCAP_MAGIC_NANOSECONDS) {
+        m_isSwapped = false;
+    }
+    else if (__builtin_bswap32(magic) == PCAP_MAGIC_MICROSECONDS ||
+             __builtin_bswap32(magic) == PCAP_MAGIC_NANOSECONDS) {
+        m_isSwapped = true;
+        magic = __builtin_bswap32(magic);
+    }
+    else {
+        NS_FATAL_ERROR(m_fileName << " is not a pcap file (pcapng is not supported)");
+    }
+    m_hasNanoseconds = (magic == PCAP_MAGIC_NANOSECONDS);
+
+    // link type is the last field of the file header; upper bits may carry FCS information
+    m_linkType = ReadUint32(m_data + 20) & 0x0FFFFFFF;
+    if (m_linkType != LINKTYPE_ETHERNET && m_linkType != LINKTYPE_RAW &&
+        m_linkType != LINKTYPE_LINUX_SLL && m_linkType != LINKTYPE_IPV4 &&
+        m_linkType != LINKTYPE_LINUX_SLL2) {
+        NS_FATAL_ERROR("Link type " << m_linkType << " of " << m_fileName << " is not supported");
+    }
+
+    m_offset = PCAP_FILE_HEADER_SIZE;
+    m_releasedOffset = 0;
+    NS_LOG_INFO("Replaying " << m_fileName << " (" << m_size << " bytes, link type "
+                << m_linkType << ")");
+}
+
+void
+PcapReplayApp::CloseCapture()
+{
+    if (m_data != nullptr) {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+    m_offset = 0;
+    m_releasedOffset = 0;
+}
+
+uint32_t
+PcapReplayApp::ReadUint32(const uint8_t* data) const
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return m_isSwapped ? __builtin_bswap32(value) : value;
+}
+
+bool
+PcapReplayApp::ReadRecord(Record& record)
+{
+    if (m_size - m_offset < PCAP_RECORD_HEADER_SIZE) {
+        if (m_offset != m_size) {
+            NS_LOG_WARN("Ignoring truncated record at the end of " << m_fileName);
+        }
+        return false;
+    }
+
+    const uint8_t* header = m_data + m_offset;
+    uint32_t seconds = ReadUint32(header);
+    uint32_t fraction = ReadUint32(header + 4);
+    record.capturedLength = ReadUint32(header + 8);
+    record.originalLength = ReadUint32(header + 12);
+    record.timestamp = static_cast<int64_t>(seconds) * 1000000000 +
+                       static_cast<int64_t>(fraction) * (m_hasNanoseconds ? 1 : 1000);
+
+    if (m_size - m_offset - PCAP_RECORD_HEADER_SIZE < record.capturedLength) {
+        NS_LOG_WARN("Ignoring truncated record at the end of " << m_fileName);
+        m_offset = m_size;
+        return false;
+    }
+    record.data = header + PCAP_RECORD_HEADER_SIZE;
+    m_offset += PCAP_RECORD_HEADER_SIZE + record.capturedLength;
+
+    // the cursor only moves forward, so pages behind it will not be needed again
+    if (m_offset - m_releasedOffset >= RELEASE_CHUNK_SIZE) {
+        size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t releaseEnd = (record.data - m_data) / pageSize * pageSize;
+        if (releaseEnd > m_releasedOffset) {
+            ::madvise(const_cast<uint8_t*>(m_data) + m_releasedOffset, releaseEnd - m_releasedOffset,
+                      MADV_DONTNEED);
+            m_releasedOffset = releaseEnd;
+        }
+    }
+    return true;
+}
+
+Ptr<Packet>
+PcapReplayApp::MakeIpv4Packet(const Record& record) const
+{
+    size_t linkHeaderSize = 0;
+    switch (m_linkType) {
+    case LINKTYPE_ETHERNET: {
+        linkHeaderSize = 14;
+        if (record.capturedLength < linkHeaderSize) {
+            return nullptr;
+        }
+        uint16_t etherType = readUint16BigEndian(record.data + 12);
+        while ((etherType == ETHERTYPE_VLAN || etherType == ETHERTYPE_QINQ) &&
+               record.capturedLength >= linkHeaderSize + 4) {
+            etherType = readUint16BigEndian(record.data + linkHeaderSize + 2);
+            linkHeaderSize += 4;
+        }
+        if (etherType != ETHERTYPE_IPV4) {
+            return nullptr;
+        }
+        break;
+    }
+    case LINKTYPE_LINUX_SLL:
+        linkHeaderSize = 16;
+        if (record.capturedLength < linkHeaderSize ||
+            readUint16BigEndian(record.data + 14) != ETHERTYPE_IPV4) {
+            return nullptr;
+        }
+        break;
+    case LINKTYPE_LINUX_SLL2:
+        linkHeaderSize = 20;
+        if (record.capturedLength < linkHeaderSize ||
+            readUint16BigEndian(record.data) != ETHERTYPE_IPV4) {
+            return nullptr;
+        }
+        break;
+    default: // LINKTYPE_RAW, LINKTYPE_IPV4
+        break;
+    }
+
+    // smallest IPv4 header
+    if (record.capturedLength < linkHeaderSize + 20 ||
+        (record.data[linkHeaderSize] >> 4) != 4) {
+        return nullptr;
+    }
+
+    uint32_t capturedLength = record.capturedLength - linkHeaderSize;
+    Ptr<Packet> packet = Create<Packet>(record.data + linkHeaderSize, capturedLength);
+    if (m_padTruncated && record.originalLength > record.capturedLength) {
+        packet->AddPaddingAtEnd(record.originalLength - record.capturedLength);
+    }
+    return packet;
+}
+
+void
+PcapReplayApp::ScheduleNextPacket()
+{
+    Record record;
+    while (ReadRecord(record)) {
+        Ptr<Packet> packet = MakeIpv4Packet(record);
+        if (packet == nullptr) {
+            ++m_nSkipped;
+            continue;
+        }
+
+        if (!m_hasFirstTimestamp) {
+            m_firstTimestamp = record.timestamp;
+            m_hasFirstTimestamp = true;
+        }
+
+        // captures are not always sorted by time; late packets are sent immediately
+        int64_t offset = std::llround((record.timestamp - m_firstTimestamp) * m_timeScale);
+        Time delay = std::max(m_startTime + NanoSeconds(offset) - Simulator::Now(), Time(0));
+        m_sendEvent = Simulator::Schedule(delay, &PcapReplayApp::SendPacket, this, packet);
+        return;
+    }
+
+    NS_LOG_INFO("Replay of " << m_fileName << " finished: " << m_nSent << " packets sent, "
+                << m_nSkipped << " non-IPv4 records skipped");
+    CloseCapture();
+}
+
+void
+PcapReplayApp::SendPacket(Ptr<Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    m_txTrace(packet);
+    ++m_nSent;
+    m_vnd->Send(packet, m_vnd->GetAddress(), ETHERTYPE_IPV4);
+
+    ScheduleNextPacket();
+}
+
+} // namespace ndn
+} // namespace ns3
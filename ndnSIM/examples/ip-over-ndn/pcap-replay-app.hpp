@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+*
+* Copyright (c) 2017 Cable Television Laboratories, Inc.
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License version 2 as
+* published by the Free Software Foundation;
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef NDN_PCAP_REPLAY_APP_H
+#define NDN_PCAP_REPLAY_APP_H
+
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+#include "ns3/virtual-net-device.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Traffic source that replays IPv4 packets of a pcap capture into a VirtualNetDevice
+ *
+ * Every IPv4 packet of the capture is passed to VirtualNetDevice::Send, i.e., to IpocClient or
+ * GatewayApp, as if the IP stack of the node sent it.  A packet is injected at its capture
+ * timestamp relative to the first packet of the capture, multiplied by TimeScale and counted
+ * from the start of the application, so the replay is deterministic.
+ *
+ * The capture is memory-mapped and parsed one record at a time; pages of already replayed
+ * records are released, so captures larger than the available memory can be replayed.
+ *
+ * Supported are classic pcap files with microsecond or nanosecond timestamps in either byte
+ * order, with Ethernet (including VLAN tags), Linux cooked (v1 and v2), and raw IP link types.
+ * Records that do not carry IPv4 are skipped.  Packets truncated by the capture snap length are
+ * padded with zeros to their original length, unless PadTruncated is false.
+ */
+class PcapReplayApp : public Application
+{
+public:
+    static TypeId
+    GetTypeId(void);
+
+    PcapReplayApp();
+
+    virtual
+    ~PcapReplayApp();
+
+protected:
+    virtual void
+    StartApplication();
+
+    virtual void
+    StopApplication();
+
+private:
+    struct Record
+    {
+        int64_t timestamp; // nanoseconds
+        const uint8_t* data;
+        uint32_t capturedLength;
+        uint32_t originalLength;
+    };
+
+    void
+    OpenCapture();
+
+    void
+    CloseCapture();
+
+    uint32_t
+    ReadUint32(const uint8_t* data) const;
+
+    /**
+     * @brief Read the next record and advance the cursor
+     * @return false at the end of the capture
+     */
+    bool
+    ReadRecord(Record& record);
+
+    /**
+     * @brief Create packet from the IPv4 datagram in @p record
+     * @return null if the record does not contain IPv4
+     */
+    Ptr<Packet>
+    MakeIpv4Packet(const Record& record) const;
+
+    void
+    ScheduleNextPacket();
+
+    void
+    SendPacket(Ptr<Packet> packet);
+
+private:
+    std::string m_fileName;
+    Ptr<VirtualNetDevice> m_vnd;
+    double m_timeScale;
+    bool m_padTruncated;
+
+    int m_fd;
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset;
+    size_t m_releasedOffset;
+    bool m_isSwapped;
+    bool m_hasNanoseconds;
+    uint32_t m_linkType;
+
+    bool m_hasFirstTimestamp;
+    int64_t m_firstTimestamp;
+    Time m_startTime;
+    EventId m_sendEvent;
+    uint64_t m_nSkipped;
+    uint64_t m_nSent;
+
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PCAP_REPLAY_APP_H
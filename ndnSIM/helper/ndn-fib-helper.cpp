@@ -39,6 +39,8 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -174,6 +176,44 @@ FibHelper::AddRoute(const std::string& nodeName, const Name& prefix,
   AddRoute(node, prefix, otherNode, metric);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  shared_ptr<nfd::Forwarder> forwarder = ndn->getForwarder();
+  nfd::Fib& fib = forwarder->getFib();
+  for (const Route& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    NS_ASSERT_MSG(forwarder->getFaceTable().get(route.face->getId()) == route.face.get(),
+                  "Face with ID [" << route.face->getId() << "] does not exist on node ["
+                                   << node->GetId() << "]");
+
+    nfd::fib::Entry* entry = fib.insert(route.prefix).first;
+    entry->addNextHop(*route.face, route.metric);
+  }
+}
+
+void
+FibHelper::RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const Route& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << route.prefix << " via "
+                     << route.face->getLocalUri());
+
+    nfd::fib::Entry* entry = fib.findExactMatch(route.prefix);
+    if (entry != nullptr && entry->hasNextHop(*route.face)) {
+      fib.removeNextHop(*entry, *route.face);
+    }
+  }
+}
+
 void
 FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face)
 {
@@ -43,6 +43,16 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * \brief Forwarding entry to be added by AddRoutes
+   */
+  struct Route
+  {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -100,6 +110,32 @@ public:
   AddRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName,
            int32_t metric);
 
+  /**
+   * \brief Add a batch of forwarding entries to FIB
+   *
+   * The result is the same as calling AddRoute for every route, but the entries are written
+   * directly into the FIB of the node's forwarder, instead of encoding, signing, and dispatching
+   * a FIB management command for each of them.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries; all faces must belong to \p node
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Remove a batch of forwarding entries from FIB
+   *
+   * For every route, the next hop through route.face is removed from the FIB entry of
+   * route.prefix directly in the node's forwarder (route.metric is ignored).  Entries that are
+   * left without next hops are erased.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries; all faces must belong to \p node
+   */
+  static void
+  RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief remove forwarding entry in FIB
    *
@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-engine.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "daemon/face/face.hpp"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingEngine");
+
+namespace ns3 {
+namespace ndn {
+
+const GlobalRoutingEngine::VertexId GlobalRoutingEngine::NO_VERTEX =
+  std::numeric_limits<VertexId>::max();
+const GlobalRoutingEngine::EdgeId GlobalRoutingEngine::NO_EDGE =
+  std::numeric_limits<EdgeId>::max();
+const uint32_t GlobalRoutingEngine::INF_DISTANCE = std::numeric_limits<uint16_t>::max();
+const uint16_t GlobalRoutingEngine::DISABLED_WEIGHT = std::numeric_limits<uint16_t>::max() - 1;
+const uint16_t GlobalRoutingEngine::DOWN_WEIGHT = std::numeric_limits<uint16_t>::max();
+
+GlobalRoutingEngine::GlobalRoutingEngine()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0) {
+      m_ids[PeekPointer(gr)] = m_vertices.size();
+      m_vertices.push_back(gr);
+    }
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0) {
+      m_ids[PeekPointer(gr)] = m_vertices.size();
+      m_vertices.push_back(gr);
+    }
+  }
+
+  m_offsets.reserve(m_vertices.size() + 1);
+  m_offsets.push_back(0);
+  for (const auto& vertex : m_vertices) {
+    for (const auto& incidency : vertex->GetIncidencies()) {
+      VertexId target = GetVertexId(std::get<2>(incidency));
+      NS_ASSERT_MSG(target != NO_VERTEX, "GlobalRouter graph is not closed");
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      m_targets.push_back(target);
+      m_faces.push_back(face);
+      m_metrics.push_back(std::get<3>(incidency));
+      m_weights.push_back(GetMetric(m_targets.size() - 1));
+    }
+    m_offsets.push_back(m_targets.size());
+  }
+
+  m_sources.resize(m_targets.size());
+  m_inOffsets.assign(m_vertices.size() + 1, 0);
+  for (VertexId u = 0; u < m_vertices.size(); ++u) {
+    for (EdgeId edge = m_offsets[u]; edge < m_offsets[u + 1]; ++edge) {
+      m_sources[edge] = u;
+      ++m_inOffsets[m_targets[edge] + 1];
+    }
+  }
+  for (VertexId v = 0; v < m_vertices.size(); ++v) {
+    m_inOffsets[v + 1] += m_inOffsets[v];
+  }
+  m_inEdges.resize(m_targets.size());
+  std::vector<EdgeId> position(m_inOffsets.begin(), m_inOffsets.end() - 1);
+  for (EdgeId edge = 0; edge < m_targets.size(); ++edge) {
+    m_inEdges[position[m_targets[edge]]++] = edge;
+  }
+
+  NS_LOG_DEBUG("Snapshot of " << m_vertices.size() << " vertices and " << m_targets.size()
+               << " edges");
+}
+
+GlobalRoutingEngine::VertexId
+GlobalRoutingEngine::GetVertexId(Ptr<GlobalRouter> router) const
+{
+  auto id = m_ids.find(PeekPointer(router));
+  if (id == m_ids.end()) {
+    return NO_VERTEX;
+  }
+  return id->second;
+}
+
+std::vector<GlobalRoutingEngine::EdgeId>
+GlobalRoutingEngine::FindEdges(VertexId from, VertexId to) const
+{
+  std::vector<EdgeId> edges;
+  for (EdgeId edge = m_offsets[from]; edge < m_offsets[from + 1]; ++edge) {
+    if (m_targets[edge] == to) {
+      edges.push_back(edge);
+    }
+  }
+  return edges;
+}
+
+void
+GlobalRoutingEngine::CalculatePaths(VertexId source, const Face* onlyFace,
+                                    std::vector<Path>& paths) const
+{
+  paths.assign(m_vertices.size(), Path{NO_EDGE, INF_DISTANCE});
+  paths[source].distance = 0;
+
+  typedef std::pair<uint32_t, VertexId> QueueItem;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+  queue.push(QueueItem(0, source));
+
+  while (!queue.empty()) {
+    uint32_t distance = queue.top().first;
+    VertexId u = queue.top().second;
+    queue.pop();
+    if (distance != paths[u].distance) {
+      continue; // stale item, u has been settled with a shorter distance
+    }
+
+    for (EdgeId edge = m_offsets[u]; edge < m_offsets[u + 1]; ++edge) {
+      uint16_t weight = m_weights[edge];
+      if (u == source && onlyFace != nullptr && m_faces[edge].get() != onlyFace) {
+        weight = DISABLED_WEIGHT;
+      }
+
+      VertexId v = m_targets[edge];
+      uint32_t newDistance = distance + weight;
+      if (newDistance < paths[v].distance) {
+        paths[v].distance = newDistance;
+        if (paths[u].firstEdge != NO_EDGE) {
+          paths[v].firstEdge = paths[u].firstEdge;
+        }
+        else {
+          paths[v].firstEdge = m_faces[edge] != nullptr ? edge : NO_EDGE;
+        }
+        queue.push(QueueItem(newDistance, v));
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::CalculateDistancesTo(VertexId target, std::vector<uint32_t>& distances) const
+{
+  distances.assign(m_vertices.size(), INF_DISTANCE);
+  distances[target] = 0;
+
+  typedef std::pair<uint32_t, VertexId> QueueItem;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+  queue.push(QueueItem(0, target));
+
+  while (!queue.empty()) {
+    uint32_t distance = queue.top().first;
+    VertexId v = queue.top().second;
+    queue.pop();
+    if (distance != distances[v]) {
+      continue;
+    }
+
+    for (EdgeId i = m_inOffsets[v]; i < m_inOffsets[v + 1]; ++i) {
+      EdgeId edge = m_inEdges[i];
+      VertexId u = m_sources[edge];
+      uint32_t newDistance = distance + m_weights[edge];
+      if (newDistance < distances[u]) {
+        distances[u] = newDistance;
+        queue.push(QueueItem(newDistance, u));
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::RunParallel(size_t nTasks, size_t nThreads,
+                                 const std::function<void(size_t)>& task)
+{
+  if (nThreads == 0) {
+    nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  nThreads = std::min(nThreads, nTasks);
+
+  std::atomic<size_t> nextTask(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto worker = [&] {
+    for (size_t i = nextTask++; i < nTasks; i = nextTask++) {
+      try {
+        task(i);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+        nextTask = nTasks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
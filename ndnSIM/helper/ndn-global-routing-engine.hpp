@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_ENGINE_H
+#define NDN_GLOBAL_ROUTING_ENGINE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Shortest path computation over a compact snapshot of the GlobalRouter graph
+ *
+ * The constructor copies the graph formed by GlobalRouter objects of all nodes and channels
+ * into a compressed sparse row (CSR) adjacency array with dense integer vertex IDs.  Edge
+ * weights are the metrics of the faces at the time of the snapshot.
+ *
+ * CalculatePaths does not touch ns-3 objects and can be called from several threads at once,
+ * which GlobalRoutingHelper uses to compute shortest path trees of different sources in
+ * parallel (see RunParallel).
+ *
+ * Path lengths are defined as in boost-graph-ndn-global-routing-helper.hpp: an edge weight is
+ * the metric of the face the edge leaves through (zero for edges leaving a multi-access
+ * channel), and a destination whose distance reaches INF_DISTANCE is unreachable.
+ */
+class GlobalRoutingEngine : boost::noncopyable {
+public:
+  typedef uint32_t VertexId;
+  typedef uint32_t EdgeId;
+
+  /**
+   * @brief Shortest path from a source to one vertex
+   */
+  struct Path {
+    EdgeId firstEdge; ///< first edge that leaves through a face, NO_EDGE if unreachable
+    uint32_t distance;
+  };
+
+  /**
+   * @brief Build a snapshot of GlobalRouter graph of all nodes and channels
+   */
+  GlobalRoutingEngine();
+
+  size_t
+  GetNVertices() const
+  {
+    return m_vertices.size();
+  }
+
+  Ptr<GlobalRouter>
+  GetVertex(VertexId vertex) const
+  {
+    return m_vertices[vertex];
+  }
+
+  /**
+   * @brief Get ID of @p router, or NO_VERTEX if it was not part of the snapshot
+   */
+  VertexId
+  GetVertexId(Ptr<GlobalRouter> router) const;
+
+  /**
+   * @brief Get range [begin, end) of IDs of edges leaving @p vertex
+   */
+  std::pair<EdgeId, EdgeId>
+  GetOutEdges(VertexId vertex) const
+  {
+    return std::make_pair(m_offsets[vertex], m_offsets[vertex + 1]);
+  }
+
+  VertexId
+  GetSource(EdgeId edge) const
+  {
+    return m_sources[edge];
+  }
+
+  VertexId
+  GetTarget(EdgeId edge) const
+  {
+    return m_targets[edge];
+  }
+
+  /**
+   * @brief Get face through which @p edge leaves its source, nullptr for channel edges and
+   *        edges of nodes without NDN stack (simulated by another MPI rank)
+   */
+  const shared_ptr<Face>&
+  GetFace(EdgeId edge) const
+  {
+    return m_faces[edge];
+  }
+
+  uint16_t
+  GetWeight(EdgeId edge) const
+  {
+    return m_weights[edge];
+  }
+
+  /**
+   * @brief Get weight of @p edge when it is up: metric of its face, or metric of the
+   *        incidency if the edge has no face
+   */
+  uint16_t
+  GetMetric(EdgeId edge) const
+  {
+    return m_faces[edge] != nullptr ? static_cast<uint16_t>(m_faces[edge]->getMetric())
+                                    : m_metrics[edge];
+  }
+
+  /**
+   * @brief Change weight of @p edge, e.g., DOWN_WEIGHT when the link fails
+   */
+  void
+  SetWeight(EdgeId edge, uint16_t weight)
+  {
+    m_weights[edge] = weight;
+  }
+
+  /**
+   * @brief Find edges leaving @p from towards @p to
+   */
+  std::vector<EdgeId>
+  FindEdges(VertexId from, VertexId to) const;
+
+  /**
+   * @brief Calculate shortest paths from @p source to all vertices
+   *
+   * @param source     ID of the source vertex
+   * @param onlyFace   if not nullptr, edges that leave @p source through another face get
+   *                   DISABLED_WEIGHT, so that they can only be used to reach direct neighbors
+   * @param[out] paths shortest path to every vertex, indexed by VertexId
+   *
+   * Thread-safe with respect to other calls of CalculatePaths.
+   */
+  void
+  CalculatePaths(VertexId source, const Face* onlyFace, std::vector<Path>& paths) const;
+
+  /**
+   * @brief Calculate shortest path distances from all vertices to @p target
+   *
+   * @param target         ID of the destination vertex
+   * @param[out] distances distance from every vertex to @p target, indexed by VertexId;
+   *                       INF_DISTANCE if @p target is unreachable
+   *
+   * Thread-safe with respect to other calls of CalculatePaths and CalculateDistancesTo.
+   */
+  void
+  CalculateDistancesTo(VertexId target, std::vector<uint32_t>& distances) const;
+
+  /**
+   * @brief Invoke @p task for every index in [0, nTasks) using up to @p nThreads threads
+   *
+   * Tasks are handed out dynamically one index at a time.  If @p nThreads is 0, the number of
+   * hardware threads is used.  The calling thread takes part in the work and the function
+   * returns after all tasks are finished.
+   */
+  static void
+  RunParallel(size_t nTasks, size_t nThreads, const std::function<void(size_t)>& task);
+
+public:
+  static const VertexId NO_VERTEX;
+  static const EdgeId NO_EDGE;
+
+  /// distance that is considered unreachable
+  static const uint32_t INF_DISTANCE;
+
+  /// weight of faces disabled with onlyFace parameter of CalculatePaths
+  static const uint16_t DISABLED_WEIGHT;
+
+  /// weight of edges that cannot be part of any path
+  static const uint16_t DOWN_WEIGHT;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_vertices;
+  std::unordered_map<const GlobalRouter*, VertexId> m_ids;
+
+  // CSR adjacency: edges of vertex v are [m_offsets[v], m_offsets[v + 1])
+  std::vector<EdgeId> m_offsets;
+  std::vector<VertexId> m_sources;
+  std::vector<VertexId> m_targets;
+  std::vector<uint16_t> m_weights;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::vector<uint16_t> m_metrics; ///< metrics of incidencies without face
+
+  // reverse CSR adjacency: edges entering v are m_inEdges[m_inOffsets[v], m_inOffsets[v + 1])
+  std::vector<EdgeId> m_inOffsets;
+  std::vector<EdgeId> m_inEdges;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_ENGINE_H
@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-engine.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,23 +47,22 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
-#include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
+#include <algorithm>
+#include <map>
+#include <numeric>
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+size_t GlobalRoutingHelper::m_nThreads = 0;
+bool GlobalRoutingHelper::m_isIncremental = false;
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -215,174 +215,292 @@ GlobalRoutingHelper::AddOriginsForAll()
 }
 
 void
-GlobalRoutingHelper::CalculateRoutes()
+GlobalRoutingHelper::SetThreads(size_t nThreads)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  m_nThreads = nThreads;
+}
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+namespace {
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+typedef GlobalRoutingEngine::VertexId VertexId;
+typedef GlobalRoutingEngine::EdgeId EdgeId;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
+/**
+ * @brief Shortest paths from one source to origins that have routes installed
+ */
+typedef std::vector<std::pair<VertexId, GlobalRoutingEngine::Path>> OriginPaths;
+
+/**
+ * @brief Routing state kept between CalculateRoutes and UpdateLink
+ */
+struct RoutingState {
+  GlobalRoutingEngine engine;
+  std::vector<Ptr<Node>> nodes;
+  std::vector<VertexId> sources;
+  std::vector<VertexId> origins;
+  std::vector<OriginPaths> installed; ///< indexed as nodes and sources
+};
+
+std::unique_ptr<RoutingState> s_routingState;
+
+void
+clearRoutingState()
+{
+  s_routingState.reset();
+}
+
+} // namespace
+
+void
+GlobalRoutingHelper::SetIncrementalUpdates(bool isEnabled)
+{
+  m_isIncremental = isEnabled;
+  if (!m_isIncremental) {
+    clearRoutingState();
+  }
+}
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
+/**
+ * @brief Calculate shortest paths to origins from sources with given indices
+ *
+ * Shortest path trees of different sources are independent, so they are computed in parallel.
+ */
+static std::vector<OriginPaths>
+calculateOriginPaths(const RoutingState& state,
+                     const std::vector<size_t>& sourceIndices, bool isAllPossible,
+                     size_t nThreads)
+{
+  const GlobalRoutingEngine& engine = state.engine;
+  std::vector<OriginPaths> results(sourceIndices.size());
+
+  GlobalRoutingEngine::RunParallel(sourceIndices.size(), nThreads, [&] (size_t i) {
+    VertexId source = state.sources[sourceIndices[i]];
+    std::vector<GlobalRoutingEngine::Path> paths;
+
+    if (!isAllPossible) {
+      engine.CalculatePaths(source, nullptr, paths);
+      for (VertexId origin : state.origins) {
+        if (origin != source && paths[origin].firstEdge != GlobalRoutingEngine::NO_EDGE) {
+          results[i].push_back(std::make_pair(origin, paths[origin]));
         }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
+      }
+      return;
+    }
+
+    // enable one face at a time, other faces can only be used to reach direct neighbors
+    std::vector<const Face*> faces;
+    for (EdgeId edge = engine.GetOutEdges(source).first; edge < engine.GetOutEdges(source).second;
+         ++edge) {
+      const Face* face = engine.GetFace(edge).get();
+      if (face != nullptr && std::find(faces.begin(), faces.end(), face) == faces.end()) {
+        faces.push_back(face);
+      }
+    }
+
+    for (const Face* face : faces) {
+      engine.CalculatePaths(source, face, paths);
+      for (VertexId origin : state.origins) {
+        EdgeId firstEdge = paths[origin].firstEdge;
+        if (origin != source && firstEdge != GlobalRoutingEngine::NO_EDGE
+            && engine.GetFace(firstEdge).get() == face
+            && engine.GetWeight(firstEdge) != GlobalRoutingEngine::DISABLED_WEIGHT) {
+          results[i].push_back(std::make_pair(origin, paths[origin]));
         }
       }
     }
-  }
+  });
+
+  return results;
 }
 
-void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+static std::vector<FibHelper::Route>
+makeRoutes(const RoutingState& state, const OriginPaths& paths)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  std::vector<FibHelper::Route> routes;
+  for (const auto& path : paths) {
+    const shared_ptr<Face>& face = state.engine.GetFace(path.second.firstEdge);
+    for (const auto& prefix : state.engine.GetVertex(path.first)->GetLocalPrefixes()) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                   << " with distance " << path.second.distance);
+
+      routes.push_back({*prefix, face, static_cast<int32_t>(path.second.distance)});
+    }
+  }
+  return routes;
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+/**
+ * @brief Calculate routes from every node to all origins and install them into FIBs
+ */
+static std::unique_ptr<RoutingState>
+installShortestPaths(bool isAllPossible, size_t nThreads)
+{
+  std::unique_ptr<RoutingState> state(new RoutingState);
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    if (source->GetL3Protocol() == 0) {
+      // e.g., node simulated by another MPI rank, which is only a vertex of the graph
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not have NDN stack");
+      continue;
+    }
+    state->nodes.push_back(*node);
+    state->sources.push_back(state->engine.GetVertexId(source));
+  }
+
+  for (VertexId vertex = 0; vertex < state->engine.GetNVertices(); ++vertex) {
+    if (!state->engine.GetVertex(vertex)->GetLocalPrefixes().empty()) {
+      state->origins.push_back(vertex);
+    }
+  }
+
+  std::vector<size_t> allSources(state->sources.size());
+  std::iota(allSources.begin(), allSources.end(), 0);
+  state->installed = calculateOriginPaths(*state, allSources, isAllPossible, nThreads);
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+  for (size_t i = 0; i < state->nodes.size(); ++i) {
+    NS_LOG_DEBUG("Reachability from Node: " << state->nodes[i]->GetId() << " ("
+                                            << Names::FindName(state->nodes[i]) << ")");
+    FibHelper::AddRoutes(state->nodes[i], makeRoutes(*state, state->installed[i]));
+  }
+
+  return state;
+}
+
+void
+GlobalRoutingHelper::CalculateRoutes()
+{
+  clearRoutingState();
+  std::unique_ptr<RoutingState> state = installShortestPaths(false, m_nThreads);
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+  if (m_isIncremental) {
+    s_routingState = std::move(state);
+    // the state references nodes and faces, which must not outlive the simulation
+    Simulator::ScheduleDestroy(&clearRoutingState);
+  }
+}
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  clearRoutingState();
+  installShortestPaths(true, m_nThreads);
+}
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+void
+GlobalRoutingHelper::UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
+{
+  if (s_routingState == nullptr) {
+    NS_LOG_DEBUG("No routing state for incremental updates");
+    return;
+  }
+
+  RoutingState& state = *s_routingState;
+  GlobalRoutingEngine& engine = state.engine;
+
+  VertexId v1 = engine.GetVertexId(node1->GetObject<GlobalRouter>());
+  VertexId v2 = engine.GetVertexId(node2->GetObject<GlobalRouter>());
+  if (v1 == GlobalRoutingEngine::NO_VERTEX || v2 == GlobalRoutingEngine::NO_VERTEX) {
+    NS_LOG_DEBUG("Link is not part of the routing graph");
+    return;
+  }
+
+  // edges in both directions and their new weights
+  std::vector<std::pair<EdgeId, uint16_t>> changes;
+  std::vector<EdgeId> edges = engine.FindEdges(v1, v2);
+  std::vector<EdgeId> reverseEdges = engine.FindEdges(v2, v1);
+  edges.insert(edges.end(), reverseEdges.begin(), reverseEdges.end());
+  if (edges.empty()) {
+    // nodes on a multi-access channel are only connected to the channel vertex, whose edges
+    // are shared with all other nodes on the channel
+    NS_LOG_WARN("No direct link between nodes " << node1->GetId() << " and " << node2->GetId()
+                << ", routes are not updated");
+    return;
+  }
+  for (EdgeId edge : edges) {
+    uint16_t weight = isUp ? engine.GetMetric(edge) : GlobalRoutingEngine::DOWN_WEIGHT;
+    if (weight != engine.GetWeight(edge)) {
+      changes.push_back(std::make_pair(edge, weight));
     }
+  }
+  if (changes.empty()) {
+    return;
+  }
 
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-        continue;
+  // A source is affected if its current shortest path tree may contain a changed edge, or if
+  // a changed edge shortens a path from it.  Both are determined from distances of all
+  // vertices to the ends of the link, calculated before the change.
+  std::vector<uint32_t> distancesTo1;
+  std::vector<uint32_t> distancesTo2;
+  engine.CalculateDistancesTo(v1, distancesTo1);
+  engine.CalculateDistancesTo(v2, distancesTo2);
+
+  std::vector<size_t> affected;
+  for (size_t i = 0; i < state.sources.size(); ++i) {
+    VertexId source = state.sources[i];
+    for (const auto& change : changes) {
+      bool isForward = engine.GetSource(change.first) == v1;
+      uint32_t fromDistance = isForward ? distancesTo1[source] : distancesTo2[source];
+      uint32_t toDistance = isForward ? distancesTo2[source] : distancesTo1[source];
+
+      if ((toDistance < GlobalRoutingEngine::INF_DISTANCE
+           && fromDistance + engine.GetWeight(change.first) == toDistance)
+          || fromDistance + change.second < toDistance) {
+        affected.push_back(i);
+        break;
       }
+    }
+  }
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+  for (const auto& change : changes) {
+    engine.SetWeight(change.first, change.second);
+  }
 
-      boost::DistancesMap distances;
+  NS_LOG_DEBUG("Link " << node1->GetId() << " - " << node2->GetId() << (isUp ? " up" : " down")
+               << ", recalculating routes of " << affected.size() << " nodes");
 
-      NS_LOG_DEBUG("-----------");
+  std::vector<OriginPaths> results = calculateOriginPaths(state, affected, false, m_nThreads);
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+  typedef std::map<std::pair<Name, const Face*>, FibHelper::Route> RouteMap;
+  auto makeRouteMap = [&state] (const OriginPaths& paths) {
+    RouteMap routeMap;
+    for (const auto& route : makeRoutes(state, paths)) {
+      // same as AddRoutes, the last route for the same prefix and face determines the cost
+      routeMap[std::make_pair(route.prefix, route.face.get())] = route;
+    }
+    return routeMap;
+  };
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  for (size_t i = 0; i < affected.size(); ++i) {
+    size_t index = affected[i];
+    NS_LOG_DEBUG("Reachability from Node: " << state.nodes[index]->GetId() << " ("
+                                            << Names::FindName(state.nodes[index]) << ")");
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
-      }
+    RouteMap oldRoutes = makeRouteMap(state.installed[index]);
+    RouteMap newRoutes = makeRouteMap(results[i]);
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+    std::vector<FibHelper::Route> removed;
+    for (const auto& route : oldRoutes) {
+      if (newRoutes.count(route.first) == 0) {
+        removed.push_back(route.second);
+      }
     }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+    std::vector<FibHelper::Route> added;
+    for (const auto& route : newRoutes) {
+      auto oldRoute = oldRoutes.find(route.first);
+      if (oldRoute == oldRoutes.end() || oldRoute->second.metric != route.second.metric) {
+        added.push_back(route.second);
+      }
     }
+
+    FibHelper::RemoveRoutes(state.nodes[index], removed);
+    FibHelper::AddRoutes(state.nodes[index], added);
+    state.installed[index] = std::move(results[i]);
   }
 }
 
@@ -111,9 +111,55 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set number of threads used to calculate shortest path trees
+   *
+   * Routes are always installed into FIBs from the calling thread.
+   *
+   * @param nThreads number of threads, 0 (default) to use all hardware threads
+   */
+  static void
+  SetThreads(size_t nThreads);
+
+  /**
+   * @brief Enable or disable incremental route updates
+   *
+   * When enabled, CalculateRoutes keeps its shortest path results, so that UpdateLink can
+   * recalculate only the routes affected by a link status change.  The kept state is released
+   * when incremental updates are disabled or the simulator is destroyed.
+   */
+  static void
+  SetIncrementalUpdates(bool isEnabled);
+
+  /**
+   * @brief Update routes after the link between two nodes went down or came back up
+   *
+   * Only nodes whose shortest path trees may change are recalculated, and only the FIB
+   * entries that differ from the previous result are modified.  The link weight in the up state
+   * is the current metric of its faces.
+   *
+   * Does nothing unless routes have been calculated with CalculateRoutes while incremental
+   * updates were enabled.  LinkControlHelper::FailLink and LinkControlHelper::UpLink call this
+   * method automatically.
+   *
+   * Only direct (e.g., point-to-point) links are supported.  Nodes attached to a multi-access
+   * channel are connected through the channel vertex rather than to each other, so a change
+   * between two such nodes is ignored with a warning; call CalculateRoutes again instead.
+   *
+   * @param node1 one node of the link
+   * @param node2 another node of the link
+   * @param isUp  whether the link is up after the change
+   */
+  static void
+  UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp);
+
 private:
   void
   Install(Ptr<Channel> channel);
+
+private:
+  static size_t m_nThreads;
+  static bool m_isIncremental;
 };
 
 } // namespace ndn
@@ -32,6 +32,7 @@
 #include "ns3/pointer.h"
 
 #include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "NFD/daemon/face/face.hpp"
 
@@ -95,6 +96,7 @@ void
 LinkControlHelper::FailLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, 1.0);
+  GlobalRoutingHelper::UpdateLink(node1, node2, false);
 }
 
 void
@@ -107,6 +109,7 @@ void
 LinkControlHelper::UpLink(Ptr<Node> node1, Ptr<Node> node2)
 {
   setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
+  GlobalRoutingHelper::UpdateLink(node1, node2, true);
 }
 
 void
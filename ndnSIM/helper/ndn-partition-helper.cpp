@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-partition-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+#include "helper/ndn-global-routing-helper.hpp"
+#include "model/ndn-global-router.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+uint32_t
+PartitionHelper::GetNPartitions()
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return MpiInterface::GetSize();
+  }
+#endif
+  return 1;
+}
+
+bool
+PartitionHelper::IsLocal(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+  }
+#endif
+  return true;
+}
+
+NodeContainer
+PartitionHelper::GetLocalNodes(const NodeContainer& nodes)
+{
+  NodeContainer localNodes;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    if (IsLocal(*node)) {
+      localNodes.Add(*node);
+    }
+  }
+  return localNodes;
+}
+
+NodeContainer
+PartitionHelper::GetLocalNodes()
+{
+  return GetLocalNodes(NodeContainer::GetGlobal());
+}
+
+void
+PartitionHelper::InstallGlobalRouting(AnnotatedTopologyReader& topology)
+{
+  topology.ApplyOspfMetric();
+
+  // remote nodes get face-less GlobalRouter first, so that GlobalRoutingHelper does not try
+  // to install the regular one, which requires NDN stack
+  NodeContainer nodes = topology.GetNodes();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    if (!IsLocal(*node) && (*node)->GetObject<GlobalRouter>() == 0) {
+      (*node)->AggregateObject(CreateObject<GlobalRouter>());
+    }
+  }
+
+  NodeContainer localNodes = GetLocalNodes(nodes);
+  GlobalRoutingHelper().Install(localNodes);
+  NS_LOG_DEBUG(localNodes.GetN() << " local nodes of " << nodes.GetN());
+
+  for (const auto& link : topology.GetLinks()) {
+    uint16_t metric = boost::lexical_cast<uint16_t>(link.GetAttribute("OSPF"));
+    Ptr<GlobalRouter> from = link.GetFromNode()->GetObject<GlobalRouter>();
+    Ptr<GlobalRouter> to = link.GetToNode()->GetObject<GlobalRouter>();
+
+    if (!IsLocal(link.GetFromNode())) {
+      from->AddIncidency(nullptr, to, metric);
+    }
+    if (!IsLocal(link.GetToNode())) {
+      to->AddIncidency(nullptr, from, metric);
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
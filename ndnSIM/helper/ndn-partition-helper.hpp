@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+class AnnotatedTopologyReader;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper for distributed (MPI) simulations of topologies partitioned across ranks
+ *
+ * Every rank reads the whole topology, partitioned automatically by
+ * AnnotatedTopologyReader::SetPartitions(), but only simulates its local nodes: the NDN stack
+ * and applications are installed only on them, while remote nodes remain plain ns-3 nodes that
+ * forward packets over remote point-to-point links.
+ *
+ *     AnnotatedTopologyReader topologyReader;
+ *     topologyReader.SetFileName("topology.txt");
+ *     topologyReader.SetPartitions(ndn::PartitionHelper::GetNPartitions());
+ *     topologyReader.Read();
+ *
+ *     ndn::StackHelper ndnHelper;
+ *     ndnHelper.Install(ndn::PartitionHelper::GetLocalNodes());
+ *
+ *     ndn::PartitionHelper::InstallGlobalRouting(topologyReader);
+ *
+ * When MPI is not enabled, all nodes are local.
+ */
+class PartitionHelper {
+public:
+  /**
+   * @brief Get number of partitions, i.e., MPI ranks (1 if MPI is not enabled)
+   */
+  static uint32_t
+  GetNPartitions();
+
+  /**
+   * @brief Check whether @p node is simulated by this rank
+   */
+  static bool
+  IsLocal(Ptr<Node> node);
+
+  /**
+   * @brief Get nodes of @p nodes that are simulated by this rank
+   */
+  static NodeContainer
+  GetLocalNodes(const NodeContainer& nodes);
+
+  /**
+   * @brief Get all nodes that are simulated by this rank
+   */
+  static NodeContainer
+  GetLocalNodes();
+
+  /**
+   * @brief Install GlobalRouter interface on all nodes of @p topology
+   *
+   * Local nodes, which must have the NDN stack installed, get the regular GlobalRouter
+   * interface.  Remote nodes, which have no NDN stack on this rank, get GlobalRouter
+   * interface without faces, with edges weighted by OSPF metrics of the topology links.  To
+   * use the same weights on all ranks, faces of local nodes are set to the OSPF metrics as
+   * well (see AnnotatedTopologyReader::ApplyOspfMetric).
+   *
+   * Origins should then be added for local and remote producers on every rank, and
+   * GlobalRoutingHelper::CalculateRoutes() installs routes into FIBs of local nodes.  As all
+   * ranks compute shortest paths on the same graph, routes are consistent across ranks.
+   */
+  static void
+  InstallGlobalRouting(AnnotatedTopologyReader& topology);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARTITION_HELPER_H
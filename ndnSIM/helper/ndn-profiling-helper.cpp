@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-profiling-helper.hpp"
+
+#include "utils/ndn-profiler.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/names.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "utils/mem-usage.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ProfilingHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct ProfilingState {
+  shared_ptr<std::ostream> os;
+  Time period;
+  size_t topN;
+  EventId event;
+
+  Clock::time_point startWallTime;
+  Clock::time_point lastWallTime;
+  Time lastTime;
+};
+
+std::unique_ptr<ProfilingState> s_state;
+
+std::string
+getNodeName(uint32_t id)
+{
+  if (id < NodeList::GetNNodes()) {
+    std::string name = Names::FindName(NodeList::GetNode(id));
+    if (!name.empty()) {
+      return name;
+    }
+  }
+  return std::to_string(id);
+}
+
+void
+printLine(std::ostream& os, double time, double wallTime, double speed, double rss,
+          const std::string& type, const std::string& name, uint64_t count, double seconds,
+          double periodWallTime)
+{
+  os << time << "\t" << wallTime << "\t" << speed << "\t" << rss << "\t" << type << "\t" << name
+     << "\t" << count << "\t" << (periodWallTime > 0 ? count / periodWallTime : 0) << "\t"
+     << seconds << "\n";
+}
+
+void
+report()
+{
+  ProfilingState& state = *s_state;
+
+  Clock::time_point now = Clock::now();
+  double periodWallTime = std::chrono::duration<double>(now - state.lastWallTime).count();
+  double wallTime = std::chrono::duration<double>(now - state.startWallTime).count();
+  double periodTime = (Simulator::Now() - state.lastTime).ToDouble(Time::S);
+  double speed = periodWallTime > 0 ? periodTime / periodWallTime : 0;
+  double rss = MemUsage::Get() / 1024.0 / 1024.0;
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  const auto& counters = profiler::GetCounters();
+
+  profiler::NodeCounters categories;
+  std::vector<std::pair<int64_t, uint32_t>> nodes; // (time, node ID)
+  uint64_t totalCount = 0;
+  for (uint32_t id = 0; id < counters.size(); ++id) {
+    int64_t nodeTime = 0;
+    for (size_t category = 0; category < profiler::N_CATEGORIES; ++category) {
+      categories[category].count += counters[id][category].count;
+      categories[category].nanoseconds += counters[id][category].nanoseconds;
+      totalCount += counters[id][category].count;
+      nodeTime += counters[id][category].nanoseconds;
+    }
+    if (nodeTime > 0) {
+      nodes.push_back(std::make_pair(nodeTime, id));
+    }
+  }
+
+  std::ostream& os = *state.os;
+  printLine(os, time, wallTime, speed, rss, "Total", "all", totalCount, periodWallTime,
+            periodWallTime);
+
+  std::vector<size_t> order;
+  for (size_t category = 0; category < profiler::N_CATEGORIES; ++category) {
+    if (categories[category].count > 0) {
+      order.push_back(category);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&categories] (size_t a, size_t b) {
+      return categories[a].nanoseconds > categories[b].nanoseconds;
+    });
+  for (size_t i = 0; i < order.size() && i < state.topN; ++i) {
+    const profiler::Counter& counter = categories[order[i]];
+    printLine(os, time, wallTime, speed, rss, "Category",
+              profiler::GetCategoryName(static_cast<profiler::Category>(order[i])),
+              counter.count, counter.nanoseconds / 1e9, periodWallTime);
+  }
+
+  size_t nTop = std::min(nodes.size(), state.topN);
+  std::partial_sort(nodes.begin(), nodes.begin() + nTop, nodes.end(),
+                    std::greater<std::pair<int64_t, uint32_t>>());
+  for (size_t i = 0; i < nTop; ++i) {
+    uint32_t id = nodes[i].second;
+    uint64_t count = 0;
+    for (const auto& counter : counters[id]) {
+      count += counter.count;
+    }
+    printLine(os, time, wallTime, speed, rss, "Node", getNodeName(id), count,
+              nodes[i].first / 1e9, periodWallTime);
+  }
+  os.flush();
+
+  profiler::Reset();
+  state.lastWallTime = Clock::now();
+  state.lastTime = Simulator::Now();
+  state.event = Simulator::Schedule(state.period, &report);
+}
+
+} // namespace
+
+void
+ProfilingHelper::Install(const std::string& file, Time period/* = Seconds(1.0)*/,
+                         size_t topN/* = 5*/)
+{
+  Destroy();
+
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, TraceFormat::TSV);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Profiling disabled");
+    return;
+  }
+
+  if (!IsInstrumentationEnabled()) {
+    NS_LOG_WARN("ndnSIM is configured without --enable-ndnsim-profiling, "
+                "only simulation speed and memory usage will be reported");
+  }
+
+  *outputStream << "Time\tWallTime\tSimPerWallS\tRssMB\tType\tName\tEvents\tEventsPerWallS"
+                << "\tWallS\n";
+
+  s_state.reset(new ProfilingState);
+  s_state->os = outputStream;
+  s_state->period = period;
+  s_state->topN = topN;
+  s_state->startWallTime = s_state->lastWallTime = Clock::now();
+  s_state->lastTime = Simulator::Now();
+  s_state->event = Simulator::Schedule(period, &report);
+
+  profiler::Reset();
+  Simulator::ScheduleDestroy(&ProfilingHelper::Destroy);
+}
+
+void
+ProfilingHelper::Destroy()
+{
+  if (s_state != nullptr) {
+    s_state->event.Cancel();
+    s_state.reset();
+  }
+}
+
+bool
+ProfilingHelper::IsInstrumentationEnabled()
+{
+#ifdef NDNSIM_PROFILING
+  return true;
+#else
+  return false;
+#endif // NDNSIM_PROFILING
+}
+
+} // namespace ndn
+} // namespace ns3
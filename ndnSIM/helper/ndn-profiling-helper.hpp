@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PROFILING_HELPER_H
+#define NDN_PROFILING_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to periodically report the simulation speed and where the wall-clock time goes
+ *
+ * Every period, the helper writes a tab-separated summary line with the simulated seconds per
+ * wall-clock second and the resident memory of the process.  When ndnSIM is configured with
+ * --enable-ndnsim-profiling, the helper also writes the number of events and the wall-clock time
+ * of each profiled category (see NDNSIM_PROFILE_SCOPE) and of the top-N busiest nodes.
+ * Otherwise, the instrumentation is compiled out and costs nothing.
+ */
+class ProfilingHelper {
+public:
+  /**
+   * @brief Start periodic profiling reports
+   *
+   * @param file File to which reports will be written.  If filename is -, then std::out is used
+   * @param period How often reports will be written (simulation time)
+   * @param topN Maximum number of categories and nodes reported every period
+   */
+  static void
+  Install(const std::string& file, Time period = Seconds(1.0), size_t topN = 5);
+
+  /**
+   * @brief Stop reports and close the report file
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Check whether the per-category instrumentation is compiled in
+   */
+  static bool
+  IsInstrumentationEnabled();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PROFILING_HELPER_H
@@ -34,10 +34,17 @@
 #include <limits>
 #include <map>
 #include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
 
+#include "ns3/ndnSIM/NFD/core/context-local.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-priority-fifo.hpp"
 #include "ns3/ndnSIM/NFD/daemon/table/cs-policy-lru.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-gdsf.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-arc.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-slru.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-s3fifo.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy-tinylfu.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.StackHelper");
 
@@ -51,11 +58,23 @@ StackHelper::StackHelper()
   , m_isStrategyChoiceManagerDisabled(false)
   , m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_maxCsBytes(0)
+  , m_maxCsDataSize(0)
+  , m_isCsHashIndexEnabled(false)
+  , m_isFibTrieIndexEnabled(false)
+  , m_dnlFilterCapacity(0)
+  , m_dnlFilterFpRate(0.0001)
 {
   setCustomNdnCxxClocks();
 
   m_csPolicies.insert({"nfd::cs::lru", [] { return make_unique<nfd::cs::LruPolicy>(); }});
   m_csPolicies.insert({"nfd::cs::priority_fifo", [] () { return make_unique<nfd::cs::PriorityFifoPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::gdsf", [] { return make_unique<nfd::cs::GdsfPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::gds", [] { return make_unique<nfd::cs::GdsPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::arc", [] { return make_unique<nfd::cs::ArcPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::slru", [] { return make_unique<nfd::cs::SlruPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::s3fifo", [] { return make_unique<nfd::cs::S3FifoPolicy>(); }});
+  m_csPolicies.insert({"nfd::cs::tinylfu", [] { return make_unique<nfd::cs::TinyLfuPolicy>(); }});
 
   m_csPolicyCreationFunc = m_csPolicies["nfd::cs::lru"];
 
@@ -75,8 +94,12 @@ StackHelper::~StackHelper()
 KeyChain&
 StackHelper::getKeyChain()
 {
-  static ::ndn::KeyChain keyChain("pib-dummy", "tpm-dummy");
-  return keyChain;
+  // KeyChain keeps the timestamp of the last signed command Interest, so every node has its
+  // own instance; management dispatchers keep the instance of the context that created them
+  static nfd::ContextLocal<KeyChain> keyChains([] (uint32_t) {
+      return new KeyChain("pib-dummy", "tpm-dummy");
+    });
+  return keyChains.get();
 }
 
 void
@@ -135,6 +158,43 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setCsByteLimit(size_t maxBytes)
+{
+  m_maxCsBytes = maxBytes;
+}
+
+void
+StackHelper::setCsMaxDataSize(size_t maxDataSize)
+{
+  m_maxCsDataSize = maxDataSize;
+}
+
+void
+StackHelper::addCsNoCachePrefix(const Name& prefix)
+{
+  m_csNoCachePrefixes.push_back(prefix);
+}
+
+void
+StackHelper::setCsHashIndex(bool isEnabled)
+{
+  m_isCsHashIndexEnabled = isEnabled;
+}
+
+void
+StackHelper::setFibTrieIndex(bool isEnabled)
+{
+  m_isFibTrieIndexEnabled = isEnabled;
+}
+
+void
+StackHelper::setDeadNonceListFilter(size_t capacity, double falsePositiveRate)
+{
+  m_dnlFilterCapacity = capacity;
+  m_dnlFilterFpRate = falsePositiveRate;
+}
+
 void
 StackHelper::setPolicy(const std::string& policy)
 {
@@ -198,6 +258,36 @@ StackHelper::Install(Ptr<Node> node) const
 
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
 
+  if (m_maxCsBytes > 0) {
+    ndn->getConfig().put("tables.cs_max_bytes", m_maxCsBytes);
+  }
+
+  if (m_maxCsDataSize > 0) {
+    ndn->getConfig().put("tables.cs_max_data_size", m_maxCsDataSize);
+  }
+
+  if (!m_csNoCachePrefixes.empty()) {
+    // prefixes are added as keys directly, because they may contain the '.' path separator
+    boost::property_tree::ptree noCache;
+    for (const Name& prefix : m_csNoCachePrefixes) {
+      noCache.push_back(std::make_pair(prefix.toUri(), boost::property_tree::ptree()));
+    }
+    ndn->getConfig().put_child("tables.cs_no_cache", noCache);
+  }
+
+  if (m_isCsHashIndexEnabled) {
+    ndn->getConfig().put("tables.cs_hash_index", "yes");
+  }
+
+  if (m_isFibTrieIndexEnabled) {
+    ndn->getConfig().put("tables.fib_trie_index", "yes");
+  }
+
+  if (m_dnlFilterCapacity > 0) {
+    ndn->getConfig().put("tables.dnl_filter_capacity", m_dnlFilterCapacity);
+    ndn->getConfig().put("tables.dnl_filter_fp_rate", m_dnlFilterFpRate);
+  }
+
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
     ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
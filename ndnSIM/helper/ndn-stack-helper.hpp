@@ -80,12 +80,74 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Set maximum size for NFD's Content Store (in bytes of stored Data packets)
+   * @param maxBytes the limit, or 0 to only limit the number of packets (default)
+   *
+   * The byte limit applies in addition to the limit set with setCsSize(), and makes the memory
+   * used by the Content Store predictable when Data packets vary in size.
+   */
+  void
+  setCsByteLimit(size_t maxBytes);
+
+  /**
+   * @brief Do not cache Data packets larger than @p maxDataSize bytes in NFD's Content Store
+   * @param maxDataSize the maximum size, or 0 to cache Data packets of any size (default)
+   */
+  void
+  setCsMaxDataSize(size_t maxDataSize);
+
+  /**
+   * @brief Do not cache Data packets under @p prefix in NFD's Content Store
+   *
+   * This saves Content Store capacity for prefixes whose Data is never requested again,
+   * e.g., tunneled traffic.
+   */
+  void
+  addCsNoCachePrefix(const Name& prefix);
+
   /**
    * @brief Set the cache replacement policy for NFD's Content Store
+   *
+   * Available policies are "nfd::cs::lru" (default), "nfd::cs::priority_fifo",
+   * the size-aware "nfd::cs::gdsf" (GreedyDual-Size-Frequency) and "nfd::cs::gds"
+   * (GreedyDual-Size, a size-adjusted LRU), and the scan-resistant "nfd::cs::arc"
+   * (Adaptive Replacement Cache), "nfd::cs::slru" (Segmented LRU), "nfd::cs::s3fifo",
+   * and "nfd::cs::tinylfu" (TinyLFU admission over LRU).
    */
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Enable or disable the hash index of NFD's content store
+   *
+   * The index answers inserts and lookups without selectors without walking the name-ordered
+   * index, which speeds up large content stores (e.g., hundreds of thousands of packets).
+   */
+  void
+  setCsHashIndex(bool isEnabled);
+
+  /**
+   * @brief Enable or disable the compressed trie index of NFD's FIB
+   *
+   * The index speeds up longest prefix match by name in large FIBs, e.g., those installed by
+   * GlobalRoutingHelper, at the cost of additional memory per FIB entry.
+   */
+  void
+  setFibTrieIndex(bool isEnabled);
+
+  /**
+   * @brief Store NFD's Dead Nonce List in a fixed-size cuckoo filter
+   * @param capacity maximum number of Nonces expected within the Dead Nonce List lifetime;
+   *        0 restores the default list, whose memory grows with the Interest rate
+   * @param falsePositiveRate probability that a non-looping Interest is considered looping
+   *
+   * The filter's memory is allocated once per node and depends only on the parameters, which
+   * keeps per-node memory predictable in simulations with many nodes.
+   */
+  void
+  setDeadNonceListFilter(size_t capacity, double falsePositiveRate = 0.0001);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -190,6 +252,13 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Get KeyChain of the current simulator context (node)
+   *
+   * The KeyChain uses dummy PIB and TPM, which produce the same signature for every packet.
+   * Every node has its own KeyChain, so that nodes simulated concurrently do not share the
+   * state of signed command Interests.
+   */
   static KeyChain&
   getKeyChain();
 
@@ -273,6 +342,13 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  size_t m_maxCsBytes;
+  size_t m_maxCsDataSize;
+  std::vector<Name> m_csNoCachePrefixes;
+  bool m_isCsHashIndexEnabled;
+  bool m_isFibTrieIndexEnabled;
+  size_t m_dnlFilterCapacity;
+  double m_dnlFilterFpRate;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
@@ -119,8 +119,11 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * The returned Data is the instance held by the content store, not a copy.
+   * A caller that needs to modify it (e.g., to attach different tags) must make its own copy.
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
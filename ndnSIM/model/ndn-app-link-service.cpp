@@ -26,12 +26,34 @@
 #include "ns3/simulator.h"
 
 #include "apps/ndn-app.hpp"
+#include "utils/ndn-profiler.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
 namespace ns3 {
 namespace ndn {
 
+static void
+DeliverInterest(Ptr<App> app, shared_ptr<const Interest> interest)
+{
+  NDNSIM_PROFILE_SCOPE(APP);
+  app->OnInterest(interest);
+}
+
+static void
+DeliverData(Ptr<App> app, shared_ptr<const Data> data)
+{
+  NDNSIM_PROFILE_SCOPE(APP);
+  app->OnData(data);
+}
+
+static void
+DeliverNack(Ptr<App> app, shared_ptr<const lp::Nack> nack)
+{
+  NDNSIM_PROFILE_SCOPE(APP);
+  app->OnNack(nack);
+}
+
 AppLinkService::AppLinkService(Ptr<App> app)
   : m_node(app->GetNode())
   , m_app(app)
@@ -52,7 +74,7 @@ AppLinkService::doSendInterest(const Interest& interest)
   NS_LOG_FUNCTION(this << &interest);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  Simulator::ScheduleNow(&DeliverInterest, m_app, interest.shared_from_this());
 }
 
 void
@@ -61,7 +83,7 @@ AppLinkService::doSendData(const Data& data)
   NS_LOG_FUNCTION(this << &data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  Simulator::ScheduleNow(&DeliverData, m_app, data.shared_from_this());
 }
 
 void
@@ -70,7 +92,7 @@ AppLinkService::doSendNack(const lp::Nack& nack)
   NS_LOG_FUNCTION(this << &nack);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
+  Simulator::ScheduleNow(&DeliverNack, m_app, make_shared<lp::Nack>(nack));
 }
 
 //
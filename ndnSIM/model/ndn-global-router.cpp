@@ -71,9 +71,9 @@ GlobalRouter::AddLocalPrefix(shared_ptr<Name> prefix)
 }
 
 void
-GlobalRouter::AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> gr)
+GlobalRouter::AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> gr, uint16_t metric)
 {
-  m_incidencies.push_back(std::make_tuple(this, face, gr));
+  m_incidencies.push_back(std::make_tuple(this, face, gr, metric));
 }
 
 GlobalRouter::IncidencyList&
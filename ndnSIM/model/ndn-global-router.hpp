@@ -43,9 +43,9 @@ class L3Protocol;
 class GlobalRouter : public Object {
 public:
   /**
-   * @brief Graph edge
+   * @brief Graph edge: source, face, target, and metric of the edge if it has no face
    */
-  typedef std::tuple<Ptr<GlobalRouter>, shared_ptr<Face>, Ptr<GlobalRouter>> Incidency;
+  typedef std::tuple<Ptr<GlobalRouter>, shared_ptr<Face>, Ptr<GlobalRouter>, uint16_t> Incidency;
   /**
    * @brief List of graph edges
    */
@@ -91,9 +91,11 @@ public:
    * @brief Add edge to the node
    * @param face Face of the edge
    * @param ndn GlobalRouter of another node
+   * @param metric routing metric of the edge if @p face is nullptr, e.g., of a link of a node
+   *        simulated by another MPI rank, which has no NDN stack on this rank
    */
   void
-  AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> ndn);
+  AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> ndn, uint16_t metric = 0);
 
   /**
    * @brief Get list of edges that are connected to this node
@@ -132,7 +134,7 @@ inline bool
 operator==(const GlobalRouter::Incidency& a, const GlobalRouter::Incidency& b)
 {
   return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b)
-         && std::get<2>(a) == std::get<2>(b);
+         && std::get<2>(a) == std::get<2>(b) && std::get<3>(a) == std::get<3>(b);
 }
 
 inline bool
@@ -411,7 +411,7 @@ L3Protocol::DoDispose(void)
   // MUST HAPPEN BEFORE Simulator IS DESTROYED
   m_impl.reset();
 
-  nfd::scheduler::getGlobalScheduler().cancelAllEvents();
+  nfd::scheduler::cancelAllEvents();
 
   m_node = 0;
 
@@ -21,6 +21,7 @@
 
 #include "data.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/block-cursor.hpp"
 #include "util/crypto.hpp"
 
 namespace ndn {
@@ -111,7 +112,8 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Data);
 
-  const_cast<Data*>(this)->wireDecode(encoder.block());
+  // a Data is often kept (e.g., in the ContentStore), so it must not pin the pooled buffer
+  const_cast<Data*>(this)->wireDecode(encoder.copyBlock());
   return m_wire;
 }
 
@@ -127,7 +129,7 @@ Data::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
+  const_cast<Data*>(this)->wireDecode(buffer.copyBlock());
   return m_wire;
 }
 
@@ -136,7 +138,6 @@ Data::wireDecode(const Block& wire)
 {
   m_fullName.clear();
   m_wire = wire;
-  m_wire.parse();
 
   // Data ::= DATA-TLV TLV-LENGTH
   //            Name
@@ -144,26 +145,60 @@ Data::wireDecode(const Block& wire)
   //            Content
   //            Signature
 
-  // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
-
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
-
-  // Content
-  m_content = m_wire.get(tlv::Content);
-
-  ///////////////
-  // Signature //
-  ///////////////
-
-  // SignatureInfo
-  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
+  // elements are decoded in place, only the first element of each type is used
+  bool hasName = false;
+  bool hasMetaInfo = false;
+  bool hasSignatureInfo = false;
+  bool hasSignatureValue = false;
+  m_content = Block();
+
+  BlockCursor val(m_wire);
+  while (val.next()) {
+    switch (val.type()) {
+    case tlv::Name:
+      if (!hasName) {
+        m_name.wireDecode(val.block());
+        hasName = true;
+      }
+      break;
+    case tlv::MetaInfo:
+      if (!hasMetaInfo) {
+        m_metaInfo.wireDecode(val.block());
+        hasMetaInfo = true;
+      }
+      break;
+    case tlv::Content:
+      if (m_content.empty())
+        m_content = val.block();
+      break;
+    ///////////////
+    // Signature //
+    ///////////////
+    case tlv::SignatureInfo:
+      if (!hasSignatureInfo) {
+        m_signature.setInfo(val.block());
+        hasSignatureInfo = true;
+      }
+      break;
+    case tlv::SignatureValue:
+      if (!hasSignatureValue) {
+        m_signature.setValue(val.block());
+        hasSignatureValue = true;
+      }
+      break;
+    default:
+      break;
+    }
+  }
 
-  // SignatureValue
-  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
-  if (val != m_wire.elements_end())
-    m_signature.setValue(*val);
+  if (!hasName)
+    BOOST_THROW_EXCEPTION(Error("Name element is missing when decoding Data"));
+  if (!hasMetaInfo)
+    BOOST_THROW_EXCEPTION(Error("MetaInfo element is missing when decoding Data"));
+  if (m_content.empty())
+    BOOST_THROW_EXCEPTION(Error("Content element is missing when decoding Data"));
+  if (!hasSignatureInfo)
+    BOOST_THROW_EXCEPTION(Error("SignatureInfo element is missing when decoding Data"));
 }
 
 Data&
@@ -26,7 +26,8 @@
 #include "../face.hpp"
 
 #include "registered-prefix.hpp"
-#include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "interest-filter-table.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
@@ -51,8 +52,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord>> InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   explicit
@@ -83,8 +82,8 @@ public: // consumer
     this->ensureConnected(true);
 
     auto entry = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      interest, afterSatisfied, afterNacked, afterTimeout, ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+      interest, afterSatisfied, afterNacked, afterTimeout, ref(m_scheduler)));
+    entry->second->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
 
     lp::Packet packet;
 
@@ -107,7 +106,7 @@ public: // consumer
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.erase(pendingInterestId);
   }
 
   void
@@ -119,31 +118,16 @@ public: // consumer
   void
   satisfyPendingInterests(const Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest()->matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-        entry = m_pendingInterestTable.erase(entry);
-        matchedEntry->invokeDataCallback(data);
-      }
-      else {
-        ++entry;
-      }
+    for (const auto& entry : m_pendingInterestTable.extractMatching(data)) {
+      entry->invokeDataCallback(data);
     }
   }
 
   void
   nackPendingInterests(const lp::Nack& nack)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      const Interest& pendingInterest = *(*entry)->getInterest();
-      if (pendingInterest == nack.getInterest()) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-        entry = m_pendingInterestTable.erase(entry);
-        matchedEntry->invokeNackCallback(nack);
-      }
-      else {
-        ++entry;
-      }
+    for (const auto& entry : m_pendingInterestTable.extractMatching(nack)) {
+      entry->invokeNackCallback(nack);
     }
   }
 
@@ -151,27 +135,20 @@ public: // producer
   void
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    m_interestFilterTable.insert(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end()) {
-      m_interestFilterTable.erase(i);
-    }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   void
   processInterestFilters(Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatching(interest.getName())) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -214,7 +191,7 @@ public: // prefix registration
 
     if (registeredPrefix->getFilter() != nullptr) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (onSuccess != nullptr) {
@@ -236,7 +213,7 @@ public: // prefix registration
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.erase(filter);
       }
 
       nfd::ControlParameters params;
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "interest-filter-record.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interest filters organized as a name prefix trie
+ *
+ * Dispatching an Interest visits only the trie nodes along the Interest name, so the cost
+ * depends on the Interest name length and the number of matching filters rather than on the
+ * total number of filters.  Regex filters are checked on the filters found for their prefix.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  typedef std::vector<shared_ptr<InterestFilterRecord>> RecordList;
+
+  InterestFilterTable()
+    : m_lastSeqNo(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  void
+  insert(shared_ptr<InterestFilterRecord> record)
+  {
+    Node* node = &m_root;
+    for (const name::Component& component : record->getFilter().getPrefix()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+
+    node->records.push_back(std::make_pair(++m_lastSeqNo, record));
+    m_records[getId(*record)] = record;
+  }
+
+  /**
+   * @brief Remove the filter identified by @p interestFilterId, if present
+   */
+  void
+  erase(const InterestFilterId* interestFilterId)
+  {
+    auto record = m_records.find(interestFilterId);
+    if (record == m_records.end()) {
+      return;
+    }
+    shared_ptr<InterestFilterRecord> removed = record->second;
+    m_records.erase(record);
+
+    const Name& prefix = removed->getFilter().getPrefix();
+    std::vector<Node*> path{&m_root};
+    for (const name::Component& component : prefix) {
+      path.push_back(path.back()->children.at(component).get());
+    }
+
+    auto& records = path.back()->records;
+    records.erase(std::find_if(records.begin(), records.end(),
+                               [&removed] (const SeqRecord& item) { return item.second == removed; }));
+
+    // prune nodes that no longer lead to any filter
+    for (size_t depth = prefix.size(); depth > 0; --depth) {
+      const Node& node = *path[depth];
+      if (!node.records.empty() || !node.children.empty()) {
+        break;
+      }
+      path[depth - 1]->children.erase(prefix[depth - 1]);
+    }
+  }
+
+  void
+  erase(const shared_ptr<InterestFilterRecord>& record)
+  {
+    this->erase(getId(*record));
+  }
+
+  /**
+   * @brief Find filters that match @p name, in the order of insertion
+   */
+  RecordList
+  findMatching(const Name& name) const
+  {
+    std::vector<SeqRecord> matches;
+    const Node* node = &m_root;
+    for (size_t depth = 0; ; ++depth) {
+      for (const SeqRecord& item : node->records) {
+        if (item.second->doesMatch(name)) {
+          matches.push_back(item);
+        }
+      }
+
+      if (depth == name.size()) {
+        break;
+      }
+      auto child = node->children.find(name[depth]);
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const SeqRecord& a, const SeqRecord& b) { return a.first < b.first; });
+
+    RecordList records;
+    records.reserve(matches.size());
+    for (const SeqRecord& item : matches) {
+      records.push_back(item.second);
+    }
+    return records;
+  }
+
+private:
+  static const InterestFilterId*
+  getId(const InterestFilterRecord& record)
+  {
+    return reinterpret_cast<const InterestFilterId*>(&record);
+  }
+
+private:
+  typedef std::pair<uint64_t, shared_ptr<InterestFilterRecord>> SeqRecord;
+
+  struct Node
+  {
+    std::vector<SeqRecord> records;
+    std::map<name::Component, unique_ptr<Node>> children;
+  };
+
+  Node m_root;
+  uint64_t m_lastSeqNo;
+  std::unordered_map<const InterestFilterId*, shared_ptr<InterestFilterRecord>> m_records;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
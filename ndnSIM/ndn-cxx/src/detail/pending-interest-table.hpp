@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "pending-interest.hpp"
+#include "../util/signal.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of pending Interests indexed by Interest name
+ *
+ * Entries are kept in the order of insertion.  In addition, entries are indexed by Interest
+ * name and by PendingInterestId, so that finding Interests satisfied by a Data packet requires
+ * one hash lookup for every distinct Interest name length that may match the Data (usually
+ * just one), rather than a comparison with every pending Interest.  Selectors are still
+ * checked with Interest::matchesData on the found candidates.
+ *
+ * The table emits onEmpty signal when it becomes empty.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  typedef std::map<uint64_t, shared_ptr<PendingInterest>> Container;
+  typedef Container::iterator iterator;
+  typedef std::vector<shared_ptr<PendingInterest>> EntryList;
+
+  PendingInterestTable()
+    : m_lastSeqNo(0)
+  {
+  }
+
+  iterator
+  begin()
+  {
+    return m_container.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_container.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_container.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_container.empty();
+  }
+
+  iterator
+  insert(shared_ptr<PendingInterest> entry)
+  {
+    const Interest& interest = *entry->getInterest();
+    iterator it = m_container.insert(m_container.end(), std::make_pair(++m_lastSeqNo, entry));
+
+    // use .insert because gcc46 does not support .emplace
+    m_nameIndex.insert(std::make_pair(interest.getName(), it));
+    m_idIndex.insert(std::make_pair(getId(interest), it));
+    ++m_nNamesByLength[interest.getName().size()];
+    return it;
+  }
+
+  void
+  erase(iterator item)
+  {
+    this->removeEntry(item);
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  /**
+   * @brief Remove all entries of the Interest identified by @p pendingInterestId
+   */
+  void
+  erase(const PendingInterestId* pendingInterestId)
+  {
+    auto range = m_idIndex.equal_range(pendingInterestId);
+    std::vector<iterator> items;
+    for (auto i = range.first; i != range.second; ++i) {
+      items.push_back(i->second);
+    }
+    for (iterator item : items) {
+      this->removeEntry(item);
+    }
+
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  void
+  clear()
+  {
+    m_container.clear();
+    m_nameIndex.clear();
+    m_idIndex.clear();
+    m_nNamesByLength.clear();
+    this->onEmpty();
+  }
+
+  /**
+   * @brief Remove and return entries whose Interest can be satisfied by @p data,
+   *        in the order of insertion
+   */
+  EntryList
+  extractMatching(const Data& data)
+  {
+    const Name& dataName = data.getName();
+
+    std::vector<iterator> items;
+    for (const auto& length : m_nNamesByLength) {
+      if (length.first < dataName.size()) {
+        this->collectMatching(dataName.getPrefix(length.first), data, items);
+      }
+      else if (length.first == dataName.size()) {
+        this->collectMatching(dataName, data, items);
+      }
+      else {
+        // only an Interest with implicit digest can be longer than Data name
+        if (length.first == dataName.size() + 1) {
+          this->collectMatching(data.getFullName(), data, items);
+        }
+        break;
+      }
+    }
+
+    return this->extract(items);
+  }
+
+  /**
+   * @brief Remove and return entries whose Interest is equal to the Interest of @p nack,
+   *        in the order of insertion
+   */
+  EntryList
+  extractMatching(const lp::Nack& nack)
+  {
+    const Interest& nackedInterest = nack.getInterest();
+
+    std::vector<iterator> items;
+    auto range = m_nameIndex.equal_range(nackedInterest.getName());
+    for (auto i = range.first; i != range.second; ++i) {
+      if (*i->second->second->getInterest() == nackedInterest) {
+        items.push_back(i->second);
+      }
+    }
+
+    return this->extract(items);
+  }
+
+private:
+  static const PendingInterestId*
+  getId(const Interest& interest)
+  {
+    return reinterpret_cast<const PendingInterestId*>(&interest);
+  }
+
+  void
+  collectMatching(const Name& name, const Data& data, std::vector<iterator>& items)
+  {
+    auto range = m_nameIndex.equal_range(name);
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second->second->getInterest()->matchesData(data)) {
+        items.push_back(i->second);
+      }
+    }
+  }
+
+  EntryList
+  extract(std::vector<iterator>& items)
+  {
+    std::sort(items.begin(), items.end(),
+              [] (iterator a, iterator b) { return a->first < b->first; });
+
+    EntryList entries;
+    entries.reserve(items.size());
+    for (iterator item : items) {
+      entries.push_back(item->second);
+      this->removeEntry(item);
+    }
+
+    if (!entries.empty() && empty()) {
+      this->onEmpty();
+    }
+    return entries;
+  }
+
+  template<class Index, class Key>
+  static void
+  removeFromIndex(Index& index, const Key& key, iterator item)
+  {
+    auto range = index.equal_range(key);
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second == item) {
+        index.erase(i);
+        return;
+      }
+    }
+  }
+
+  void
+  removeEntry(iterator item)
+  {
+    const Interest& interest = *item->second->getInterest();
+    removeFromIndex(m_nameIndex, interest.getName(), item);
+    removeFromIndex(m_idIndex, getId(interest), item);
+
+    auto length = m_nNamesByLength.find(interest.getName().size());
+    BOOST_ASSERT(length != m_nNamesByLength.end());
+    if (--length->second == 0) {
+      m_nNamesByLength.erase(length);
+    }
+
+    m_container.erase(item);
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  Container m_container;
+  uint64_t m_lastSeqNo;
+
+  std::unordered_multimap<Name, iterator> m_nameIndex;
+  std::unordered_multimap<const PendingInterestId*, iterator> m_idIndex;
+
+  /// number of entries with each Interest name length, in increasing order of length
+  std::map<size_t, size_t> m_nNamesByLength;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-cursor.hpp"
+
+namespace ndn {
+
+BlockCursor::BlockCursor(const Block& block)
+  : BlockCursor(block, block.value_begin(), block.value_end())
+{
+}
+
+BlockCursor::BlockCursor(const Block& block,
+                         const Buffer::const_iterator& begin, const Buffer::const_iterator& end)
+  : m_block(&block)
+  , m_next(begin)
+  , m_end(end)
+  , m_type(std::numeric_limits<uint32_t>::max())
+  , m_elementBegin(begin)
+  , m_valueBegin(begin)
+  , m_elementEnd(begin)
+{
+}
+
+BlockCursor
+BlockCursor::fromCurrent(const BlockCursor& parent)
+{
+  return BlockCursor(*parent.m_block, parent.m_valueBegin, parent.m_elementEnd);
+}
+
+bool
+BlockCursor::next()
+{
+  if (m_next == m_end)
+    return false;
+
+  m_elementBegin = m_next;
+  uint64_t length = 0;
+  if (m_end - m_next >= 2 && m_next[0] < 253 && m_next[1] < 253) {
+    // most elements have one-octet TLV-TYPE and TLV-LENGTH
+    m_type = m_next[0];
+    length = m_next[1];
+    m_next += 2;
+  }
+  else {
+    m_type = tlv::readType(m_next, m_end);
+    length = tlv::readVarNumber(m_next, m_end);
+  }
+  if (length > static_cast<uint64_t>(m_end - m_next))
+    BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+
+  m_valueBegin = m_next;
+  m_next += length;
+  m_elementEnd = m_next;
+  return true;
+}
+
+Block
+BlockCursor::block() const
+{
+  return Block(m_block->getBuffer(), m_type, m_elementBegin, m_elementEnd,
+               m_valueBegin, m_elementEnd);
+}
+
+uint64_t
+BlockCursor::readNonNegativeInteger() const
+{
+  Buffer::const_iterator begin = m_valueBegin;
+  return tlv::readNonNegativeInteger(value_size(), begin, m_elementEnd);
+}
+
+} // namespace ndn
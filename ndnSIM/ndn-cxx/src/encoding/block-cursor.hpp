@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_CURSOR_HPP
+#define NDN_ENCODING_BLOCK_CURSOR_HPP
+
+#include "block.hpp"
+
+namespace ndn {
+
+/** @brief Forward-only reader of sub elements of a Block
+ *
+ *  Unlike Block::parse, which creates a Block for every sub element, the cursor decodes
+ *  TLV-TYPE and TLV-LENGTH of one element at a time in place, without allocating memory.
+ *  A Block for the current element is created only when requested with block().
+ *
+ *  @code
+ *  BlockCursor cursor(wire);
+ *  while (cursor.next()) {
+ *    if (cursor.type() == tlv::Nonce)
+ *      ...
+ *  }
+ *  @endcode
+ *
+ *  @note The cursor refers to the Block it was created from, which must outlive the cursor.
+ */
+class BlockCursor
+{
+public:
+  /** @brief Create a cursor positioned before the first sub element of @p block
+   */
+  explicit
+  BlockCursor(const Block& block);
+
+  /** @brief Create a cursor positioned before the first sub element of the current element
+   *         of @p parent
+   *  @pre parent.next() returned true
+   */
+  static BlockCursor
+  fromCurrent(const BlockCursor& parent);
+
+  /** @brief Advance to the next sub element
+   *  @return false if there are no more sub elements
+   *  @throw tlv::Error TLV-LENGTH of the next element exceeds the remaining value
+   */
+  bool
+  next();
+
+  uint32_t
+  type() const
+  {
+    return m_type;
+  }
+
+  Buffer::const_iterator
+  begin() const
+  {
+    return m_elementBegin;
+  }
+
+  Buffer::const_iterator
+  end() const
+  {
+    return m_elementEnd;
+  }
+
+  Buffer::const_iterator
+  value_begin() const
+  {
+    return m_valueBegin;
+  }
+
+  Buffer::const_iterator
+  value_end() const
+  {
+    return m_elementEnd;
+  }
+
+  const uint8_t*
+  value() const
+  {
+    return m_block->value() + (m_valueBegin - m_block->value_begin());
+  }
+
+  size_t
+  value_size() const
+  {
+    return m_elementEnd - m_valueBegin;
+  }
+
+  /** @brief Create a Block of the current element, sharing the buffer of the parent Block
+   */
+  Block
+  block() const;
+
+  /** @brief Decode value of the current element as nonNegativeInteger
+   *  @throw tlv::Error value is not a valid nonNegativeInteger
+   */
+  uint64_t
+  readNonNegativeInteger() const;
+
+private:
+  BlockCursor(const Block& block,
+              const Buffer::const_iterator& begin, const Buffer::const_iterator& end);
+
+private:
+  const Block* m_block;
+  Buffer::const_iterator m_next;
+  Buffer::const_iterator m_end;
+
+  uint32_t m_type;
+  Buffer::const_iterator m_elementBegin;
+  Buffer::const_iterator m_valueBegin;
+  Buffer::const_iterator m_elementEnd;
+};
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_CURSOR_HPP
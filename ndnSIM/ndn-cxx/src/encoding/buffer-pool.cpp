@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "buffer-pool.hpp"
+#include "tlv.hpp"
+
+#include <array>
+
+namespace ndn {
+
+const size_t BufferPool::SIZE_CLASSES[] = {256, 1024, 4096, 16384, 65536};
+const size_t BufferPool::N_SIZE_CLASSES = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+const size_t BufferPool::MAX_FREE_BUFFERS = 64;
+
+static_assert(MAX_NDN_PACKET_SIZE <= 16384, "packets of maximum size should be pooled");
+
+namespace {
+
+class FreeLists
+{
+public:
+  ~FreeLists()
+  {
+    isDestroyed = true;
+    for (auto& list : lists) {
+      for (Buffer* buffer : list) {
+        delete buffer;
+      }
+    }
+  }
+
+public:
+  std::array<std::vector<Buffer*>, 5> lists;
+  BufferPool::Statistics statistics;
+  static thread_local bool isDestroyed;
+};
+
+thread_local bool FreeLists::isDestroyed = false;
+thread_local FreeLists g_freeLists;
+
+size_t
+getSizeClass(size_t size)
+{
+  size_t sizeClass = 0;
+  while (sizeClass < BufferPool::N_SIZE_CLASSES && BufferPool::SIZE_CLASSES[sizeClass] < size) {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+/** @brief Deleter that returns a Buffer to the free list of the current thread
+ */
+class ReleaseToPool
+{
+public:
+  explicit
+  ReleaseToPool(size_t sizeClass)
+    : m_sizeClass(sizeClass)
+  {
+  }
+
+  void
+  operator()(Buffer* buffer) const
+  {
+    // buffers released during thread exit, e.g., by static Blocks, are simply deleted
+    if (FreeLists::isDestroyed) {
+      delete buffer;
+      return;
+    }
+
+    std::vector<Buffer*>& list = g_freeLists.lists[m_sizeClass];
+    if (list.size() >= BufferPool::MAX_FREE_BUFFERS) {
+      delete buffer;
+      return;
+    }
+    list.push_back(buffer);
+  }
+
+private:
+  size_t m_sizeClass;
+};
+
+} // namespace
+
+static_assert(sizeof(BufferPool::SIZE_CLASSES) / sizeof(BufferPool::SIZE_CLASSES[0]) ==
+              std::tuple_size<decltype(FreeLists::lists)>::value,
+              "each size class needs a free list");
+
+BufferPtr
+BufferPool::allocate(size_t size)
+{
+  size_t sizeClass = getSizeClass(size);
+  if (sizeClass == N_SIZE_CLASSES || FreeLists::isDestroyed) {
+    return make_shared<Buffer>(size);
+  }
+
+  ++g_freeLists.statistics.nAllocations;
+
+  Buffer* buffer = nullptr;
+  std::vector<Buffer*>& list = g_freeLists.lists[sizeClass];
+  if (!list.empty()) {
+    buffer = list.back();
+    list.pop_back();
+    ++g_freeLists.statistics.nReuses;
+  }
+  else {
+    buffer = new Buffer();
+    buffer->reserve(SIZE_CLASSES[sizeClass]);
+  }
+
+  // only octets beyond the previous size of a reused buffer are initialized
+  buffer->resize(size);
+  return BufferPtr(buffer, ReleaseToPool(sizeClass));
+}
+
+BufferPool::Statistics
+BufferPool::getStatistics()
+{
+  Statistics statistics = g_freeLists.statistics;
+  statistics.nFreeBuffers = 0;
+  for (const auto& list : g_freeLists.lists) {
+    statistics.nFreeBuffers += list.size();
+  }
+  return statistics;
+}
+
+void
+BufferPool::clear()
+{
+  for (auto& list : g_freeLists.lists) {
+    for (Buffer* buffer : list) {
+      delete buffer;
+    }
+    list.clear();
+  }
+}
+
+} // namespace ndn
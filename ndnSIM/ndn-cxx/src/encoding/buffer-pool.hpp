@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BUFFER_POOL_HPP
+#define NDN_ENCODING_BUFFER_POOL_HPP
+
+#include "buffer.hpp"
+
+namespace ndn {
+
+/** @brief Per-thread pool of Buffers used by encoders
+ *
+ *  Buffers are grouped into size classes.  A Buffer obtained from allocate() is returned to
+ *  the free list of its size class in the current thread when the last shared_ptr to it
+ *  (e.g., the last Block referring to an encoded packet) is destroyed, so that encoding a
+ *  packet of a similar size later reuses its memory instead of allocating from the heap.
+ *  Buffers larger than the largest size class are not pooled.
+ */
+class BufferPool
+{
+public:
+  /** @brief Statistics of the pool of the current thread
+   */
+  struct Statistics
+  {
+    uint64_t nAllocations = 0; ///< number of allocate() calls
+    uint64_t nReuses = 0;      ///< number of allocate() calls served from a free list
+    size_t nFreeBuffers = 0;   ///< number of buffers currently in free lists
+  };
+
+  /** @brief Get a Buffer of exactly @p size octets
+   *
+   *  Contents of the Buffer are unspecified.
+   */
+  static BufferPtr
+  allocate(size_t size);
+
+  static Statistics
+  getStatistics();
+
+  /** @brief Release all free buffers of the current thread
+   */
+  static void
+  clear();
+
+public:
+  /** @brief Sizes of the size classes; each class keeps at most MAX_FREE_BUFFERS buffers
+   */
+  static const size_t SIZE_CLASSES[];
+  static const size_t N_SIZE_CLASSES;
+  static const size_t MAX_FREE_BUFFERS;
+};
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BUFFER_POOL_HPP
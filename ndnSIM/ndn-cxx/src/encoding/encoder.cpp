@@ -20,12 +20,13 @@
  */
 
 #include "encoder.hpp"
+#include "buffer-pool.hpp"
 
 namespace ndn {
 namespace encoding {
 
 Encoder::Encoder(size_t totalReserve/* = MAX_NDN_PACKET_SIZE*/, size_t reserveFromBack/* = 400*/)
-  : m_buffer(new Buffer(totalReserve))
+  : m_buffer(BufferPool::allocate(totalReserve))
 {
   m_begin = m_end = m_buffer->end() - (reserveFromBack < totalReserve ? reserveFromBack : 0);
 }
@@ -64,6 +65,13 @@ Encoder::block(bool verifyLength/* = true*/) const
                verifyLength);
 }
 
+Block
+Encoder::copyBlock(bool verifyLength/* = true*/) const
+{
+  auto buffer = make_shared<Buffer>(m_begin, m_end);
+  return Block(buffer, buffer->begin(), buffer->end(), verifyLength);
+}
+
 void
 Encoder::reserve(size_t size, bool addInFront)
 {
@@ -75,10 +83,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_buffer->end() - m_end;
     size_t diffBegin = m_buffer->end() - m_begin;
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = BufferPool::allocate(size);
     std::copy_backward(m_buffer->begin(), m_buffer->end(), buf->end());
 
-    m_buffer.reset(buf);
+    m_buffer = buf;
 
     m_end = m_buffer->end() - diffEnd;
     m_begin = m_buffer->end() - diffBegin;
@@ -87,10 +95,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_end - m_buffer->begin();
     size_t diffBegin = m_begin - m_buffer->begin();
 
-    Buffer* buf = new Buffer(size);
+    shared_ptr<Buffer> buf = BufferPool::allocate(size);
     std::copy(m_buffer->begin(), m_buffer->end(), buf->begin());
 
-    m_buffer.reset(buf);
+    m_buffer = buf;
 
     m_end = m_buffer->begin() + diffEnd;
     m_begin = m_buffer->begin() + diffBegin;
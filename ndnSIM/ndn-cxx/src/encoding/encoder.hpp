@@ -40,6 +40,9 @@ public: // common interface between Encoder and Estimator
    * @brief Create instance of the encoder with the specified reserved sizes
    * @param totalReserve    initial buffer size to reserve
    * @param reserveFromBack number of bytes to reserve for append* operations
+   *
+   * The buffer is taken from the BufferPool of the current thread, and returns there when the
+   * encoder and all Blocks created from it are destroyed.
    */
   explicit
   Encoder(size_t totalReserve = MAX_NDN_PACKET_SIZE, size_t reserveFromBack = 400);
@@ -248,6 +251,16 @@ public: // accessors
   Block
   block(bool verifyLength = true) const;
 
+  /**
+   * @brief Create Block from an exact-size copy of the encoded buffer
+   *
+   * Unlike block(), the Block does not keep the underlying buffer, which comes from
+   * BufferPool and has the capacity of its whole size class.  Use it for wires that are
+   * kept for long, e.g., by packets stored in the ContentStore or in the PIT.
+   */
+  Block
+  copyBlock(bool verifyLength = true) const;
+
 private:
   shared_ptr<Buffer> m_buffer;
 
@@ -25,7 +25,9 @@
 #include <stdexcept>
 #include <iostream>
 #include <iterator>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 
 #include "buffer.hpp"
 #include "endian.hpp"
@@ -240,49 +242,221 @@ writeNonNegativeInteger(std::ostream& os, uint64_t varNumber);
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/** @brief Determine whether InputIterator points into contiguous memory of octets
+ *
+ *  Numbers are read from contiguous memory with whole-word loads, while other iterators
+ *  (e.g., std::istream_iterator) are read octet by octet.
+ */
 template<class InputIterator>
+struct IsContiguousIterator : std::false_type
+{
+};
+
+template<>
+struct IsContiguousIterator<const uint8_t*> : std::true_type
+{
+};
+
+template<>
+struct IsContiguousIterator<uint8_t*> : std::true_type
+{
+};
+
+template<>
+struct IsContiguousIterator<Buffer::const_iterator> : std::true_type
+{
+};
+
+template<>
+struct IsContiguousIterator<Buffer::iterator> : std::true_type
+{
+};
+
+/** @brief Read a big-endian unsigned integer of sizeof(T) octets from possibly unaligned memory
+ */
+template<class T>
+inline T
+readBigEndian(const uint8_t* pos);
+
+template<>
+inline uint8_t
+readBigEndian<uint8_t>(const uint8_t* pos)
+{
+  return *pos;
+}
+
+template<>
+inline uint16_t
+readBigEndian<uint16_t>(const uint8_t* pos)
+{
+  uint16_t value;
+  std::memcpy(&value, pos, sizeof(value));
+  return be16toh(value);
+}
+
+template<>
+inline uint32_t
+readBigEndian<uint32_t>(const uint8_t* pos)
+{
+  uint32_t value;
+  std::memcpy(&value, pos, sizeof(value));
+  return be32toh(value);
+}
+
+template<>
+inline uint64_t
+readBigEndian<uint64_t>(const uint8_t* pos)
+{
+  uint64_t value;
+  std::memcpy(&value, pos, sizeof(value));
+  return be64toh(value);
+}
+
 inline bool
-readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number)
+readVarNumber(const uint8_t*& pos, const uint8_t* end, uint64_t& number)
+{
+  if (pos == end)
+    return false;
+
+  uint8_t firstOctet = *pos;
+  ++pos;
+  if (firstOctet < 253) {
+    number = firstOctet;
+    return true;
+  }
+
+  // 253, 254, 255 are followed by 2, 4, 8 octets
+  size_t size = size_t(2) << (firstOctet - 253);
+  if (static_cast<size_t>(end - pos) < size)
+    return false;
+
+  switch (firstOctet) {
+  case 253:
+    number = readBigEndian<uint16_t>(pos);
+    break;
+  case 254:
+    number = readBigEndian<uint32_t>(pos);
+    break;
+  default:
+    number = readBigEndian<uint64_t>(pos);
+    break;
+  }
+  pos += size;
+  return true;
+}
+
+template<class InputIterator>
+inline bool
+readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number, std::true_type)
+{
+  if (begin == end)
+    return false;
+
+  const uint8_t* first = &*begin;
+  const uint8_t* pos = first;
+  bool isOk = readVarNumber(pos, first + (end - begin), number);
+  begin += pos - first;
+  return isOk;
+}
+
+template<class InputIterator>
+inline bool
+readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number, std::false_type)
 {
   if (begin == end)
     return false;
 
   uint8_t firstOctet = *begin;
   ++begin;
-  if (firstOctet < 253)
-    {
-      number = firstOctet;
-    }
-  else if (firstOctet == 253)
-    {
-      if (end - begin < 2)
-        return false;
+  if (firstOctet < 253) {
+    number = firstOctet;
+    return true;
+  }
 
-      uint16_t value = *reinterpret_cast<const uint16_t*>(&*begin);
-      begin += 2;
-      number = be16toh(value);
-    }
-  else if (firstOctet == 254)
-    {
-      if (end - begin < 4)
-        return false;
+  size_t size = size_t(2) << (firstOctet - 253);
+  number = 0;
+  size_t count = 0;
+  for (; begin != end && count < size; ++count) {
+    number = (number << 8) | static_cast<uint8_t>(*begin);
+    ++begin;
+  }
+  return count == size;
+}
 
-      uint32_t value = *reinterpret_cast<const uint32_t*>(&*begin);
-      begin += 4;
-      number = be32toh(value);
-    }
-  else // if (firstOctet == 255)
-    {
-      if (end - begin < 8)
-        return false;
+template<class T>
+inline uint64_t
+readNonNegativeInteger(const uint8_t*& pos, const uint8_t* end)
+{
+  if (static_cast<size_t>(end - pos) < sizeof(T))
+    BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
 
-      uint64_t value = *reinterpret_cast<const uint64_t*>(&*begin);
-      begin += 8;
+  T value = readBigEndian<T>(pos);
+  pos += sizeof(T);
+  return value;
+}
 
-      number = be64toh(value);
-    }
+template<class InputIterator>
+inline uint64_t
+readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end,
+                       std::true_type)
+{
+  const uint8_t* first = begin == end ? nullptr : &*begin;
+  const uint8_t* pos = first;
+  const uint8_t* last = first + (end - begin);
 
-  return true;
+  uint64_t value = 0;
+  switch (size) {
+  case 1:
+    value = readNonNegativeInteger<uint8_t>(pos, last);
+    break;
+  case 2:
+    value = readNonNegativeInteger<uint16_t>(pos, last);
+    break;
+  case 4:
+    value = readNonNegativeInteger<uint32_t>(pos, last);
+    break;
+  case 8:
+    value = readNonNegativeInteger<uint64_t>(pos, last);
+    break;
+  default:
+    BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger "
+                                "(only 1, 2, 4, and 8 are allowed)"));
+  }
+  begin += pos - first;
+  return value;
+}
+
+template<class InputIterator>
+inline uint64_t
+readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end,
+                       std::false_type)
+{
+  if (size != 1 && size != 2 && size != 4 && size != 8)
+    BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger "
+                                "(only 1, 2, 4, and 8 are allowed)"));
+
+  uint64_t value = 0;
+  size_t count = 0;
+  for (; begin != end && count < size; ++count) {
+    value = (value << 8) | static_cast<uint8_t>(*begin);
+    ++begin;
+  }
+
+  if (count != size)
+    BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+
+  return value;
+}
+
+} // namespace detail
+
+template<class InputIterator>
+inline bool
+readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number)
+{
+  return detail::readVarNumber(begin, end, number, detail::IsContiguousIterator<InputIterator>());
 }
 
 template<class InputIterator>
@@ -434,45 +608,8 @@ template<class InputIterator>
 inline uint64_t
 readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end)
 {
-  switch (size) {
-  case 1:
-    {
-      if (end - begin < 1)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint8_t value = *begin;
-      begin++;
-      return value;
-    }
-  case 2:
-    {
-      if (end - begin < 2)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint16_t value = *reinterpret_cast<const uint16_t*>(&*begin);
-      begin += 2;
-      return be16toh(value);
-    }
-  case 4:
-    {
-      if (end - begin < 4)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint32_t value = *reinterpret_cast<const uint32_t*>(&*begin);
-      begin += 4;
-      return be32toh(value);
-    }
-  case 8:
-    {
-      if (end - begin < 8)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint64_t value = *reinterpret_cast<const uint64_t*>(&*begin);
-      begin += 8;
-      return be64toh(value);
-    }
-  }
-  BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger (only 1, 2, 4, and 8 are allowed)"));
+  return detail::readNonNegativeInteger(size, begin, end,
+                                        detail::IsContiguousIterator<InputIterator>());
 }
 
 template<>
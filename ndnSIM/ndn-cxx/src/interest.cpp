@@ -29,6 +29,7 @@
 #include "util/random.hpp"
 #include "util/crypto.hpp"
 #include "data.hpp"
+#include "encoding/block-cursor.hpp"
 
 namespace ndn {
 
@@ -296,8 +297,9 @@ Interest::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+  // to ensure that Nonce block points to the right memory location;
+  // an exact-size copy, so that an Interest kept in the PIT does not pin the pooled buffer
+  const_cast<Interest*>(this)->wireDecode(buffer.copyBlock());
 
   return m_wire;
 }
@@ -306,7 +308,6 @@ void
 Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
-  m_wire.parse();
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -320,46 +321,85 @@ Interest::wireDecode(const Block& wire)
   if (m_wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
 
+  // elements are decoded in place, only the first element of each type is used
+  bool hasName = false;
+  bool hasSelectors = false;
+  bool hasInterestLifetime = false;
+  bool hasSelectedDelegation = false;
+  uint64_t selectedDelegation = 0;
+
+  m_nonce = Block();
+  m_link = Block();
+  m_payload = Block();
+
+  BlockCursor val(m_wire);
+  while (val.next()) {
+    switch (val.type()) {
+    case tlv::Name:
+      if (!hasName) {
+        m_name.wireDecode(val.block());
+        hasName = true;
+      }
+      break;
+    case tlv::Selectors:
+      if (!hasSelectors) {
+        m_selectors.wireDecode(val.block());
+        hasSelectors = true;
+      }
+      break;
+    case tlv::Nonce:
+      if (m_nonce.empty())
+        m_nonce = val.block();
+      break;
+    case tlv::InterestLifetime:
+      if (!hasInterestLifetime) {
+        m_interestLifetime = time::milliseconds(val.readNonNegativeInteger());
+        hasInterestLifetime = true;
+      }
+      break;
+    case tlv::Data:
+      if (m_link.empty())
+        m_link = val.block();
+      break;
+    case tlv::SelectedDelegation:
+      if (!hasSelectedDelegation) {
+        selectedDelegation = val.readNonNegativeInteger();
+        hasSelectedDelegation = true;
+      }
+      break;
+    case tlv::IpPacket:
+      if (m_payload.empty())
+        m_payload = val.block();
+      break;
+    default:
+      break;
+    }
+  }
+
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  if (!hasName)
+    BOOST_THROW_EXCEPTION(Error("Name element is missing when decoding Interest"));
 
   // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end()) {
-    m_selectors.wireDecode(*val);
-  }
-  else
+  if (!hasSelectors)
     m_selectors = Selectors();
 
   // Nonce
-  m_nonce = m_wire.get(tlv::Nonce);
+  if (m_nonce.empty())
+    BOOST_THROW_EXCEPTION(Error("Nonce element is missing when decoding Interest"));
 
   // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end()) {
-    m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
-  }
-  else {
+  if (!hasInterestLifetime)
     m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
-  }
 
   // Link object
   m_linkCached.reset();
-  val = m_wire.find(tlv::Data);
-  if (val != m_wire.elements_end()) {
-    m_link = (*val);
-  }
-  else {
-    m_link = Block();
-  }
 
   // SelectedDelegation
-  val = m_wire.find(tlv::SelectedDelegation);
-  if (val != m_wire.elements_end()) {
+  if (hasSelectedDelegation) {
     if (!this->hasLink()) {
       BOOST_THROW_EXCEPTION(Error("Interest contains SelectedDelegation, but no LINK object"));
     }
-    uint64_t selectedDelegation = readNonNegativeInteger(*val);
     if (selectedDelegation < uint64_t(Link::countDelegationsFromWire(m_link))) {
       m_selectedDelegationIndex = static_cast<size_t>(selectedDelegation);
     }
@@ -373,15 +413,6 @@ Interest::wireDecode(const Block& wire)
 
   // Payload object
   m_payloadCached.reset();
-  val = m_wire.find(tlv::IpPacket);
-  if (val != m_wire.elements_end()) {
-    m_payload = (*val);
-  }
-  else {
-    m_payload = Block();
-  }
-
-
 }
 
 bool
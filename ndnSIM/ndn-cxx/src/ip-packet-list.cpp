@@ -18,6 +18,7 @@
  */
 
 #include "ip-packet-list.hpp"
+#include "encoding/block-cursor.hpp"
 
 namespace ndn {
 
@@ -92,11 +93,9 @@ IpPacketList::wireEncode() const
 {
     if (m_wire.hasWire())
         m_wire.reset();
-    
-    EncodingEstimator estimator;
-    size_t estimatedSize = wireEncode(estimator);
-    
-    EncodingBuffer buffer(estimatedSize, 0);
+
+    // encode in a single pass; the buffer of maximum packet size comes from the buffer pool
+    EncodingBuffer buffer(MAX_NDN_PACKET_SIZE, 0);
     wireEncode(buffer);
     
     m_wire = buffer.block();
@@ -113,13 +112,14 @@ IpPacketList::wireDecode(const Block& block)
     
     m_pktls.clear();
     
-    block.parse();
-    for (const auto& pkt : block.elements()) {
+    // only IP packets are materialized, directly into the list
+    BlockCursor pkt(block);
+    while (pkt.next()) {
         if (pkt.type() != tlv::IpPacket) {
             BOOST_THROW_EXCEPTION(Error("Unexpected TLV-TYPE " + to_string(pkt.type()) +
                                         " when decoding IP Packet"));
         }
-        m_pktls.push_back(pkt);
+        m_pktls.push_back(pkt.block());
     }
     
     if (this->size() == 0) {
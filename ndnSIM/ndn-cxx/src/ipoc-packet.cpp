@@ -23,6 +23,7 @@
  
 #include "ipoc-packet.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/block-cursor.hpp"
 
 namespace ndn {
 
@@ -70,11 +71,9 @@ IPoCPacket::wireEncode() const
 {
     if (m_wire.hasWire())
         m_wire.reset();
-    
-    EncodingEstimator estimator;
-    size_t estimatedSize = wireEncode(estimator);
-    
-    EncodingBuffer buffer(estimatedSize, 0);
+
+    // encode in a single pass; the buffer of maximum packet size comes from the buffer pool
+    EncodingBuffer buffer(MAX_NDN_PACKET_SIZE, 0);
     wireEncode(buffer);
     
     m_wire = buffer.block();
@@ -88,23 +87,23 @@ IPoCPacket::wireDecode(const Block& wire)
         BOOST_THROW_EXCEPTION(Error("Unexpected TLV type during IPoCPacket decoding"));
     
     m_wire = wire;
-    m_wire.parse();
-    
-    Block::element_const_iterator val = m_wire.elements_begin();
-    
-    if (val != m_wire.elements_end() && val->type() == IPoCPacket_ControlBits) {
-        m_controlBits = static_cast<uint8_t>(readNonNegativeInteger(*val));
-        ++val;
+
+    // fields are decoded in place, without creating a Block for each of them
+    BlockCursor val(m_wire);
+    bool hasVal = val.next();
+
+    if (hasVal && val.type() == IPoCPacket_ControlBits) {
+        m_controlBits = static_cast<uint8_t>(val.readNonNegativeInteger());
+        hasVal = val.next();
     }
-    
-    if (val != m_wire.elements_end() && val->type() == IPoCPacket_SequenceNumber) {
-        m_seqNumber = readNonNegativeInteger(*val);
-        ++val;
+
+    if (hasVal && val.type() == IPoCPacket_SequenceNumber) {
+        m_seqNumber = val.readNonNegativeInteger();
+        hasVal = val.next();
     }
 
-    if (val != m_wire.elements_end() && val->type() == tlv::IpPacketList) {
-        m_payload = *val;
-        ++val;
+    if (hasVal && val.type() == tlv::IpPacketList) {
+        m_payload = val.block();
     }
 
 }
@@ -21,6 +21,7 @@
 
 #include "packet.hpp"
 #include "detail/field-info.hpp"
+#include "../encoding/block-cursor.hpp"
 
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -71,7 +72,7 @@ Packet::wireEncode() const
   }
 
   // If no header or trailer, return bare network packet
-  Block::element_container elements = m_wire.elements();
+  const Block::element_container& elements = m_wire.elements();
   if (elements.size() == 1 && elements.front().type() == FragmentField::TlvType::value) {
     elements.front().parse();
     elements.front().elements().front().parse();
@@ -101,11 +102,11 @@ Packet::wireDecode(const Block& wire)
     BOOST_THROW_EXCEPTION(Error("unrecognized TLV-TYPE " + to_string(wire.type())));
   }
 
-  wire.parse();
-
+  // validate fields in place, so that sub elements are created only once in m_wire
   bool isFirst = true;
   detail::FieldInfo prev;
-  for (const Block& element : wire.elements()) {
+  BlockCursor element(wire);
+  while (element.next()) {
     detail::FieldInfo info(element.type());
 
     if (!info.isRecognized && !info.canIgnore) {
@@ -127,6 +128,7 @@ Packet::wireDecode(const Block& wire)
   }
 
   m_wire = wire;
+  m_wire.parse();
 }
 
 bool
@@ -32,6 +32,8 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <atomic>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -43,6 +45,95 @@ static_assert(std::is_base_of<tlv::Error, Name::Error>::value,
 
 const size_t Name::npos = std::numeric_limits<size_t>::max();
 
+/**
+ * @brief Wire buffer shared by copies of a name
+ *
+ * Components are stored from valueBegin onwards, and octets before valueBegin are reserved
+ * for the Name TLV header.  Octets up to end have been claimed by some name and are never
+ * modified again, so a name may write only after claiming octets that start exactly where its
+ * components end.  The header is written once, for the name whose components end at headerEnd.
+ */
+struct Name::Arena
+{
+  Arena(size_t capacity, size_t valueBegin)
+    : buffer(capacity)
+    , valueBegin(valueBegin)
+    , end(valueBegin)
+    , headerEnd(0)
+  {
+  }
+
+  Buffer buffer;
+  const size_t valueBegin;
+  std::atomic<size_t> end;
+  std::atomic<size_t> headerEnd;
+};
+
+/// space reserved for Name TLV-TYPE and the longest TLV-LENGTH in arenas that may grow
+static const size_t ARENA_HEADROOM = 1 + 9;
+
+/// minimal space for components in arenas that may grow
+static const size_t ARENA_MIN_VALUE_CAPACITY = 64;
+
+static uint8_t*
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    *pos++ = 253;
+    uint16_t value = htobe16(static_cast<uint16_t>(number));
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  else if (number <= std::numeric_limits<uint32_t>::max()) {
+    *pos++ = 254;
+    uint32_t value = htobe32(static_cast<uint32_t>(number));
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  else {
+    *pos++ = 255;
+    uint64_t value = htobe64(number);
+    std::memcpy(pos, &value, sizeof(value));
+    pos += sizeof(value);
+  }
+  return pos;
+}
+
+/// @return number of octets of a nonNegativeInteger, same as in EncodingImpl
+static size_t
+sizeOfNonNegativeInteger(uint64_t number)
+{
+  if (number <= std::numeric_limits<uint8_t>::max())
+    return 1;
+  else if (number <= std::numeric_limits<uint16_t>::max())
+    return 2;
+  else if (number <= std::numeric_limits<uint32_t>::max())
+    return 4;
+  else
+    return 8;
+}
+
+static uint8_t*
+writeNonNegativeInteger(uint8_t* pos, uint64_t number)
+{
+  size_t size = sizeOfNonNegativeInteger(number);
+  for (size_t i = size; i > 0; --i) {
+    pos[i - 1] = static_cast<uint8_t>(number);
+    number >>= 8;
+  }
+  return pos + size;
+}
+
+static size_t
+sizeOfComponent(const Block& component)
+{
+  return tlv::sizeOfVarNumber(component.type()) + tlv::sizeOfVarNumber(component.value_size()) +
+         component.value_size();
+}
+
 Name::Name()
   : m_nameBlock(tlv::Name)
 {
@@ -113,7 +204,8 @@ Name::deepCopy() const
 {
   Name copiedName(*this);
   copiedName.m_nameBlock.resetWire();
-  copiedName.wireEncode(); // "compress" the underlying buffer
+  copiedName.moveToNewArena(0, false); // "compress" the underlying buffer
+  copiedName.wireEncode();
   return copiedName;
 }
 
@@ -145,13 +237,32 @@ Name::wireEncode() const
   if (m_nameBlock.hasWire())
     return m_nameBlock;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  if (m_arena == nullptr) {
+    moveToNewArena(0, false);
+  }
 
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
+  // the header in front of components can be written once; if it was already written for
+  // other components, i.e., for another copy of this name, move to a new arena
+  size_t end = getArenaEnd();
+  size_t headerEnd = 0;
+  bool isHeaderWritten = m_arena->headerEnd == end;
+  if (!isHeaderWritten && !m_arena->headerEnd.compare_exchange_strong(headerEnd, end)) {
+    moveToNewArena(0, false);
+    end = getArenaEnd();
+    m_arena->headerEnd = end;
+  }
 
-  m_nameBlock = buffer.block();
+  size_t valueBegin = m_arena->valueBegin;
+  size_t valueLength = end - valueBegin;
+  size_t begin = valueBegin - tlv::sizeOfVarNumber(tlv::Name) - tlv::sizeOfVarNumber(valueLength);
+  if (!isHeaderWritten) {
+    writeVarNumber(writeVarNumber(&m_arena->buffer[begin], tlv::Name), valueLength);
+  }
+
+  const Buffer& buffer = m_arena->buffer;
+  m_nameBlock = Block(ConstBufferPtr(m_arena, &buffer), tlv::Name,
+                      buffer.begin() + begin, buffer.begin() + end,
+                      buffer.begin() + valueBegin, buffer.begin() + end);
   m_nameBlock.parse();
 
   return m_nameBlock;
@@ -165,6 +276,153 @@ Name::wireDecode(const Block& wire)
 
   m_nameBlock = wire;
   m_nameBlock.parse();
+  m_arena.reset();
+}
+
+size_t
+Name::getArenaEnd() const
+{
+  BOOST_ASSERT(m_arena != nullptr);
+  if (empty())
+    return m_arena->valueBegin;
+
+  return get(-1).end() - m_arena->buffer.begin();
+}
+
+void
+Name::moveToNewArena(size_t nOctets, bool withSlack) const
+{
+  size_t valueLength = 0;
+  for (const Component& component : *this) {
+    valueLength += sizeOfComponent(component);
+  }
+
+  size_t headroom = ARENA_HEADROOM;
+  size_t capacity = valueLength + nOctets;
+  if (withSlack) {
+    capacity = std::max(2 * capacity, ARENA_MIN_VALUE_CAPACITY);
+  }
+  else {
+    // the arena will not grow, so the exact header size is known
+    headroom = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(valueLength);
+  }
+
+  Block oldBlock = std::move(m_nameBlock);
+  m_arena = make_shared<Arena>(headroom + capacity, headroom);
+  m_nameBlock = Block(tlv::Name);
+
+  uint8_t* base = m_arena->buffer.data();
+  uint8_t* pos = base + headroom;
+  for (const Block& component : oldBlock.elements()) {
+    size_t begin = pos - base;
+    pos = writeVarNumber(writeVarNumber(pos, component.type()), component.value_size());
+    size_t valueBegin = pos - base;
+    if (component.value_size() > 0) {
+      std::memcpy(pos, component.value(), component.value_size());
+      pos += component.value_size();
+    }
+    pushArenaComponent(component.type(), begin, valueBegin, pos - base);
+  }
+  m_arena->end = pos - base;
+}
+
+uint8_t*
+Name::claimArena(size_t nOctets, Block& oldBlock) const
+{
+  if (m_arena != nullptr) {
+    size_t end = getArenaEnd();
+    if (end + nOctets <= m_arena->buffer.size() &&
+        m_arena->end.compare_exchange_strong(end, end + nOctets)) {
+      m_nameBlock.resetWire();
+      return &m_arena->buffer[end];
+    }
+  }
+
+  // keep the original elements, which may be referenced by the caller, and move a copy
+  oldBlock = std::move(m_nameBlock);
+  m_nameBlock = oldBlock;
+  moveToNewArena(nOctets, true);
+  size_t end = m_arena->end;
+  m_arena->end = end + nOctets;
+  return &m_arena->buffer[end];
+}
+
+void
+Name::pushArenaComponent(uint32_t type, size_t begin, size_t valueBegin, size_t end) const
+{
+  const Buffer& buffer = m_arena->buffer;
+  m_nameBlock.push_back(Block(ConstBufferPtr(m_arena, &buffer), type,
+                              buffer.begin() + begin, buffer.begin() + end,
+                              buffer.begin() + valueBegin, buffer.begin() + end));
+}
+
+void
+Name::appendComponent(uint32_t type, const uint8_t* value, size_t valueLength)
+{
+  size_t size = tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength) + valueLength;
+
+  Block oldBlock;
+  uint8_t* pos = claimArena(size, oldBlock);
+  uint8_t* valuePos = writeVarNumber(writeVarNumber(pos, type), valueLength);
+  if (valueLength > 0) {
+    std::memcpy(valuePos, value, valueLength);
+  }
+
+  const uint8_t* base = m_arena->buffer.data();
+  pushArenaComponent(type, pos - base, valuePos - base, valuePos + valueLength - base);
+}
+
+void
+Name::appendComponents(const_iterator first, const_iterator last)
+{
+  size_t size = 0;
+  for (const_iterator i = first; i != last; ++i) {
+    size += sizeOfComponent(*i);
+  }
+
+  // components of this name are accessed by index, because appending invalidates iterators
+  bool isSelf = !empty() && first >= begin() && first < end();
+  size_t selfOffset = isSelf ? first - begin() : 0;
+  size_t nComponents = last - first;
+
+  Block oldBlock;
+  uint8_t* pos = claimArena(size, oldBlock);
+  const uint8_t* base = m_arena->buffer.data();
+  for (size_t i = 0; i < nComponents; ++i) {
+    const Component& component = isSelf ? get(selfOffset + i) : first[i];
+    uint32_t type = component.type();
+    size_t valueLength = component.value_size();
+
+    size_t begin = pos - base;
+    pos = writeVarNumber(writeVarNumber(pos, type), valueLength);
+    size_t valueBegin = pos - base;
+    if (valueLength > 0) {
+      std::memcpy(pos, component.value(), valueLength);
+      pos += valueLength;
+    }
+    pushArenaComponent(type, begin, valueBegin, pos - base);
+  }
+}
+
+void
+Name::appendNumberComponent(const uint8_t* marker, uint64_t number)
+{
+  size_t valueLength = (marker == nullptr ? 0 : 1) + sizeOfNonNegativeInteger(number);
+  size_t size = tlv::sizeOfVarNumber(tlv::NameComponent) + tlv::sizeOfVarNumber(valueLength) +
+                valueLength;
+
+  Block oldBlock;
+  uint8_t* pos = claimArena(size, oldBlock);
+  uint8_t* valuePos = writeVarNumber(writeVarNumber(pos, tlv::NameComponent), valueLength);
+  uint8_t* numberPos = valuePos;
+  if (marker != nullptr) {
+    *numberPos++ = *marker;
+  }
+  writeNonNegativeInteger(numberPos, number);
+
+  const uint8_t* base = m_arena->buffer.data();
+  pushArenaComponent(tlv::NameComponent, pos - base, valuePos - base,
+                     valuePos + valueLength - base);
 }
 
 std::string
@@ -178,12 +436,8 @@ Name::toUri() const
 Name&
 Name::append(const PartialName& name)
 {
-  if (&name == this)
-    // Copying from this name, so need to make a copy first.
-    return append(PartialName(name));
-
-  for (size_t i = 0; i < name.size(); ++i)
-    append(name.at(i));
+  if (!name.empty())
+    appendComponents(name.begin(), name.end());
 
   return *this;
 }
@@ -191,22 +445,21 @@ Name::append(const PartialName& name)
 Name&
 Name::appendNumber(uint64_t number)
 {
-  m_nameBlock.push_back(Component::fromNumber(number));
+  appendNumberComponent(nullptr, number);
   return *this;
 }
 
 Name&
 Name::appendNumberWithMarker(uint8_t marker, uint64_t number)
 {
-  m_nameBlock.push_back(Component::fromNumberWithMarker(marker, number));
+  appendNumberComponent(&marker, number);
   return *this;
 }
 
 Name&
 Name::appendVersion(uint64_t version)
 {
-  m_nameBlock.push_back(Component::fromVersion(version));
-  return *this;
+  return appendNumberWithMarker(name::VERSION_MARKER, version);
 }
 
 Name&
@@ -219,43 +472,39 @@ Name::appendVersion()
 Name&
 Name::appendSegment(uint64_t segmentNo)
 {
-  m_nameBlock.push_back(Component::fromSegment(segmentNo));
-  return *this;
+  return appendNumberWithMarker(name::SEGMENT_MARKER, segmentNo);
 }
 
 Name&
 Name::appendSegmentOffset(uint64_t offset)
 {
-  m_nameBlock.push_back(Component::fromSegmentOffset(offset));
-  return *this;
+  return appendNumberWithMarker(name::SEGMENT_OFFSET_MARKER, offset);
 }
 
 Name&
 Name::appendTimestamp(const time::system_clock::TimePoint& timePoint)
 {
-  m_nameBlock.push_back(Component::fromTimestamp(timePoint));
-  return *this;
+  uint64_t value = time::duration_cast<time::microseconds>(timePoint -
+                                                           time::getUnixEpoch()).count();
+  return appendNumberWithMarker(name::TIMESTAMP_MARKER, value);
 }
 
 Name&
 Name::appendSequenceNumber(uint64_t seqNo)
 {
-  m_nameBlock.push_back(Component::fromSequenceNumber(seqNo));
-  return *this;
+  return appendNumberWithMarker(name::SEQUENCE_NUMBER_MARKER, seqNo);
 }
 
 Name&
 Name::appendImplicitSha256Digest(const ConstBufferPtr& digest)
 {
-  m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest));
-  return *this;
+  return append(Component::fromImplicitSha256Digest(digest));
 }
 
 Name&
 Name::appendImplicitSha256Digest(const uint8_t* digest, size_t digestSize)
 {
-  m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest, digestSize));
-  return *this;
+  return append(Component::fromImplicitSha256Digest(digest, digestSize));
 }
 
 PartialName
@@ -271,8 +520,8 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
   if (nComponents != npos)
     iEnd = std::min(this->size(), iStart + nComponents);
 
-  for (size_t i = iStart; i < iEnd; ++i)
-    result.append(at(i));
+  if (static_cast<size_t>(iStart) < iEnd)
+    result.appendComponents(begin() + iStart, begin() + iEnd);
 
   return result;
 }
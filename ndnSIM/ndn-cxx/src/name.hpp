@@ -42,6 +42,14 @@ typedef Name PartialName;
 
 /**
  * @brief Name abstraction to represent an absolute name
+ *
+ * Components appended to a Name are encoded directly into a wire buffer (arena) owned by the
+ * name, with room reserved for the Name TLV header in front of them.  Name components are
+ * views into this buffer, so that building a name from several components and encoding it
+ * usually needs a single memory allocation and no copying.  Copies of a name share the arena;
+ * the first copy that appends a component extends the arena in place, and other copies move
+ * to a new arena when they append.  Likewise, the TLV header is written only once per arena,
+ * so encoding a name again after appending to it moves the name to a new arena.
  */
 class Name : public enable_shared_from_this<Name>
 {
@@ -139,7 +147,7 @@ public:
   Name&
   append(const uint8_t* value, size_t valueLength)
   {
-    m_nameBlock.push_back(Component(value, valueLength));
+    appendComponent(tlv::NameComponent, value, valueLength);
     return *this;
   }
 
@@ -156,8 +164,7 @@ public:
   Name&
   append(Iterator first, Iterator last)
   {
-    m_nameBlock.push_back(Component(first, last));
-    return *this;
+    return append(Component(first, last));
   }
 
   /**
@@ -166,7 +173,7 @@ public:
   Name&
   append(const Component& value)
   {
-    m_nameBlock.push_back(value);
+    appendComponent(value.type(), value.value(), value.value_size());
     return *this;
   }
 
@@ -180,7 +187,8 @@ public:
   Name&
   append(const char* value)
   {
-    m_nameBlock.push_back(Component(value));
+    appendComponent(tlv::NameComponent, reinterpret_cast<const uint8_t*>(value),
+                    std::char_traits<char>::length(value));
     return *this;
   }
 
@@ -188,9 +196,9 @@ public:
   append(const Block& value)
   {
     if (value.type() == tlv::NameComponent)
-      m_nameBlock.push_back(value);
+      appendComponent(tlv::NameComponent, value.value(), value.value_size());
     else
-      m_nameBlock.push_back(Block(tlv::NameComponent, value));
+      appendComponent(tlv::NameComponent, value.wire(), value.size());
 
     return *this;
   }
@@ -210,6 +218,7 @@ public:
   clear()
   {
     m_nameBlock = Block(tlv::Name);
+    m_arena.reset();
   }
 
   /**
@@ -604,8 +613,63 @@ public:
    */
   static const size_t npos;
 
+private:
+  struct Arena;
+
+  /**
+   * @brief Append a component of @p type with value [@p value, @p value + @p valueLength)
+   */
+  void
+  appendComponent(uint32_t type, const uint8_t* value, size_t valueLength);
+
+  /**
+   * @brief Append components [@p first, @p last) of another name (or of this name)
+   */
+  void
+  appendComponents(const_iterator first, const_iterator last);
+
+  /**
+   * @brief Append a generic component with optional @p marker octet followed by @p number
+   *        encoded as nonNegativeInteger
+   */
+  void
+  appendNumberComponent(const uint8_t* marker, uint64_t number);
+
+  /**
+   * @brief Claim @p nOctets at the end of components in the arena, moving the components to a
+   *        new arena if this name cannot extend the current one
+   * @param[out] oldBlock receives the previous name block when components are moved, so that
+   *             octets being appended from this name stay valid until they are copied
+   * @return pointer to the claimed octets
+   */
+  uint8_t*
+  claimArena(size_t nOctets, Block& oldBlock) const;
+
+  /**
+   * @brief Move components into a new arena with space for @p nOctets more octets
+   * @param withSlack whether to reserve extra space for future appends
+   */
+  void
+  moveToNewArena(size_t nOctets, bool withSlack) const;
+
+  /**
+   * @brief Get offset of the end of components in the arena
+   * @pre m_arena != nullptr
+   */
+  size_t
+  getArenaEnd() const;
+
+  void
+  pushArenaComponent(uint32_t type, size_t begin, size_t valueBegin, size_t end) const;
+
 private:
   mutable Block m_nameBlock;
+
+  /**
+   * @brief Wire buffer in which all components are stored contiguously, or nullptr if
+   *        components are located elsewhere (e.g., in a decoded packet)
+   */
+  mutable shared_ptr<Arena> m_arena;
 };
 
 std::ostream&
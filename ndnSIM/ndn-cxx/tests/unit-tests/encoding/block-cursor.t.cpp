@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/block-cursor.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingBlockCursor)
+
+static const uint8_t BUFFER[] = {
+  0x05, 0x0c, // Interest
+        0x07, 0x05, // Name
+              0x08, 0x03, // NameComponent
+                    0x61, 0x62, 0x63,
+        0x0a, 0x00, // Nonce (empty)
+        0x0c, 0x01, // InterestLifetime
+              0x64,
+};
+
+BOOST_AUTO_TEST_CASE(Iterate)
+{
+  Block block(BUFFER, sizeof(BUFFER));
+  BlockCursor cursor(block);
+
+  BOOST_REQUIRE(cursor.next());
+  BOOST_CHECK_EQUAL(cursor.type(), tlv::Name);
+  BOOST_CHECK_EQUAL(cursor.value_size(), 5);
+  BOOST_CHECK(cursor.begin() == block.value_begin());
+  BOOST_CHECK(cursor.value() == block.value() + 2);
+
+  BlockCursor component = BlockCursor::fromCurrent(cursor);
+  BOOST_REQUIRE(component.next());
+  BOOST_CHECK_EQUAL(component.type(), tlv::NameComponent);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(component.value()),
+                                component.value_size()), "abc");
+  BOOST_CHECK(!component.next());
+
+  BOOST_REQUIRE(cursor.next());
+  BOOST_CHECK_EQUAL(cursor.type(), tlv::Nonce);
+  BOOST_CHECK_EQUAL(cursor.value_size(), 0);
+
+  BOOST_REQUIRE(cursor.next());
+  BOOST_CHECK_EQUAL(cursor.type(), tlv::InterestLifetime);
+  BOOST_CHECK_EQUAL(cursor.readNonNegativeInteger(), 100);
+  BOOST_CHECK(!cursor.next());
+  BOOST_CHECK(!cursor.next());
+
+  // iteration does not create sub elements
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Materialize)
+{
+  Block block(BUFFER, sizeof(BUFFER));
+  BlockCursor cursor(block);
+  BOOST_REQUIRE(cursor.next());
+
+  Block name = cursor.block();
+  BOOST_CHECK_EQUAL(name.type(), tlv::Name);
+  BOOST_CHECK(name.getBuffer() == block.getBuffer());
+  BOOST_CHECK(name.begin() == cursor.begin());
+  BOOST_CHECK(name.end() == cursor.end());
+
+  block.parse();
+  BOOST_CHECK(name == block.elements().front());
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  static const uint8_t TRUNCATED[] = {
+    0x05, 0x04, // Interest
+          0x07, 0x05, // Name, TLV-LENGTH exceeds the remaining value
+                0x08, 0x00,
+  };
+
+  Block block(TRUNCATED, sizeof(TRUNCATED));
+  BlockCursor cursor(block);
+  BOOST_CHECK_THROW(cursor.next(), tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // EncodingBlockCursor
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/buffer-pool.hpp"
+#include "encoding/block-helpers.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "data.hpp"
+#include "interest.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+class BufferPoolFixture
+{
+public:
+  BufferPoolFixture()
+  {
+    BufferPool::clear();
+  }
+
+  ~BufferPoolFixture()
+  {
+    BufferPool::clear();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(EncodingBufferPool, BufferPoolFixture)
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  BufferPool::Statistics before = BufferPool::getStatistics();
+
+  const uint8_t* memory = nullptr;
+  {
+    BufferPtr buffer = BufferPool::allocate(100);
+    BOOST_CHECK_EQUAL(buffer->size(), 100);
+    memory = buffer->buf();
+  }
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, 1);
+
+  // same size class
+  BufferPtr buffer = BufferPool::allocate(200);
+  BOOST_CHECK_EQUAL(buffer->size(), 200);
+  BOOST_CHECK(buffer->buf() == memory);
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, 0);
+
+  // another size class
+  BufferPtr other = BufferPool::allocate(1000);
+  BOOST_CHECK(other->buf() != memory);
+
+  BufferPool::Statistics after = BufferPool::getStatistics();
+  BOOST_CHECK_EQUAL(after.nAllocations - before.nAllocations, 3);
+  BOOST_CHECK_EQUAL(after.nReuses - before.nReuses, 1);
+}
+
+BOOST_AUTO_TEST_CASE(NotPooled)
+{
+  size_t largest = BufferPool::SIZE_CLASSES[BufferPool::N_SIZE_CLASSES - 1];
+  {
+    BufferPtr buffer = BufferPool::allocate(largest + 1);
+    BOOST_CHECK_EQUAL(buffer->size(), largest + 1);
+  }
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(MaxFreeBuffers)
+{
+  {
+    std::vector<BufferPtr> buffers;
+    for (size_t i = 0; i < BufferPool::MAX_FREE_BUFFERS + 10; ++i) {
+      buffers.push_back(BufferPool::allocate(10));
+    }
+  }
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, BufferPool::MAX_FREE_BUFFERS);
+}
+
+BOOST_AUTO_TEST_CASE(BlockReturnsBuffer)
+{
+  static const uint8_t value[] = {0x01, 0x02, 0x03};
+
+  Block block;
+  {
+    EncodingBuffer encoder(100, 0);
+    encoder.prependByteArrayBlock(0x81, value, sizeof(value));
+    block = encoder.block();
+  }
+  // the block keeps the buffer
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, 0);
+  BOOST_CHECK_EQUAL(block.value_size(), sizeof(value));
+
+  block = Block();
+  BOOST_CHECK_EQUAL(BufferPool::getStatistics().nFreeBuffers, 1);
+}
+
+BOOST_AUTO_TEST_CASE(PacketWireIsCopied)
+{
+  // every buffer taken from the (empty) pool since the start is back: none is pinned by a wire
+  BufferPool::Statistics before = BufferPool::getStatistics();
+  auto isNothingPinned = [&before] {
+    BufferPool::Statistics statistics = BufferPool::getStatistics();
+    return statistics.nFreeBuffers == (statistics.nAllocations - before.nAllocations) -
+                                      (statistics.nReuses - before.nReuses);
+  };
+
+  Data data("/A");
+  data.setContent(std::vector<uint8_t>(100, 0xAA).data(), 100);
+  data.setSignature(Signature(SignatureInfo(tlv::DigestSha256),
+                              makeEmptyBlock(tlv::SignatureValue)));
+  const Block& dataWire = data.wireEncode();
+  // encoded in a pooled buffer, but kept in a buffer of the exact size
+  BOOST_CHECK_EQUAL(dataWire.getBuffer()->size(), dataWire.size());
+  BOOST_CHECK(isNothingPinned());
+
+  Interest interest("/A");
+  interest.setNonce(1);
+  const Block& interestWire = interest.wireEncode();
+  BOOST_CHECK_EQUAL(interestWire.getBuffer()->size(), interestWire.size());
+  BOOST_CHECK(isNothingPinned());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // EncodingBufferPool
+
+} // namespace tests
+} // namespace ndn
@@ -24,6 +24,8 @@
 #include "boost-test.hpp"
 #include <boost/iostreams/stream.hpp>
 
+#include <list>
+
 namespace ndn {
 namespace tlv {
 namespace tests {
@@ -275,6 +277,40 @@ BOOST_AUTO_TEST_CASE(ReadFromStream)
   }
 }
 
+BOOST_AUTO_TEST_CASE(ReadFromNonContiguous)
+{
+  std::list<uint8_t> buffer(BUFFER, BUFFER + sizeof(BUFFER));
+  std::list<uint8_t>::const_iterator begin = buffer.begin();
+  std::list<uint8_t>::const_iterator end = buffer.end();
+
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end), 1);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end), 252);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end), 253);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end), 65536);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end), 4294967296LL);
+  BOOST_CHECK(begin == end);
+
+  buffer.pop_back();
+  begin = std::next(buffer.begin(), 10);
+  end = buffer.end();
+  uint64_t value;
+  BOOST_CHECK_EQUAL(readVarNumber(begin, end, value), false);
+}
+
+BOOST_AUTO_TEST_CASE(ReadFromVector)
+{
+  std::vector<uint8_t> buffer(BUFFER, BUFFER + sizeof(BUFFER));
+  std::vector<uint8_t>::const_iterator begin = buffer.begin();
+
+  BOOST_CHECK_EQUAL(readVarNumber(begin, buffer.cend()), 1);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, buffer.cend()), 252);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, buffer.cend()), 253);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, buffer.cend()), 65536);
+  BOOST_CHECK_EQUAL(readVarNumber(begin, buffer.cend()), 4294967296LL);
+  BOOST_CHECK(begin == buffer.cend());
+  BOOST_CHECK_THROW(readVarNumber(begin, buffer.cend()), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // VarNumber
 
 BOOST_AUTO_TEST_SUITE(NonNegativeInteger)
@@ -407,6 +443,20 @@ BOOST_AUTO_TEST_CASE(ReadFromStream)
   }
 }
 
+BOOST_AUTO_TEST_CASE(ReadFromNonContiguous)
+{
+  std::list<uint8_t> buffer(BUFFER, BUFFER + sizeof(BUFFER));
+  std::list<uint8_t>::const_iterator begin = buffer.begin();
+  std::list<uint8_t>::const_iterator end = buffer.end();
+
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(1, begin, end), 1);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(2, begin, end), 257);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(4, begin, end), 16843009LL);
+  BOOST_CHECK_THROW(readNonNegativeInteger(3, begin, end), Error);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(8, begin, end), 72340172838076673LL);
+  BOOST_CHECK_THROW(readNonNegativeInteger(1, begin, end), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // NonNegativeInteger
 
 BOOST_AUTO_TEST_SUITE_END() // EncodingTlv
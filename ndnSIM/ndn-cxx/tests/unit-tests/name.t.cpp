@@ -115,6 +115,65 @@ BOOST_AUTO_TEST_CASE(AppendsAndMultiEncode)
                                 TestName, TestName+sizeof(TestName));
 }
 
+BOOST_AUTO_TEST_CASE(AppendAfterEncode)
+{
+  Name name("/local/ndn");
+  Block oldWire = name.wireEncode();
+
+  name.append("prefix");
+  BOOST_CHECK_EQUAL_COLLECTIONS(name.wireEncode().begin(), name.wireEncode().end(),
+                                TestName, TestName + sizeof(TestName));
+  // the header of the previous encoding must not be overwritten
+  BOOST_CHECK_EQUAL_COLLECTIONS(oldWire.begin(), oldWire.end(), Name2, Name2 + sizeof(Name2));
+
+  Block nameBlock(TestName, sizeof(TestName));
+  Name decoded(nameBlock);
+  decoded.append("suffix");
+  BOOST_CHECK_EQUAL(decoded, "/local/ndn/prefix/suffix");
+  BOOST_CHECK_EQUAL(nameBlock.value_size(), 0x14);
+}
+
+BOOST_AUTO_TEST_CASE(SharedArena)
+{
+  Name n1("/local/ndn");
+  Name n2 = n1;
+  Name n3 = n1;
+  n1.append("prefix");
+  n2.append("other");
+  n3.appendSegment(5);
+
+  BOOST_CHECK_EQUAL(n1, "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(n2, "/local/ndn/other");
+  BOOST_CHECK_EQUAL(n3, Name("/local/ndn").appendSegment(5));
+  BOOST_CHECK(n1.wireEncode() == Name("/local/ndn/prefix").wireEncode());
+  BOOST_CHECK(n2.wireEncode() == Name("/local/ndn/other").wireEncode());
+
+  // an encoded copy does not change when another copy is encoded after appending
+  Name n4("/local/ndn");
+  Name n5 = n4;
+  Block wire4 = n4.wireEncode();
+  n5.append("prefix");
+  n5.wireEncode();
+  n4.append("other");
+  BOOST_CHECK(wire4 == Name("/local/ndn").wireEncode());
+  BOOST_CHECK_EQUAL_COLLECTIONS(n5.wireEncode().begin(), n5.wireEncode().end(),
+                                TestName, TestName + sizeof(TestName));
+  BOOST_CHECK_EQUAL(n4, "/local/ndn/other");
+}
+
+BOOST_AUTO_TEST_CASE(AppendOwnComponent)
+{
+  Name name("/hello/world");
+  for (int i = 0; i < 20; ++i) {
+    name.append(name[0]);
+  }
+  BOOST_CHECK_EQUAL(name.size(), 22);
+  BOOST_CHECK_EQUAL(name[-1], name::Component("hello"));
+
+  name.append(name.getSubName(1, 1));
+  BOOST_CHECK_EQUAL(name[-1], name::Component("world"));
+}
+
 BOOST_AUTO_TEST_CASE(ZeroLengthComponent)
 {
   static const uint8_t compOctets[] {0x08, 0x00};
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-route-install-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * This benchmark measures the wall-clock time of installing routes computed by
+ * ndn::GlobalRoutingHelper into the FIBs of N x N grid topologies, where every node originates
+ * its own prefix (i.e., V * (V - 1) routes for V nodes).
+ *
+ * For each topology size it reports:
+ * - time of GlobalRoutingHelper::CalculateRoutes (route computation and installation);
+ * - time to install the same routes with one FIB management command per route
+ *   (FibHelper::AddRoute), including the simulator events that process the commands;
+ * - time to install the same routes with one batch per node (FibHelper::AddRoutes).
+ *
+ *     ./waf --run="ndn-route-install-benchmark --max-size=16"
+ */
+
+static double
+getRealTime()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+typedef std::vector<std::pair<Ptr<Node>, std::vector<ndn::FibHelper::Route>>> RouteSnapshot;
+
+/**
+ * @brief Record the current FIB contents of all nodes and clear the FIBs
+ */
+static RouteSnapshot
+takeRoutes(size_t& nRoutes)
+{
+  RouteSnapshot snapshot;
+  nRoutes = 0;
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nfd::Fib& fib = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+
+    std::vector<ndn::FibHelper::Route> routes;
+    std::vector<ndn::Name> prefixes;
+    for (const nfd::fib::Entry& entry : fib) {
+      if (ndn::Name("/localhost").isPrefixOf(entry.getPrefix())) {
+        continue;
+      }
+      prefixes.push_back(entry.getPrefix());
+      for (const nfd::fib::NextHop& nexthop : entry.getNextHops()) {
+        routes.push_back({entry.getPrefix(), nexthop.getFace().shared_from_this(),
+                          static_cast<int32_t>(nexthop.getCost())});
+      }
+    }
+
+    for (const ndn::Name& prefix : prefixes) {
+      fib.erase(prefix);
+    }
+
+    nRoutes += routes.size();
+    snapshot.push_back(std::make_pair(*node, std::move(routes)));
+  }
+
+  return snapshot;
+}
+
+static void
+runTopology(uint32_t size)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(size, size, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string((*node)->GetId()), *node);
+  }
+
+  double begin = getRealTime();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  double calculateTime = getRealTime() - begin;
+
+  size_t nRoutes = 0;
+  RouteSnapshot snapshot = takeRoutes(nRoutes);
+
+  begin = getRealTime();
+  for (const auto& node : snapshot) {
+    for (const ndn::FibHelper::Route& route : node.second) {
+      ndn::FibHelper::AddRoute(node.first, route.prefix, route.face, route.metric);
+    }
+  }
+  // management commands are processed by simulator events
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  double commandTime = getRealTime() - begin;
+
+  size_t nCommandRoutes = 0;
+  snapshot = takeRoutes(nCommandRoutes);
+
+  begin = getRealTime();
+  for (const auto& node : snapshot) {
+    ndn::FibHelper::AddRoutes(node.first, node.second);
+  }
+  double bulkTime = getRealTime() - begin;
+
+  size_t nBulkRoutes = 0;
+  takeRoutes(nBulkRoutes);
+
+  std::cout << size * size << "\t" << nRoutes << "\t" << calculateTime << "\t" << commandTime
+            << "\t" << bulkTime;
+  if (nCommandRoutes != nRoutes || nBulkRoutes != nRoutes) {
+    std::cout << "\tMISMATCH " << nCommandRoutes << " " << nBulkRoutes;
+  }
+  std::cout << std::endl;
+
+  Simulator::Destroy();
+  Names::Clear();
+  ndn::GlobalRouter::clear();
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+
+  uint32_t maxSize = 16;
+
+  CommandLine cmd;
+  cmd.AddValue("max-size", "Largest grid side length (the grid has max-size^2 nodes)", maxSize);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Nodes\tRoutes\tCalculateRoutes\tAddRoute\tAddRoutes" << std::endl;
+  for (uint32_t size = 2; size <= maxSize; size *= 2) {
+    runTopology(size);
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
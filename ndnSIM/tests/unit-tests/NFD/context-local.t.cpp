@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/core/context-local.hpp"
+#include "ns3/ndnSIM/NFD/core/random.hpp"
+#include "ns3/ndnSIM/NFD/core/scheduler.hpp"
+
+#include "ns3/rng-seed-manager.h"
+
+#include "../tests-common.hpp"
+
+#include <thread>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(NfdContextLocal, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(InstancePerContext)
+{
+  nfd::ContextLocal<uint32_t> values([] (uint32_t context) { return new uint32_t(context); });
+
+  uint32_t* instance = &values.get(5);
+  BOOST_CHECK_EQUAL(*instance, 5);
+  BOOST_CHECK_EQUAL(&values.get(5), instance);
+
+  BOOST_CHECK_EQUAL(values.get(1000), 1000); // grows the table
+  BOOST_CHECK_EQUAL(&values.get(5), instance);
+  const uint32_t noContext = Simulator::NO_CONTEXT;
+  BOOST_CHECK_EQUAL(values.get(noContext), noContext);
+
+  size_t nInstances = 0;
+  values.forEach([&nInstances] (uint32_t&) { ++nInstances; });
+  BOOST_CHECK_EQUAL(nInstances, 3);
+
+  values.reset();
+  nInstances = 0;
+  values.forEach([&nInstances] (uint32_t&) { ++nInstances; });
+  BOOST_CHECK_EQUAL(nInstances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentGet)
+{
+  nfd::ContextLocal<uint32_t> values([] (uint32_t context) { return new uint32_t(context); });
+  const uint32_t nContexts = 1000;
+
+  std::vector<std::vector<uint32_t*>> results(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&values, &results, i, nContexts] {
+        for (uint32_t context = 0; context < nContexts; ++context) {
+          results[i].push_back(&values.get(context));
+        }
+      });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 1; i < results.size(); ++i) {
+    BOOST_CHECK(results[i] == results[0]);
+  }
+  for (uint32_t context = 0; context < nContexts; ++context) {
+    BOOST_CHECK_EQUAL(*results[0][context], context);
+  }
+}
+
+static void
+drawValues(std::vector<uint32_t>* values)
+{
+  for (int i = 0; i < 4; ++i) {
+    values->push_back(nfd::getGlobalRng()());
+  }
+}
+
+static std::vector<uint32_t>
+drawInContext(uint32_t context)
+{
+  std::vector<uint32_t> values;
+  Simulator::ScheduleWithContext(context, Seconds(0), &drawValues, &values);
+  Simulator::Run();
+  return values;
+}
+
+BOOST_AUTO_TEST_CASE(RngReproducible)
+{
+  uint32_t seed = RngSeedManager::GetSeed();
+  uint64_t run = RngSeedManager::GetRun();
+
+  RngSeedManager::SetSeed(3);
+  RngSeedManager::SetRun(7);
+  nfd::resetGlobalRng();
+  std::vector<uint32_t> node1 = drawInContext(1);
+  std::vector<uint32_t> node2 = drawInContext(2);
+  BOOST_CHECK(node1 != node2);
+
+  // the same seed and run give the same streams, regardless of which node uses its RNG first
+  nfd::resetGlobalRng();
+  std::vector<uint32_t> node2Again = drawInContext(2);
+  std::vector<uint32_t> node1Again = drawInContext(1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(node1Again.begin(), node1Again.end(), node1.begin(), node1.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(node2Again.begin(), node2Again.end(), node2.begin(), node2.end());
+
+  RngSeedManager::SetRun(8);
+  nfd::resetGlobalRng();
+  BOOST_CHECK(drawInContext(1) != node1);
+
+  RngSeedManager::SetSeed(seed);
+  RngSeedManager::SetRun(run);
+  nfd::resetGlobalRng();
+}
+
+static void
+scheduleEvent(nfd::scheduler::EventId* eventId, bool* hasFired)
+{
+  *eventId = nfd::scheduler::schedule(::ndn::time::milliseconds(10), [hasFired] {
+      *hasFired = true;
+    });
+}
+
+static void
+cancelEvent(nfd::scheduler::EventId* eventId, uint32_t* eventContext)
+{
+  *eventContext = (*eventId)->GetContext();
+  nfd::scheduler::cancel(*eventId);
+}
+
+BOOST_AUTO_TEST_CASE(CancelFromAnotherContext)
+{
+  nfd::scheduler::EventId event1;
+  nfd::scheduler::EventId event2;
+  bool hasFired1 = false;
+  bool hasFired2 = false;
+  uint32_t eventContext = Simulator::NO_CONTEXT;
+
+  Simulator::ScheduleWithContext(1, Seconds(0), &scheduleEvent, &event1, &hasFired1);
+  Simulator::ScheduleWithContext(2, Seconds(0), &scheduleEvent, &event2, &hasFired2);
+  // node 2 cancels the event of node 1, which is handled by the scheduler of node 1
+  Simulator::ScheduleWithContext(2, MilliSeconds(5), &cancelEvent, &event1, &eventContext);
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(eventContext, 1);
+  BOOST_CHECK(!hasFired1);
+  BOOST_CHECK(hasFired2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerZipfMandelbrot, CleanupFixture)
+
+static Ptr<ConsumerZipfMandelbrot>
+makeConsumer(uint32_t n, double q, double s)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", UintegerValue(n));
+  consumer->SetAttribute("q", DoubleValue(q));
+  consumer->SetAttribute("s", DoubleValue(s));
+  return consumer;
+}
+
+BOOST_AUTO_TEST_CASE(SharedTable)
+{
+  Ptr<ConsumerZipfMandelbrot> a = makeConsumer(1000, 0.7, 0.7);
+  Ptr<ConsumerZipfMandelbrot> b = makeConsumer(1000, 0.7, 0.7);
+  Ptr<ConsumerZipfMandelbrot> c = makeConsumer(1000, 0.7, 0.9);
+
+  std::weak_ptr<const std::vector<double>> shared = a->GetCumulativeProbabilities();
+  BOOST_CHECK(b->GetCumulativeProbabilities() == shared.lock());
+  BOOST_CHECK(c->GetCumulativeProbabilities() != shared.lock());
+  BOOST_CHECK_EQUAL(shared.lock()->size(), 1001);
+
+  a = 0;
+  BOOST_CHECK(!shared.expired());
+
+  b = 0;
+  BOOST_CHECK(shared.expired());
+
+  // a new consumer recomputes the table after the last user is gone
+  Ptr<ConsumerZipfMandelbrot> d = makeConsumer(1000, 0.7, 0.7);
+  BOOST_CHECK(d->GetCumulativeProbabilities() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SameSequenceAsLinearScan)
+{
+  const uint32_t n = 500;
+  const double q = 0.7;
+  const double s = 0.9;
+  const int64_t stream = 42;
+
+  Ptr<ConsumerZipfMandelbrot> consumer = makeConsumer(n, q, s);
+  consumer->AssignStreams(stream);
+
+  // reference: the table and the linear scan used before tables were shared
+  std::vector<double> pcum(n + 1);
+  pcum[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    pcum[i] = pcum[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+  for (uint32_t i = 1; i <= n; i++) {
+    pcum[i] = pcum[i] / pcum[n];
+  }
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+  rng->SetStream(stream);
+
+  for (int k = 0; k < 10000; ++k) {
+    double pRandom = rng->GetValue();
+    while (pRandom == 0) {
+      pRandom = rng->GetValue();
+    }
+
+    uint32_t expected = 1;
+    for (uint32_t i = 1; i <= n; i++) {
+      if (pRandom <= pcum[i]) {
+        expected = i;
+        break;
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL(consumer->GetNextSeq(), expected);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -53,6 +54,34 @@ public:
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
   }
+
+  /**
+   * @return costs of next hops of FIB entry @p prefix on @p nodeName, keyed by next hop node
+   */
+  std::map<std::string, uint64_t>
+  getNextHopCosts(const std::string& nodeName, const Name& prefix)
+  {
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    auto entry = node->GetObject<L3Protocol>()->getForwarder()->getFib().findExactMatch(prefix);
+
+    std::map<std::string, uint64_t> costs;
+    if (entry == nullptr) {
+      return costs;
+    }
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      if (transport == nullptr) {
+        continue;
+      }
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      Ptr<Node> otherNode = channel->GetDevice(0)->GetNode();
+      if (otherNode == node) {
+        otherNode = channel->GetDevice(1)->GetNode();
+      }
+      costs[Names::FindName(otherNode)] = nextHop.getCost();
+    }
+    return costs;
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingHelper, GlobalRoutingHelperFixture)
@@ -147,6 +176,111 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+  ndn::GlobalRoutingHelper::SetThreads(2);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  ndn::GlobalRoutingHelper::SetThreads(0);
+
+  // direct link, and the path through B3
+  std::map<std::string, uint64_t> costs = getNextHopCosts("A3", "/prefix");
+  BOOST_CHECK_EQUAL(costs.size(), 2);
+  BOOST_CHECK_EQUAL(costs["C3"], 50);
+  BOOST_CHECK_EQUAL(costs["B3"], 101);
+
+  // B3 reaches C3 directly, and through A3
+  BOOST_CHECK_EQUAL(getNextHopCosts("B3", "/prefix").size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalUpdates)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n"
+        << "D4  NA  120  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    100 1ms 100\n"
+        << "A4      C4  10Mbps    50  1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n"
+        << "C4      D4  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndnGlobalRoutingHelper.AddOrigins("/other", Names::Find<Node>("D4"));
+  ndn::GlobalRoutingHelper::SetIncrementalUpdates(true);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  std::map<std::string, uint64_t> expected{{"C4", 50}};
+  BOOST_CHECK(getNextHopCosts("A4", "/prefix") == expected);
+  expected = {{"C4", 51}};
+  BOOST_CHECK(getNextHopCosts("A4", "/other") == expected);
+
+  LinkControlHelper::FailLinkByName("A4", "C4");
+  expected = {{"B4", 101}};
+  BOOST_CHECK(getNextHopCosts("A4", "/prefix") == expected);
+  expected = {{"B4", 102}};
+  BOOST_CHECK(getNextHopCosts("A4", "/other") == expected);
+  expected = {{"C4", 1}};
+  BOOST_CHECK(getNextHopCosts("B4", "/prefix") == expected);
+
+  LinkControlHelper::FailLinkByName("B4", "C4");
+  BOOST_CHECK(getNextHopCosts("A4", "/prefix").empty());
+  BOOST_CHECK(getNextHopCosts("B4", "/other").empty());
+
+  LinkControlHelper::UpLinkByName("A4", "C4");
+  LinkControlHelper::UpLinkByName("B4", "C4");
+  expected = {{"C4", 50}};
+  BOOST_CHECK(getNextHopCosts("A4", "/prefix") == expected);
+  expected = {{"C4", 51}};
+  BOOST_CHECK(getNextHopCosts("A4", "/other") == expected);
+  expected = {{"C4", 1}};
+  BOOST_CHECK(getNextHopCosts("B4", "/prefix") == expected);
+
+  ndn::GlobalRoutingHelper::SetIncrementalUpdates(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
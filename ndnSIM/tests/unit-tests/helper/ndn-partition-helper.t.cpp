@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-partition-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-global-router.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/names.h"
+
+#include "../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_PARTITION_TOPO_TXT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partition-topo.txt";
+
+class PartitionHelperFixture : public CleanupFixture
+{
+public:
+  PartitionHelperFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // chain A-B-C-D, where B-C has the largest delay
+    std::ofstream file(TEST_PARTITION_TOPO_TXT.string().c_str());
+    file << "router\n\n"
+         << "#node city  y x mpi-partition\n"
+         << "A  NA  0  0  0\n"
+         << "B  NA  0  10 0\n"
+         << "C  NA  0  20 0\n"
+         << "D  NA  0  30 0\n\n"
+         << "link\n\n"
+         << "# from  to  capacity  metric  delay queue\n"
+         << "A       B   10Mbps    3       1ms   100\n"
+         << "B       C   10Mbps    7       10ms  100\n"
+         << "C       D   10Mbps    5       1ms   100\n";
+  }
+
+  ~PartitionHelperFixture()
+  {
+    boost::filesystem::remove(TEST_PARTITION_TOPO_TXT);
+  }
+
+  uint32_t
+  getSystemId(const std::string& nodeName)
+  {
+    return Names::Find<Node>(nodeName)->GetSystemId();
+  }
+
+  Ptr<GlobalRouter>
+  getGlobalRouter(const std::string& nodeName)
+  {
+    return Names::Find<Node>(nodeName)->GetObject<GlobalRouter>();
+  }
+
+  /**
+   * @return metrics of edges of @p nodeName, keyed by the GlobalRouter of the other node
+   */
+  std::map<Ptr<GlobalRouter>, uint16_t>
+  getEdgeMetrics(const std::string& nodeName)
+  {
+    std::map<Ptr<GlobalRouter>, uint16_t> metrics;
+    for (const auto& incidency : getGlobalRouter(nodeName)->GetIncidencies()) {
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      metrics[std::get<2>(incidency)] = face != nullptr ? face->getMetric() : std::get<3>(incidency);
+    }
+    return metrics;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnPartitionHelper, PartitionHelperFixture)
+
+BOOST_AUTO_TEST_CASE(SetPartitions)
+{
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_PARTITION_TOPO_TXT.string().c_str());
+  topologyReader.SetPartitions(2);
+  topologyReader.Read();
+
+  // the link with the largest delay is cut
+  BOOST_CHECK_EQUAL(getSystemId("A"), getSystemId("B"));
+  BOOST_CHECK_EQUAL(getSystemId("C"), getSystemId("D"));
+  BOOST_CHECK_NE(getSystemId("B"), getSystemId("C"));
+  BOOST_CHECK_LT(getSystemId("A"), 2);
+  BOOST_CHECK_LT(getSystemId("C"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InstallGlobalRouting)
+{
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_PARTITION_TOPO_TXT.string().c_str());
+  topologyReader.SetPartitions(PartitionHelper::GetNPartitions());
+  NodeContainer nodes = topologyReader.Read();
+
+  // without MPI, all nodes are local
+  BOOST_CHECK_EQUAL(PartitionHelper::GetNPartitions(), 1);
+  BOOST_CHECK_EQUAL(PartitionHelper::GetLocalNodes(nodes).GetN(), 4);
+
+  StackHelper ndnHelper;
+  ndnHelper.Install(PartitionHelper::GetLocalNodes());
+  PartitionHelper::InstallGlobalRouting(topologyReader);
+
+  for (const std::string& nodeName : {"A", "B", "C", "D"}) {
+    BOOST_CHECK(getGlobalRouter(nodeName) != 0);
+  }
+
+  // edges are weighted by OSPF metrics of the topology
+  std::map<Ptr<GlobalRouter>, uint16_t> metricsB = getEdgeMetrics("B");
+  BOOST_CHECK_EQUAL(metricsB.size(), 2);
+  BOOST_CHECK_EQUAL(metricsB[getGlobalRouter("A")], 3);
+  BOOST_CHECK_EQUAL(metricsB[getGlobalRouter("C")], 7);
+
+  std::map<Ptr<GlobalRouter>, uint16_t> metricsD = getEdgeMetrics("D");
+  BOOST_CHECK_EQUAL(metricsD.size(), 1);
+  BOOST_CHECK_EQUAL(metricsD[getGlobalRouter("C")], 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-profiling-helper.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_PROFILE = boost::filesystem::path(TEST_CONFIG_PATH) / "profile.txt";
+
+class ProfilingHelperFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProfilingHelperFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~ProfilingHelperFixture()
+  {
+    boost::filesystem::remove(TEST_PROFILE);
+    ProfilingHelper::Destroy(); // additional cleanup
+  }
+
+  std::vector<std::vector<std::string>>
+  readProfile()
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream is(TEST_PROFILE.string().c_str());
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      boost::split(fields, line, boost::is_any_of("\t"));
+      rows.push_back(fields);
+    }
+    return rows;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnProfilingHelper, ProfilingHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Report)
+{
+  ProfilingHelper::Install(TEST_PROFILE.string(), Seconds(1.0), 2);
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  ProfilingHelper::Destroy(); // to force report to be written
+
+  auto rows = readProfile();
+  BOOST_REQUIRE_GE(rows.size(), 4);
+  BOOST_CHECK_EQUAL(boost::join(rows[0], "\t"),
+                    "Time\tWallTime\tSimPerWallS\tRssMB\tType\tName\tEvents\tEventsPerWallS\tWallS");
+
+  std::vector<std::string> totalTimes;
+  size_t nCategories = 0;
+  std::set<std::string> nodes;
+  for (size_t i = 1; i < rows.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(rows[i].size(), 9);
+    if (rows[i][4] == "Total") {
+      totalTimes.push_back(rows[i][0]);
+    }
+    else if (rows[i][4] == "Category") {
+      ++nCategories;
+    }
+    else if (rows[i][4] == "Node") {
+      nodes.insert(rows[i][5]);
+    }
+  }
+  BOOST_CHECK_EQUAL(boost::join(totalTimes, " "), "1 2 3");
+
+  if (ProfilingHelper::IsInstrumentationEnabled()) {
+    BOOST_CHECK_EQUAL(nCategories, 3 * 2); // limited to top-2 every period
+    BOOST_CHECK(nodes == std::set<std::string>({"1", "2"}));
+  }
+  else {
+    BOOST_CHECK_EQUAL(nCategories, 0);
+    BOOST_CHECK(nodes.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StopReports)
+{
+  ProfilingHelper::Install(TEST_PROFILE.string(), Seconds(1.0));
+
+  Simulator::Schedule(Seconds(1.5), &ProfilingHelper::Destroy);
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  size_t nTotals = 0;
+  for (const auto& row : readProfile()) {
+    nTotals += row.size() > 4 && row[4] == "Total";
+  }
+  BOOST_CHECK_EQUAL(nTotals, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -67,6 +67,25 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(LookupWithoutCopy)
+{
+  ObjectFactory factory("ns3::ndn::cs::Lru");
+  Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+  auto data = make_shared<Data>("/prefix/A");
+  data->setContent(reinterpret_cast<const uint8_t*>("content"), 7);
+  StackHelper::getKeyChain().sign(*data);
+  cs->Add(data);
+
+  shared_ptr<const Data> match1 = cs->Lookup(make_shared<Interest>("/prefix/A"));
+  shared_ptr<const Data> match2 = cs->Lookup(make_shared<Interest>("/prefix"));
+  BOOST_REQUIRE(match1 != nullptr);
+  BOOST_CHECK_EQUAL(match1.get(), data.get());
+  BOOST_CHECK_EQUAL(match2.get(), data.get());
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prefix/B")) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -22,6 +22,8 @@
 #include <ndn-cxx/util/scheduler-scoped-event-id.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
+#include <boost/algorithm/string/join.hpp>
+
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/error-model.h"
 
@@ -102,6 +104,59 @@ BOOST_AUTO_TEST_CASE(SetInterestFilter)
   BOOST_CHECK(hasFired);
 }
 
+class MultiFilterProducer : public BaseTesterApp
+{
+public:
+  MultiFilterProducer(std::vector<std::string>& invoked)
+  {
+    // combined operation, registers /test prefix
+    m_face.setInterestFilter("/test", std::bind([this, &invoked] (const Interest& interest) {
+          invoked.push_back("/test");
+          auto data = make_shared<Data>(Name(interest.getName()));
+          StackHelper::getKeyChain().sign(*data);
+          m_face.put(*data);
+        }, _2),
+      std::bind([] {
+          BOOST_ERROR("Unexpected failure to set interest filter");
+        }));
+
+    for (const std::string& prefix : {"/test/prefix", "/test/other", "/", "/test/prefix/%FE%00/more"}) {
+      m_face.setInterestFilter(::ndn::InterestFilter(prefix), std::bind([prefix, &invoked] {
+            invoked.push_back(prefix);
+          }));
+    }
+
+    const ::ndn::InterestFilterId* unset =
+      m_face.setInterestFilter(::ndn::InterestFilter("/test/prefix"), std::bind([] {
+            BOOST_ERROR("Unexpected Interest for unset filter");
+          }));
+    m_face.unsetInterestFilter(unset);
+
+    m_face.setInterestFilter(::ndn::InterestFilter("/test", "<other>"), std::bind([] {
+          BOOST_ERROR("Unexpected Interest for non-matching regex filter");
+        }));
+  }
+};
+
+BOOST_AUTO_TEST_CASE(SetMultipleInterestFilters)
+{
+  std::vector<std::string> invoked;
+  FactoryCallbackApp::Install(getNode("B"), [&invoked] () -> shared_ptr<void> {
+      return make_shared<MultiFilterProducer>(invoked);
+    })
+    .Start(Seconds(0.01));
+
+  addApps({{"A", "ns3::ndn::ConsumerBatches",
+            {{"Prefix", "/test/prefix"}, {"Batches", "0s 1"}}, "1s", "5.1s"}});
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  // filters are invoked in the order they were set; the filter of combined operation is set
+  // only after the prefix registration succeeds
+  BOOST_CHECK_EQUAL(boost::algorithm::join(invoked, " "), "/test/prefix / /test");
+}
+
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
@@ -270,6 +325,79 @@ BOOST_AUTO_TEST_CASE(ExpressMultipleInterests)
   BOOST_CHECK_EQUAL(recvCount, 10);
 }
 
+class SuffixProducer : public BaseTesterApp
+{
+public:
+  SuffixProducer(const Name& name)
+  {
+    m_face.setInterestFilter(name, std::bind([this] (const Interest& interest) {
+          // Interest name is a strict prefix of the Data name
+          auto data = make_shared<Data>(Name(interest.getName()).append("suffix"));
+          StackHelper::getKeyChain().sign(*data);
+          m_face.put(*data);
+        }, _2),
+      std::bind([] {
+          BOOST_ERROR("Unexpected failure to set interest filter");
+        }));
+  }
+};
+
+class ManyPendingInterests : public BaseTesterApp
+{
+public:
+  ManyPendingInterests(size_t nInterests, std::vector<Name>& received)
+  {
+    std::vector<Name> names{"/test/other"};
+    for (size_t seqNo = 0; seqNo < nInterests; ++seqNo) {
+      names.push_back(Name("/test/prefix").appendSegment(seqNo));
+    }
+
+    for (const Name& name : names) {
+      m_face.expressInterest(name, std::bind([&received] (const Data& data) {
+            received.push_back(data.getName());
+          }, _2),
+        std::bind([] {
+            BOOST_ERROR("Unexpected timeout");
+          }));
+    }
+  }
+
+  size_t
+  getNPendingInterests() const
+  {
+    return m_face.getNPendingInterests();
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ExpressManyPendingInterests)
+{
+  FactoryCallbackApp::Install(getNode("B"), [] () -> shared_ptr<void> {
+      return make_shared<SuffixProducer>("/test");
+    })
+    .Start(Seconds(0.01));
+
+  std::vector<Name> received;
+  shared_ptr<ManyPendingInterests> app;
+  FactoryCallbackApp::Install(getNode("A"), [&received, &app] () -> shared_ptr<void> {
+      app = make_shared<ManyPendingInterests>(10, received);
+      return app;
+    })
+    .Start(Seconds(1.01));
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  std::set<Name> names(received.begin(), received.end());
+  BOOST_CHECK_EQUAL(received.size(), 11);
+  BOOST_CHECK_EQUAL(names.size(), 11);
+  BOOST_CHECK_EQUAL(names.count("/test/other/suffix"), 1);
+  for (size_t seqNo = 0; seqNo < 10; ++seqNo) {
+    BOOST_CHECK_EQUAL(names.count(Name("/test/prefix").appendSegment(seqNo).append("suffix")), 1);
+  }
+  BOOST_REQUIRE(app != nullptr);
+  BOOST_CHECK_EQUAL(app->getNPendingInterests(), 0);
+}
+
 class SingleInterestWithFaceShutdown : public BaseTesterApp
 {
 public:
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+
+#include <algorithm>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTopologyPartitioner)
+
+/**
+ * Grid of 10x10 nodes with 1ms links, except 10ms links between columns 4 and 5
+ */
+static TopologyPartitioner
+makeGrid()
+{
+  TopologyPartitioner partitioner(100);
+  for (uint32_t row = 0; row < 10; ++row) {
+    for (uint32_t column = 0; column < 10; ++column) {
+      uint32_t node = row * 10 + column;
+      if (column < 9) {
+        partitioner.AddLink(node, node + 1, MilliSeconds(column == 4 ? 10 : 1));
+      }
+      if (row < 9) {
+        partitioner.AddLink(node, node + 10, MilliSeconds(1));
+      }
+    }
+  }
+  return partitioner;
+}
+
+BOOST_AUTO_TEST_CASE(SinglePartition)
+{
+  TopologyPartitioner partitioner = makeGrid();
+  std::vector<uint32_t> systemIds = partitioner.Partition(1);
+  BOOST_CHECK_EQUAL(systemIds.size(), 100);
+  BOOST_CHECK(std::all_of(systemIds.begin(), systemIds.end(), [] (uint32_t id) { return id == 0; }));
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 0);
+  BOOST_CHECK(partitioner.GetLookahead() == Time::Max());
+}
+
+BOOST_AUTO_TEST_CASE(CutLongestLinks)
+{
+  TopologyPartitioner partitioner = makeGrid();
+  std::vector<uint32_t> systemIds = partitioner.Partition(2);
+
+  // only the 10ms links are cut
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 10);
+  BOOST_CHECK(partitioner.GetLookahead() == MilliSeconds(10));
+  for (uint32_t row = 0; row < 10; ++row) {
+    for (uint32_t column = 0; column < 10; ++column) {
+      BOOST_CHECK_EQUAL(systemIds[row * 10 + column], systemIds[column < 5 ? 0 : 9]);
+    }
+  }
+  BOOST_CHECK_NE(systemIds[0], systemIds[9]);
+}
+
+BOOST_AUTO_TEST_CASE(Balance)
+{
+  TopologyPartitioner partitioner = makeGrid();
+  std::vector<uint32_t> systemIds = partitioner.Partition(4);
+
+  std::vector<uint32_t> sizes(4, 0);
+  for (uint32_t id : systemIds) {
+    BOOST_REQUIRE_LT(id, 4);
+    ++sizes[id];
+  }
+  for (uint32_t size : sizes) {
+    BOOST_CHECK_GT(size, 0);
+    BOOST_CHECK_LE(size, 28); // 10% above the even share
+  }
+  BOOST_CHECK(partitioner.GetLookahead() == MilliSeconds(1));
+
+  // every rank computes the same partitions
+  BOOST_CHECK(makeGrid().Partition(4) == systemIds);
+}
+
+BOOST_AUTO_TEST_CASE(MorePartitionsThanNodes)
+{
+  TopologyPartitioner partitioner(2);
+  partitioner.AddLink(0, 1, MilliSeconds(5));
+  std::vector<uint32_t> systemIds = partitioner.Partition(4);
+  BOOST_CHECK_NE(systemIds[0], systemIds[1]);
+  BOOST_CHECK_LT(std::max(systemIds[0], systemIds[1]), 2);
+  BOOST_CHECK(partitioner.GetLookahead() == MilliSeconds(5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
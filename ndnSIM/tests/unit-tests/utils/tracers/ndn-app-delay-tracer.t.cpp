@@ -97,6 +97,76 @@ BOOST_AUTO_TEST_CASE(InstallAll)
     "3.02089	2	0	1	FullDelay	0.0208856	20885.6	1	1\n");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), TraceFormat::BINARY);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  std::stringstream buffer;
+  BinaryTraceReader(t).WriteTsv(buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417712	1	0	0	LastDelay	0.0417712	41771.2	1	2\n"
+    "0.0417712	1	0	0	FullDelay	0.0417712	41771.2	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02089	2	0	1	LastDelay	0.0208856	20885.6	1	1\n"
+    "3.02089	2	0	1	FullDelay	0.0208856	20885.6	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregated)
+{
+  AppDelayTracer::InstallAllAggregated(TEST_TRACE.string(), Seconds(0.7));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Prefix	Type	Count	MinUS	P50US	P99US	P999US	MaxUS\n"
+    "0.7	1	0	/prefix	LastDelay	1	41771.2	41771.2	41771.2	41771.2	41771.2\n"
+    "0.7	1	0	/prefix	FullDelay	1	41771.2	41771.2	41771.2	41771.2	41771.2\n"
+    "2.1	2	0	/prefix	LastDelay	1	0	0	0	0	0\n"
+    "2.1	2	0	/prefix	FullDelay	1	0	0	0	0	0\n"
+    "3.5	2	0	/prefix	LastDelay	1	20885.6	20885.6	20885.6	20885.6	20885.6\n"
+    "3.5	2	0	/prefix	FullDelay	1	20885.6	20885.6	20885.6	20885.6	20885.6\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregatedPartialPeriod)
+{
+  AppDelayTracer::InstallAllAggregated(TEST_TRACE.string(), Seconds(0.7));
+
+  // the delay measured at 3.02s belongs to the period ending at 3.5s
+  Simulator::Stop(Seconds(3.3));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Prefix	Type	Count	MinUS	P50US	P99US	P999US	MaxUS\n"
+    "0.7	1	0	/prefix	LastDelay	1	41771.2	41771.2	41771.2	41771.2	41771.2\n"
+    "0.7	1	0	/prefix	FullDelay	1	41771.2	41771.2	41771.2	41771.2	41771.2\n"
+    "2.1	2	0	/prefix	LastDelay	1	0	0	0	0	0\n"
+    "2.1	2	0	/prefix	FullDelay	1	0	0	0	0	0\n"
+    "3.3	2	0	/prefix	LastDelay	1	20885.6	20885.6	20885.6	20885.6	20885.6\n"
+    "3.3	2	0	/prefix	FullDelay	1	20885.6	20885.6	20885.6	20885.6	20885.6\n");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 {
   NodeContainer nodes;
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnBinaryTrace)
+
+static const std::vector<BinaryTraceColumn> COLUMNS = {{"Time", BinaryTraceColumn::DOUBLE},
+                                                       {"Node", BinaryTraceColumn::STRING},
+                                                       {"FaceId", BinaryTraceColumn::INTEGER}};
+
+static void
+writeRows(std::ostream& os, size_t nRows, size_t blockSize)
+{
+  BinaryTraceWriter writer(shared_ptr<std::ostream>(&os, std::bind([]{})), COLUMNS, blockSize);
+  for (size_t i = 0; i < nRows; ++i) {
+    writer.AddDouble(i * 0.5);
+    writer.AddString(i % 2 == 0 ? "even" : "odd");
+    writer.AddInteger(static_cast<int64_t>(i) - 1);
+    writer.EndRow();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  auto os = make_shared<std::stringstream>();
+  writeRows(*os, 5, 2); // blocks of 2, 2 and 1 rows
+
+  BinaryTraceReader reader(*os);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 3);
+  BOOST_CHECK_EQUAL(reader.GetColumns()[1].name, "Node");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[1].type, BinaryTraceColumn::STRING);
+
+  size_t row = 0;
+  std::vector<size_t> blockSizes;
+  while (reader.ReadBlock()) {
+    blockSizes.push_back(reader.GetNRows());
+    for (size_t i = 0; i < reader.GetNRows(); ++i, ++row) {
+      BOOST_CHECK_EQUAL(reader.GetDouble(0, i), row * 0.5);
+      BOOST_CHECK_EQUAL(reader.GetString(1, i), row % 2 == 0 ? "even" : "odd");
+      BOOST_CHECK_EQUAL(reader.GetInteger(2, i), static_cast<int64_t>(row) - 1);
+    }
+  }
+  BOOST_CHECK_EQUAL(row, 5);
+  BOOST_CHECK_EQUAL(blockSizes.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToTsv)
+{
+  std::stringstream is;
+  writeRows(is, 3, BinaryTraceWriter::DEFAULT_BLOCK_SIZE);
+
+  std::ostringstream os;
+  BinaryTraceReader(is).WriteTsv(os);
+  BOOST_CHECK_EQUAL(os.str(),
+    "Time	Node	FaceId\n"
+    "0	even	-1\n"
+    "0.5	odd	0\n"
+    "1	even	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  std::istringstream text("Time\tNode\n");
+  BOOST_CHECK_THROW(BinaryTraceReader reader(text), BinaryTraceReader::Error);
+
+  std::stringstream trace;
+  writeRows(trace, 3, BinaryTraceWriter::DEFAULT_BLOCK_SIZE);
+  std::string wire = trace.str();
+
+  std::istringstream truncated(wire.substr(0, wire.size() - 1));
+  BinaryTraceReader reader(truncated);
+  BOOST_CHECK_THROW(reader.ReadBlock(), BinaryTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
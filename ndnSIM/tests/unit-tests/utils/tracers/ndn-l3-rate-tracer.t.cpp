@@ -18,10 +18,16 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
+#include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <cmath>
+#include <sstream>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
@@ -59,6 +65,75 @@ public:
   }
 };
 
+/**
+ * @brief Consumer on node 1 and producer on node 2, Interests time out after the link fails
+ */
+class L3RateTracerLinkFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L3RateTracerLinkFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTime", "0.5s"}},
+            "0s", "4s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    Simulator::Schedule(Seconds(2.0), ndn::LinkControlHelper::FailLink,
+                        getNode("1"), getNode("2"));
+  }
+};
+
+/**
+ * @brief PacketRaw values of a TSV trace, summed over all periods, indexed by (FaceId, Type)
+ */
+typedef std::map<std::pair<std::string, std::string>, double> RawCounts;
+
+static RawCounts
+sumRawPackets(const std::string& trace)
+{
+  RawCounts counts;
+  std::istringstream is(trace);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of("\t"));
+    BOOST_REQUIRE_EQUAL(fields.size(), 9);
+    counts[std::make_pair(fields[2], fields[4])] += boost::lexical_cast<double>(fields[7]);
+  }
+  return counts;
+}
+
+/**
+ * @brief Sum of PacketRaw values of @p type on all faces except @p exceptFace
+ */
+static double
+sumFaces(const RawCounts& counts, const std::string& type, const std::string& exceptFace = "")
+{
+  double sum = 0;
+  for (const auto& count : counts) {
+    if (count.first.second == type && count.first.first != exceptFace) {
+      sum += count.second;
+    }
+  }
+  return sum;
+}
+
 BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3RateTracer, L3RateTracerFixture)
 
 BOOST_AUTO_TEST_CASE(NackTracing)
@@ -119,6 +194,135 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(Filter)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"), output, Seconds(1));
+
+  L3TracerFilter filter;
+  filter.prefix = "/prefix";
+  filter.sources = L3TracerFilter::IN_INTERESTS | L3TracerFilter::OUT_NACKS;
+  tracer->SetFilter(filter);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  BOOST_CHECK(output->is_equal(
+    "1	1	257	appFace://	InInterests	0.8	0	1	0\n"
+    "1	1	257	appFace://	OutInterests	0	0	0	0\n"
+    "1	1	257	appFace://	InData	0	0	0	0\n"
+    "1	1	257	appFace://	OutData	0	0	0	0\n"
+    "1	1	257	appFace://	InNacks	0	0	0	0\n"
+    "1	1	257	appFace://	OutNacks	0.8	0	1	0\n"
+    "1	1	257	appFace://	InSatisfiedInterests	0	0	0	0\n"
+    "1	1	257	appFace://	InTimedOutInterests	0	0	0	0\n"
+    "1	1	257	appFace://	OutSatisfiedInterests	0	0	0	0\n"
+    "1	1	257	appFace://	OutTimedOutInterests	0	0	0	0\n"));
+}
+
+BOOST_FIXTURE_TEST_CASE(FilterFaces, L3RateTracerLinkFixture)
+{
+  auto output = make_shared<std::ostringstream>();
+  Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"), output, Seconds(1));
+
+  auto filteredOutput = make_shared<std::ostringstream>();
+  Ptr<L3RateTracer> filteredTracer = L3RateTracer::Install(getNode("1"), filteredOutput,
+                                                           Seconds(1));
+
+  nfd::FaceId netFaceId = getFace("1", "2")->getId();
+  L3TracerFilter filter;
+  filter.faces = {netFaceId};
+  filteredTracer->SetFilter(filter);
+
+  Simulator::Stop(Seconds(6.5));
+  Simulator::Run();
+
+  RawCounts all = sumRawPackets(output->str());
+  RawCounts filtered = sumRawPackets(filteredOutput->str());
+  std::string netFace = boost::lexical_cast<std::string>(netFaceId);
+
+  // PIT in-records are on the app face and out-records on the network face
+  BOOST_CHECK_GT(all[std::make_pair(netFace, "OutSatisfiedInterests")], 0);
+  BOOST_CHECK_GT(all[std::make_pair(netFace, "OutTimedOutInterests")], 0);
+  BOOST_CHECK_GT(sumFaces(all, "InSatisfiedInterests", netFace), 0);
+  BOOST_CHECK_GT(sumFaces(all, "InTimedOutInterests", netFace), 0);
+
+  for (const auto& count : filtered) {
+    const std::string& faceId = count.first.first;
+    BOOST_CHECK_MESSAGE(faceId == netFace || faceId == "-1",
+                        "face " << faceId << " should have been filtered");
+    if (faceId == netFace) {
+      BOOST_CHECK_MESSAGE(count.second == all[count.first],
+                          count.first.second << " " << count.second << " != "
+                          << all[count.first]);
+    }
+  }
+
+  BOOST_CHECK_GT(filtered[std::make_pair(netFace, "OutSatisfiedInterests")], 0);
+  BOOST_CHECK_GT(filtered[std::make_pair(netFace, "OutTimedOutInterests")], 0);
+  BOOST_CHECK_EQUAL(filtered[std::make_pair(netFace, "InSatisfiedInterests")], 0);
+  BOOST_CHECK_EQUAL(filtered[std::make_pair(netFace, "InTimedOutInterests")], 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(Sampling, L3RateTracerLinkFixture)
+{
+  const uint32_t sampling = 3;
+
+  auto output = make_shared<std::ostringstream>();
+  Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"), output, Seconds(1));
+
+  auto sampledOutput = make_shared<std::ostringstream>();
+  Ptr<L3RateTracer> sampledTracer = L3RateTracer::Install(getNode("1"), sampledOutput,
+                                                          Seconds(1));
+
+  L3TracerFilter filter;
+  filter.sampling = sampling;
+  sampledTracer->SetFilter(filter);
+
+  // stop counting before the last printed period, so that both traces cover all events
+  Simulator::Schedule(Seconds(5.5), &L3Tracer::Detach, tracer);
+  Simulator::Schedule(Seconds(5.5), &L3Tracer::Detach, sampledTracer);
+
+  Simulator::Stop(Seconds(6.5));
+  Simulator::Run();
+
+  RawCounts all = sumRawPackets(output->str());
+  RawCounts sampled = sumRawPackets(sampledOutput->str());
+
+  // events of each trace source are counted once on one face
+  for (const std::string& type : {"InInterests", "OutInterests", "InData", "OutData"}) {
+    double nEvents = sumFaces(all, type, "-1");
+    BOOST_CHECK_GT(nEvents, sampling);
+    BOOST_CHECK_MESSAGE(sumFaces(sampled, type, "-1") == std::ceil(nEvents / sampling),
+                        type << " " << sumFaces(sampled, type, "-1") << " of " << nEvents);
+  }
+
+  for (const std::string& type : {"SatisfiedInterests", "TimedOutInterests"}) {
+    double nEvents = all[std::make_pair("-1", type)];
+    BOOST_CHECK_GT(nEvents, sampling);
+    BOOST_CHECK_MESSAGE(sampled[std::make_pair("-1", type)] == std::ceil(nEvents / sampling),
+                        type << " " << sampled[std::make_pair("-1", type)] << " of " << nEvents);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Detach)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"), output, Seconds(1));
+  tracer->Detach();
+  BOOST_CHECK(!tracer->IsAttached());
+
+  L3TracerFilter filter;
+  filter.sampling = 2;
+  tracer->SetFilter(filter); // does not attach detached tracer
+  BOOST_CHECK(!tracer->IsAttached());
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  BOOST_CHECK(output->is_empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-latency-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(SmallValues)
+{
+  LatencyHistogram histogram;
+  for (uint64_t value = 1; value <= 100; ++value) {
+    histogram.Add(value);
+  }
+
+  // values below 2^(precisionBits + 1) are exact
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.GetMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 100);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), 50);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.99), 99);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(1), 100);
+
+  histogram.Reset();
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  histogram.Add(42000000);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), 42000000);
+  BOOST_CHECK_EQUAL(histogram.GetQuantile(0.999), 42000000);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  std::mt19937_64 generator(1);
+  std::lognormal_distribution<double> distribution(16, 2); // ~10 ms median in ns
+
+  LatencyHistogram histogram;
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(static_cast<uint64_t>(distribution(generator)));
+    histogram.Add(values.back());
+  }
+  std::sort(values.begin(), values.end());
+
+  for (double q : {0.5, 0.9, 0.99, 0.999}) {
+    uint64_t exact = values[static_cast<size_t>(std::ceil(q * values.size())) - 1];
+    double error = std::abs(static_cast<double>(histogram.GetQuantile(q)) - exact) / exact;
+    BOOST_CHECK_LE(error, 1.0 / 256);
+  }
+  BOOST_CHECK_EQUAL(histogram.GetMin(), values.front());
+  BOOST_CHECK_EQUAL(histogram.GetMax(), values.back());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
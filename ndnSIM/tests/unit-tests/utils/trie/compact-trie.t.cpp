@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// declares boost::hash_value of name::Component, which the classic trie needs
+#include "model/cs/ndn-content-store.hpp"
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/fifo-policy.hpp"
+#include "utils/trie/multi-policy.hpp"
+
+#include <random>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+typedef non_pointer_traits<int> IntTraits;
+
+template<class PolicyTraits>
+using CompactTrie = trie_with_policy<Name, IntTraits, PolicyTraits, compact_trie>;
+
+template<class PolicyTraits>
+using ClassicTrie = trie_with_policy<Name, IntTraits, PolicyTraits, trie>;
+
+BOOST_AUTO_TEST_SUITE(UtilsTrieCompactTrie)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  CompactTrie<lru_policy_traits> t;
+  t.getPolicy().set_max_size(0);
+
+  BOOST_CHECK(t.insert(Name("/a/b/c/d"), 1).second);
+  BOOST_CHECK(t.insert(Name("/a/b"), 2).second);
+  BOOST_CHECK(t.insert(Name("/a/x"), 3).second);
+  BOOST_CHECK(!t.insert(Name("/a/b"), 4).second);
+  BOOST_CHECK_EQUAL(t.getPolicy().size(), 3);
+  // /a /a/b /a/b/c /a/b/c/d /a/x
+  BOOST_CHECK_EQUAL(t.getTrie().get_pool().size(), 5);
+
+  BOOST_REQUIRE(t.find_exact(Name("/a/b")) != t.end());
+  BOOST_CHECK_EQUAL(t.find_exact(Name("/a/b"))->payload(), 2);
+  BOOST_CHECK(t.find_exact(Name("/a/b/c")) == t.end());
+  BOOST_CHECK(t.find_exact(Name("/a/y")) == t.end());
+
+  BOOST_REQUIRE(t.longest_prefix_match(Name("/a/b/c/e")) != t.end());
+  BOOST_CHECK_EQUAL(t.longest_prefix_match(Name("/a/b/c/e"))->payload(), 2);
+  BOOST_CHECK(t.longest_prefix_match(Name("/z")) == t.end());
+
+  BOOST_REQUIRE(t.deepest_prefix_match(Name("/a/b/c")) != t.end());
+  BOOST_CHECK_EQUAL(t.deepest_prefix_match(Name("/a/b/c"))->payload(), 2);
+  BOOST_REQUIRE(t.deepest_prefix_match(Name("/a")) != t.end());
+  BOOST_CHECK_EQUAL(t.deepest_prefix_match(Name("/a"))->payload(), 2); // first in key order
+
+  // removing the leaf prunes the single-child chain up to /a/b, which still has a payload
+  t.erase(Name("/a/b/c/d"));
+  BOOST_CHECK_EQUAL(t.getPolicy().size(), 2);
+  BOOST_CHECK_EQUAL(t.getTrie().get_pool().size(), 3);
+  BOOST_CHECK(t.find_exact(Name("/a/b/c/d")) == t.end());
+  BOOST_CHECK(t.deepest_prefix_match(Name("/a/b/c")) == t.end());
+
+  t.erase(Name("/a/b"));
+  t.erase(Name("/a/x"));
+  BOOST_CHECK_EQUAL(t.getPolicy().size(), 0);
+  BOOST_CHECK_EQUAL(t.getTrie().get_pool().size(), 0);
+  BOOST_CHECK_EQUAL(t.getTrie().child_count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(HashedChildren)
+{
+  typedef CompactTrie<lru_policy_traits>::parent_trie Node;
+  const size_t nChildren = Node::HASH_THRESHOLD * 4;
+
+  CompactTrie<lru_policy_traits> t;
+  t.getPolicy().set_max_size(0);
+  for (size_t i = 0; i < nChildren; ++i) {
+    t.insert(Name("/p").appendNumber(i), static_cast<int>(i) + 1);
+  }
+
+  const Node& p = *std::get<2>(t.getTrie().find(Name("/p")));
+  BOOST_CHECK_EQUAL(p.child_count(), nChildren);
+  std::ostringstream os;
+  p.PrintStat(os);
+  BOOST_CHECK(os.str().find("(hashed)") != std::string::npos);
+
+  for (size_t i = 0; i < nChildren; ++i) {
+    auto item = t.find_exact(Name("/p").appendNumber(i));
+    BOOST_REQUIRE(item != t.end());
+    BOOST_CHECK_EQUAL(item->payload(), static_cast<int>(i) + 1);
+  }
+
+  // children are enumerated in canonical order of their keys
+  Node::const_point_iterator child(p), end;
+  for (size_t i = 0; i < nChildren; ++i, ++child) {
+    BOOST_REQUIRE(child != end);
+    BOOST_CHECK_EQUAL(child->key(), name::Component::fromNumber(i));
+  }
+  BOOST_CHECK(child == end);
+
+  for (size_t i = 0; i < nChildren - 1; ++i) {
+    t.erase(Name("/p").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(p.child_count(), 1);
+  os.str("");
+  p.PrintStat(os);
+  BOOST_CHECK(os.str().find("(hashed)") == std::string::npos);
+  BOOST_CHECK(t.find_exact(Name("/p").appendNumber(nChildren - 1)) != t.end());
+}
+
+BOOST_AUTO_TEST_CASE(RecursiveIterator)
+{
+  CompactTrie<fifo_policy_traits> t;
+  t.getPolicy().set_max_size(0);
+  t.insert(Name("/b/2"), 1);
+  t.insert(Name("/a"), 2);
+  t.insert(Name("/b/1/x"), 3);
+  t.insert(Name("/c"), 4);
+
+  std::vector<int> payloads;
+  size_t nNodes = 0;
+  typedef CompactTrie<fifo_policy_traits>::parent_trie Node;
+  for (Node::recursive_iterator item(t.getTrie()), end(0); item != end; item++) {
+    ++nNodes;
+    if (item->payload() != IntTraits::empty_payload) {
+      payloads.push_back(item->payload());
+    }
+  }
+
+  // root /a /b /b/1 /b/1/x /b/2 /c
+  BOOST_CHECK_EQUAL(nNodes, 7);
+  std::vector<int> expected{2, 3, 1, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(payloads.begin(), payloads.end(), expected.begin(), expected.end());
+}
+
+template<class Trie>
+static std::set<int>
+getPayloads(Trie& t)
+{
+  std::set<int> payloads;
+  for (auto item = t.getPolicy().begin(); item != t.getPolicy().end(); ++item) {
+    payloads.insert(item->payload());
+  }
+  return payloads;
+}
+
+typedef boost::mpl::vector<lru_policy_traits,
+                           lfu_policy_traits,
+                           fifo_policy_traits,
+                           multi_policy_traits<boost::mpl::vector2<lru_policy_traits,
+                                                                   lfu_policy_traits>>> Policies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SameAsTrie, Policy, Policies)
+{
+  CompactTrie<Policy> compact;
+  ClassicTrie<Policy> classic;
+  compact.getPolicy().set_max_size(50);
+  classic.getPolicy().set_max_size(50);
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> prefixDist(0, 9);
+  std::uniform_int_distribution<int> suffixDist(0, 19);
+  std::uniform_int_distribution<int> opDist(0, 2);
+
+  for (int i = 0; i < 2000; ++i) {
+    int prefix = prefixDist(rng);
+    int suffix = suffixDist(rng);
+    Name name("/root");
+    name.appendNumber(prefix).append("chain").appendNumber(suffix);
+    int payload = prefix * 100 + suffix + 1;
+
+    switch (opDist(rng)) {
+    case 0:
+      BOOST_CHECK_EQUAL(compact.insert(name, payload).second, classic.insert(name, payload).second);
+      break;
+    case 1:
+      BOOST_CHECK_EQUAL(compact.find_exact(name) != compact.end(),
+                        classic.find_exact(name) != classic.end());
+      compact.longest_prefix_match(name);
+      classic.longest_prefix_match(name);
+      break;
+    case 2:
+      compact.erase(name);
+      classic.erase(name);
+      break;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(compact.getPolicy().size(), classic.getPolicy().size());
+  std::set<int> compactPayloads = getPayloads(compact);
+  std::set<int> classicPayloads = getPayloads(classic);
+  BOOST_CHECK_EQUAL_COLLECTIONS(compactPayloads.begin(), compactPayloads.end(),
+                                classicPayloads.begin(), classicPayloads.end());
+
+  compact.clear();
+  BOOST_CHECK_EQUAL(compact.getTrie().get_pool().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
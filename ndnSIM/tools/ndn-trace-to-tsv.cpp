@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-to-tsv.cpp
+
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace.hpp"
+
+#include <fstream>
+#include <iostream>
+
+/**
+ * Converts a trace written with ns3::ndn::TraceFormat::BINARY into the tab-separated text
+ * format that the tracer writes with ns3::ndn::TraceFormat::TSV:
+ *
+ *     ./waf --run="ndn-trace-to-tsv rate-trace.bin rate-trace.txt"
+ *
+ * If the output file is omitted, the result is written to the standard output.
+ */
+int
+main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <binary-trace> [<tsv-output>]" << std::endl;
+    return 2;
+  }
+
+  std::ifstream input(argv[1], std::ios_base::in | std::ios_base::binary);
+  if (!input.is_open()) {
+    std::cerr << "ERROR: cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::ofstream outputFile;
+  if (argc == 3) {
+    outputFile.open(argv[2], std::ios_base::out | std::ios_base::trunc);
+    if (!outputFile.is_open()) {
+      std::cerr << "ERROR: cannot open " << argv[2] << " for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& output = argc == 3 ? outputFile : std::cout;
+
+  try {
+    ns3::ndn::BinaryTraceReader reader(input);
+    reader.WriteTsv(output);
+  }
+  catch (const ns3::ndn::BinaryTraceReader::Error& e) {
+    std::cerr << "ERROR: " << argv[1] << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -105,14 +105,14 @@ DummyPublicInfo::addKey(const Name& keyName, const PublicKey& publicKey)
 shared_ptr<PublicKey>
 DummyPublicInfo::getPublicKey(const Name& keyName)
 {
-  static shared_ptr<PublicKey> publicKey = nullptr;
-  if (publicKey == nullptr) {
+  // initialized once even if KeyChains of several nodes are used concurrently
+  static const shared_ptr<PublicKey> publicKey = [] {
     typedef boost::iostreams::stream<boost::iostreams::array_source> arrayStream;
     arrayStream
     is(reinterpret_cast<const char*>(DUMMY_CERT), sizeof(DUMMY_CERT));
     auto cert = io::load<IdentityCertificate>(is, io::NO_ENCODING);
-    publicKey = make_shared<PublicKey>(cert->getPublicKeyInfo());
-  }
+    return make_shared<PublicKey>(cert->getPublicKeyInfo());
+  }();
 
   return publicKey;
 }
@@ -137,13 +137,13 @@ DummyPublicInfo::addCertificate(const IdentityCertificate& certificate)
 shared_ptr<IdentityCertificate>
 DummyPublicInfo::getCertificate(const Name& certificateName)
 {
-  static shared_ptr<IdentityCertificate> cert = nullptr;
-  if (cert == nullptr) {
+  // initialized once even if KeyChains of several nodes are used concurrently
+  static const shared_ptr<IdentityCertificate> cert = [] {
     typedef boost::iostreams::stream<boost::iostreams::array_source> arrayStream;
     arrayStream
     is(reinterpret_cast<const char*>(DUMMY_CERT), sizeof(DUMMY_CERT));
-    cert = io::load<IdentityCertificate>(is, io::BASE64);
-  }
+    return io::load<IdentityCertificate>(is, io::BASE64);
+  }();
 
   return cert;
 }
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-profiler.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/NFD/core/context-local.hpp"
+
+#include <atomic>
+
+namespace ns3 {
+namespace ndn {
+namespace profiler {
+
+namespace {
+
+/**
+ * @brief Counters of one node
+ *
+ * Counters are only updated by the thread that runs the node, but are read and reset by the
+ * thread that prints reports, so they are atomics accessed with relaxed ordering.
+ */
+struct ContextCounters {
+  explicit
+  ContextCounters(uint32_t context)
+    : context(context)
+  {
+    for (size_t category = 0; category < N_CATEGORIES; ++category) {
+      counts[category].store(0, std::memory_order_relaxed);
+      nanoseconds[category].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  const uint32_t context;
+  std::array<std::atomic<uint64_t>, N_CATEGORIES> counts;
+  std::array<std::atomic<int64_t>, N_CATEGORIES> nanoseconds;
+};
+
+} // namespace
+
+static nfd::ContextLocal<ContextCounters>&
+getNodeCounters()
+{
+  static nfd::ContextLocal<ContextCounters> counters([] (uint32_t context) {
+      return new ContextCounters(context);
+    });
+  return counters;
+}
+
+// scopes are nested within one thread
+static thread_local Scope* g_currentScope = nullptr;
+
+const char*
+GetCategoryName(Category category)
+{
+  switch (category) {
+  case FORWARDER:
+    return "Forwarder";
+  case STRATEGY:
+    return "Strategy";
+  case LINK_SERVICE:
+    return "LinkService";
+  case CONTENT_STORE:
+    return "ContentStore";
+  case APP:
+    return "App";
+  case IPOC:
+    return "IPoC";
+  default:
+    return "Unknown";
+  }
+}
+
+std::vector<NodeCounters>
+GetCounters()
+{
+  std::vector<NodeCounters> counters;
+  getNodeCounters().forEach([&counters] (const ContextCounters& node) {
+      if (node.context >= counters.size()) {
+        counters.resize(node.context + 1);
+      }
+      for (size_t category = 0; category < N_CATEGORIES; ++category) {
+        counters[node.context][category].count =
+          node.counts[category].load(std::memory_order_relaxed);
+        counters[node.context][category].nanoseconds =
+          node.nanoseconds[category].load(std::memory_order_relaxed);
+      }
+    });
+  return counters;
+}
+
+void
+Reset()
+{
+  getNodeCounters().forEach([] (ContextCounters& node) {
+      for (size_t category = 0; category < N_CATEGORIES; ++category) {
+        node.counts[category].store(0, std::memory_order_relaxed);
+        node.nanoseconds[category].store(0, std::memory_order_relaxed);
+      }
+    });
+}
+
+Scope::Scope(Category category)
+  : m_category(category)
+  , m_parent(g_currentScope)
+  , m_childrenNanoseconds(0)
+  , m_start(Clock::now())
+{
+  g_currentScope = this;
+}
+
+Scope::~Scope()
+{
+  int64_t elapsed =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+  g_currentScope = m_parent;
+  if (m_parent != nullptr) {
+    m_parent->m_childrenNanoseconds += elapsed;
+  }
+
+  uint32_t context = Simulator::GetContext();
+  if (context == Simulator::NO_CONTEXT) {
+    return;
+  }
+  // only this thread updates counters of the node, so no read-modify-write is needed
+  ContextCounters& node = getNodeCounters().get(context);
+  std::atomic<uint64_t>& count = node.counts[m_category];
+  count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic<int64_t>& nanoseconds = node.nanoseconds[m_category];
+  nanoseconds.store(nanoseconds.load(std::memory_order_relaxed) + elapsed - m_childrenNanoseconds,
+                    std::memory_order_relaxed);
+}
+
+} // namespace profiler
+} // namespace ndn
+} // namespace ns3
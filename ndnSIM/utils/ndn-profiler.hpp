@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PROFILER_H
+#define NDN_PROFILER_H
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace profiler {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Subsystems to which the profiler attributes wall-clock time
+ */
+enum Category {
+  FORWARDER,     ///< forwarding pipelines
+  STRATEGY,      ///< forwarding strategy triggers
+  LINK_SERVICE,  ///< link service and transport encoding/decoding
+  CONTENT_STORE, ///< content store lookups and insertions
+  APP,           ///< application callbacks
+  IPOC,          ///< IP-over-NDN gateway and client processing
+  N_CATEGORIES
+};
+
+const char*
+GetCategoryName(Category category);
+
+/// @cond include_hidden
+struct Counter {
+  uint64_t count = 0;
+  int64_t nanoseconds = 0; ///< exclusive wall-clock time, without nested scopes
+};
+/// @endcond
+
+typedef std::array<Counter, N_CATEGORIES> NodeCounters;
+
+/**
+ * @brief Get a copy of counters of all nodes, indexed by node ID (i.e., simulator context)
+ *
+ * Work done outside of any node context (e.g., during scenario setup) is not included.
+ * Counters of nodes that are simulated concurrently may be updated while they are copied.
+ */
+std::vector<NodeCounters>
+GetCounters();
+
+/**
+ * @brief Clear counters of all nodes
+ */
+void
+Reset();
+
+/**
+ * @brief Profiled scope, which counts one event of the category and its wall-clock time
+ *
+ * Time of nested scopes is attributed only to the innermost scope, so for example the time of a
+ * forwarding pipeline started by an application is not counted for the application.
+ *
+ * Use NDNSIM_PROFILE_SCOPE instead of creating Scope directly, so that the instrumentation
+ * disappears when ndnSIM is configured without --enable-ndnsim-profiling.
+ */
+class Scope : boost::noncopyable {
+public:
+  explicit
+  Scope(Category category);
+
+  ~Scope();
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  Category m_category;
+  Scope* m_parent;
+  int64_t m_childrenNanoseconds;
+  Clock::time_point m_start;
+};
+
+} // namespace profiler
+} // namespace ndn
+} // namespace ns3
+
+/**
+ * @brief Count the enclosing block as an event of @p category (e.g., FORWARDER) and
+ *        measure its wall-clock time
+ *
+ * Expands to nothing unless ndnSIM is compiled with NDNSIM_PROFILING defined.
+ */
+#ifdef NDNSIM_PROFILING
+#define NDNSIM_PROFILE_SCOPE(category)                                                             \
+  ::ns3::ndn::profiler::Scope ndnsimProfileScope(::ns3::ndn::profiler::category)
+#else
+#define NDNSIM_PROFILE_SCOPE(category)                                                             \
+  do {                                                                                             \
+  } while (false)
+#endif // NDNSIM_PROFILING
+
+#endif // NDN_PROFILER_H
@@ -44,6 +44,8 @@
 
 #include "model/ndn-l3-protocol.hpp"
 
+#include "topology-partitioner.hpp"
+
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
@@ -63,12 +65,26 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("AnnotatedTopologyReader");
 
+/**
+ * \brief Get delay of point-to-point channels without explicit delay in the topology file
+ */
+static Time
+getDefaultChannelDelay()
+{
+  TypeId::AttributeInformation info;
+  TypeId::LookupByName("ns3::PointToPointChannel").LookupAttributeByName("Delay", &info);
+  Ptr<const TimeValue> delay = DynamicCast<const TimeValue>(info.initialValue);
+  return delay != 0 ? delay->Get() : Seconds(0);
+}
+
 AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double scale /*=1.0*/)
   : m_path(path)
   , m_randX(CreateObject<UniformRandomVariable>())
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_nPartitions(0)
+  , m_maxImbalance(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -100,6 +116,30 @@ AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
   m_mobilityFactory.SetTypeId(model);
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions, double maxImbalance/* = 0.1*/)
+{
+  NS_LOG_FUNCTION(this << nPartitions << maxImbalance);
+  m_nPartitions = nPartitions;
+  m_maxImbalance = maxImbalance;
+  m_requiredPartitions = std::max<uint32_t>(nPartitions, 1);
+}
+
+std::vector<uint32_t>
+AnnotatedTopologyReader::PartitionNodes(const std::vector<std::tuple<uint32_t, uint32_t, Time>>& links,
+                                        const std::vector<uint32_t>& systemIds) const
+{
+  if (m_nPartitions == 0) {
+    return systemIds;
+  }
+
+  TopologyPartitioner partitioner(systemIds.size(), m_maxImbalance);
+  for (const auto& link : links) {
+    partitioner.AddLink(std::get<0>(link), std::get<1>(link), std::get<2>(link));
+  }
+  return partitioner.Partition(m_nPartitions);
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader()
 {
   NS_LOG_FUNCTION(this);
@@ -174,6 +214,15 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct NodeLine {
+    string name;
+    double latitude;
+    double longitude;
+  };
+  vector<NodeLine> nodeLines;
+  vector<uint32_t> systemIds;
+  map<string, uint32_t> nodeIndices;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -191,22 +240,22 @@ AnnotatedTopologyReader::Read(void)
     if (name.empty())
       continue;
 
-    Ptr<Node> node;
-
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
-    }
+    nodeIndices[name] = nodeLines.size();
+    nodeLines.push_back({name, latitude, longitude});
+    systemIds.push_back(systemId);
   }
+  bool hasLinkSection = !topgen.eof();
 
   map<string, set<string>> processedLinks; // to eliminate duplications
 
-  if (topgen.eof()) {
+  struct LinkLine {
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  };
+  vector<LinkLine> linkLines;
+  vector<tuple<uint32_t, uint32_t, Time>> linkDelays;
+
+  if (!hasLinkSection) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
-    return m_nodes;
   }
 
   // SeekToSection ("link");
@@ -231,29 +280,59 @@ AnnotatedTopologyReader::Read(void)
     }
     processedLinks[from].insert(to);
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    NS_ASSERT_MSG(nodeIndices.count(from) > 0, from << " node not found");
+    NS_ASSERT_MSG(nodeIndices.count(to) > 0, to << " node not found");
+
+    linkLines.push_back({from, to, capacity, metric, delay, maxPackets, lossRate});
+    linkDelays.push_back(make_tuple(nodeIndices[from], nodeIndices[to],
+                                    delay.empty() ? getDefaultChannelDelay() : Time(delay)));
+  }
+
+  // nodes are created once all links are known, so that they can be partitioned by link delays
+  systemIds = PartitionNodes(linkDelays, systemIds);
+
+  for (size_t i = 0; i < nodeLines.size(); ++i) {
+    const NodeLine& nodeLine = nodeLines[i];
+
+    if (abs(nodeLine.latitude) > 0.001 && abs(nodeLine.latitude) > 0.001)
+      CreateNode(nodeLine.name, m_scale * nodeLine.longitude, -m_scale * nodeLine.latitude,
+                 systemIds[i]);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      CreateNode(nodeLine.name, var->GetValue(0, 200), var->GetValue(0, 200), systemIds[i]);
+      // node = CreateNode (name, systemId);
+    }
+  }
+
+  if (!hasLinkSection) {
+    return m_nodes;
+  }
+
+  for (const LinkLine& linkLine : linkLines) {
+    Ptr<Node> fromNode = Names::Find<Node>(m_path, linkLine.from);
+    NS_ASSERT_MSG(fromNode != 0, linkLine.from << " node not found");
+    Ptr<Node> toNode = Names::Find<Node>(m_path, linkLine.to);
+    NS_ASSERT_MSG(toNode != 0, linkLine.to << " node not found");
 
-    Link link(fromNode, from, toNode, to);
+    Link link(fromNode, linkLine.from, toNode, linkLine.to);
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+    link.SetAttribute("DataRate", linkLine.capacity);
+    link.SetAttribute("OSPF", linkLine.metric);
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    if (!linkLine.delay.empty())
+      link.SetAttribute("Delay", linkLine.delay);
+    if (!linkLine.maxPackets.empty())
+      link.SetAttribute("MaxPackets", linkLine.maxPackets);
 
     // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+    if (!linkLine.lossRate.empty())
+      link.SetAttribute("LossRate", linkLine.lossRate);
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << linkLine.from << " <==> " << linkLine.to << " / "
+                             << linkLine.capacity << " with " << linkLine.metric << " metric ("
+                             << linkLine.delay << ", " << linkLine.maxPackets << ", "
+                             << linkLine.lossRate << ")");
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
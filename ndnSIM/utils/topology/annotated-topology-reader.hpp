@@ -25,6 +25,10 @@
 #include "ns3/topology-reader.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
+#include "ns3/nstime.h"
+
+#include <tuple>
+#include <vector>
 
 namespace ns3 {
 
@@ -97,6 +101,22 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Partition nodes automatically across \p nPartitions system IDs (MPI ranks)
+   *
+   * Must be called before Read().  System IDs in the topology file are then ignored, and
+   * nodes are assigned by TopologyPartitioner, which maximizes the smallest delay of links
+   * between partitions (the lookahead of the distributed simulator) and minimizes the number
+   * of such links.  Every rank computes the same partitions.
+   *
+   * \param nPartitions number of partitions, usually MpiInterface::GetSize(); 0 to use
+   *        system IDs of the topology file
+   * \param maxImbalance allowed relative excess of the number of nodes of any partition over
+   *        the even share
+   */
+  void
+  SetPartitions(uint32_t nPartitions, double maxImbalance = 0.1);
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -122,6 +142,15 @@ protected:
   Ptr<Node>
   CreateNode(const std::string name, double posX, double posY, uint32_t systemId);
 
+  /**
+   * \brief Get system IDs of nodes, computed by TopologyPartitioner if enabled by SetPartitions()
+   * \param links (from, to, delay) of every link, nodes are identified by their indices
+   * \param systemIds system IDs of nodes given by the topology
+   */
+  std::vector<uint32_t>
+  PartitionNodes(const std::vector<std::tuple<uint32_t, uint32_t, Time>>& links,
+                 const std::vector<uint32_t>& systemIds) const;
+
 protected:
   /**
    * \brief This method applies setting to corresponding nodes and links
@@ -147,6 +176,8 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  uint32_t m_nPartitions;
+  double m_maxImbalance;
 };
 }
 
@@ -93,15 +93,11 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
-void
-RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
+RocketfuelMapReader::LinkParams
+RocketfuelMapReader::DrawLink(string nodeName1, string nodeName2, double averageRtt,
+                              const string& minBw, const string& maxBw, const string& minDelay,
+                              const string& maxDelay)
 {
-  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
-  Link link(node1, nodeName1, node2, nodeName2);
-
   DataRate randBandwidth(
     m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
                           static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
@@ -116,11 +112,22 @@ RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double avera
 
   uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
 
-  link.SetAttribute("DataRate", boost::lexical_cast<string>(randBandwidth));
-  link.SetAttribute("OSPF", boost::lexical_cast<string>(metric));
+  return {nodeName1, nodeName2, randBandwidth, metric,
+          MicroSeconds(static_cast<uint64_t>(ceil(randDelay.ToDouble(Time::US)))), queue};
+}
+
+void
+RocketfuelMapReader::CreateLink(const LinkParams& params)
+{
+  Ptr<Node> node1 = Names::Find<Node>(m_path, params.nodeName1);
+  Ptr<Node> node2 = Names::Find<Node>(m_path, params.nodeName2);
+  Link link(node1, params.nodeName1, node2, params.nodeName2);
+
+  link.SetAttribute("DataRate", boost::lexical_cast<string>(params.bandwidth));
+  link.SetAttribute("OSPF", boost::lexical_cast<string>(params.metric));
   link.SetAttribute("Delay",
-                    boost::lexical_cast<string>(ceil(randDelay.ToDouble(Time::US))) + "us");
-  link.SetAttribute("MaxPackets", boost::lexical_cast<string>(queue));
+                    boost::lexical_cast<string>(params.delay.GetMicroSeconds()) + "us");
+  link.SetAttribute("MaxPackets", boost::lexical_cast<string>(params.queue));
 
   AddLink(link);
 }
@@ -396,33 +403,33 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
   }
 
+  // Link parameters are drawn before nodes are created, so that nodes can be partitioned by
+  // link delays.  Nodes are named after their type.
+  std::vector<Traits::vertex_descriptor> nodeVertices;
+  std::map<Traits::vertex_descriptor, uint32_t> nodeIndices;
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
-
     node_type_t type = get(vertex_rank, m_graph, *v);
     switch (type) {
     case BACKBONE:
-      Names::Rename(nodeName, "bb-" + nodeName);
       put(vertex_name, m_graph, *v, "bb-" + nodeName);
-      m_backboneRouters.Add(node);
       break;
     case CLIENT:
-      Names::Rename(nodeName, "leaf-" + nodeName);
       put(vertex_name, m_graph, *v, "leaf-" + nodeName);
-      m_customerRouters.Add(node);
       break;
     case GATEWAY:
-      Names::Rename(nodeName, "gw-" + nodeName);
       put(vertex_name, m_graph, *v, "gw-" + nodeName);
-      m_gatewayRouters.Add(node);
       break;
     case UNKNOWN:
       NS_FATAL_ERROR("Should not happen");
       break;
     }
+    nodeIndices[*v] = nodeVertices.size();
+    nodeVertices.push_back(*v);
   }
 
+  std::vector<LinkParams> links;
+  std::vector<std::tuple<uint32_t, uint32_t, Time>> linkDelays;
   for (tie(e, ende) = edges(m_graph); e != ende; e++) {
     Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
 
@@ -431,25 +438,51 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
 
     if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
+      links.push_back(DrawLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth,
+                               params.maxb2bBandwidth, params.minb2bDelay, params.maxb2bDelay));
     }
     else if ((u_type == GATEWAY && v_type == BACKBONE)
              || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      links.push_back(DrawLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth,
+                               params.maxb2gBandwidth, params.minb2gDelay, params.maxb2gDelay));
     }
     else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      links.push_back(DrawLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth,
+                               params.maxb2gBandwidth, params.minb2gDelay, params.maxb2gDelay));
     }
     else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
+      links.push_back(DrawLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth,
+                               params.maxg2cBandwidth, params.ming2cDelay, params.maxg2cDelay));
     }
     else {
       NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
     }
+    linkDelays.push_back(std::make_tuple(nodeIndices[u], nodeIndices[v], links.back().delay));
+  }
+
+  std::vector<uint32_t> systemIds =
+    PartitionNodes(linkDelays, std::vector<uint32_t>(nodeVertices.size(), 0));
+
+  for (size_t i = 0; i < nodeVertices.size(); ++i) {
+    Ptr<Node> node = CreateNode(get(vertex_name, m_graph, nodeVertices[i]), systemIds[i]);
+
+    switch (get(vertex_rank, m_graph, nodeVertices[i])) {
+    case BACKBONE:
+      m_backboneRouters.Add(node);
+      break;
+    case CLIENT:
+      m_customerRouters.Add(node);
+      break;
+    case GATEWAY:
+      m_gatewayRouters.Add(node);
+      break;
+    case UNKNOWN:
+      break;
+    }
+  }
+
+  for (const LinkParams& link : links) {
+    CreateLink(link);
   }
 
   ApplySettings();
@@ -133,9 +133,24 @@ private:
   void
   GenerateFromMapsFile(int argc, char* argv[]);
 
+  /**
+   * \brief Randomly chosen parameters of a link, drawn before nodes are created
+   */
+  struct LinkParams {
+    string nodeName1;
+    string nodeName2;
+    DataRate bandwidth;
+    int32_t metric;
+    Time delay;
+    uint32_t queue;
+  };
+
+  LinkParams
+  DrawLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
+           const string& maxBw, const string& minDelay, const string& maxDelay);
+
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  CreateLink(const LinkParams& params);
   void
   KeepOnlyBiggestConnectedComponent();
 
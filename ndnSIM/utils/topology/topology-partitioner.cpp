@@ -0,0 +1,315 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t NO_PARTITION = std::numeric_limits<uint32_t>::max();
+
+TopologyPartitioner::TopologyPartitioner(uint32_t nNodes, double maxImbalance)
+  : m_nNodes(nNodes)
+  , m_maxImbalance(maxImbalance)
+  , m_lookahead(Time::Max())
+  , m_nCutLinks(0)
+{
+  NS_ASSERT(maxImbalance >= 0);
+}
+
+void
+TopologyPartitioner::AddLink(uint32_t from, uint32_t to, Time delay)
+{
+  NS_ASSERT(from < m_nNodes && to < m_nNodes);
+  m_links.push_back({from, to, delay.GetNanoSeconds()});
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::MakeClusters(int64_t minDelay, uint32_t& nClusters) const
+{
+  std::vector<uint32_t> parent(m_nNodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto findRoot = [&parent] (uint32_t node) {
+    while (parent[node] != node) {
+      parent[node] = parent[parent[node]];
+      node = parent[node];
+    }
+    return node;
+  };
+
+  for (const Link& link : m_links) {
+    if (link.delay < minDelay) {
+      uint32_t from = findRoot(link.from);
+      uint32_t to = findRoot(link.to);
+      parent[std::max(from, to)] = std::min(from, to);
+    }
+  }
+
+  std::vector<uint32_t> clusters(m_nNodes);
+  std::vector<uint32_t> rootCluster(m_nNodes, NO_PARTITION);
+  nClusters = 0;
+  for (uint32_t node = 0; node < m_nNodes; ++node) {
+    uint32_t root = findRoot(node);
+    if (rootCluster[root] == NO_PARTITION) {
+      rootCluster[root] = nClusters++;
+    }
+    clusters[node] = rootCluster[root];
+  }
+  return clusters;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::PackClusters(const std::vector<uint32_t>& sizes, uint32_t nPartitions,
+                                  uint32_t capacity) const
+{
+  if (sizes.size() < nPartitions) {
+    return {}; // some partition would be empty
+  }
+
+  std::vector<uint32_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&sizes] (uint32_t a, uint32_t b) { return sizes[a] > sizes[b]; });
+
+  std::vector<uint32_t> loads(nPartitions, 0);
+  std::vector<uint32_t> partitions(sizes.size());
+  for (uint32_t cluster : order) {
+    uint32_t partition = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    if (loads[partition] + sizes[cluster] > capacity) {
+      return {};
+    }
+    loads[partition] += sizes[cluster];
+    partitions[cluster] = partition;
+  }
+  return partitions;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::Partition(uint32_t nPartitions)
+{
+  NS_ASSERT(nPartitions > 0);
+  m_lookahead = Time::Max();
+  m_nCutLinks = 0;
+
+  nPartitions = std::min(nPartitions, m_nNodes);
+  if (nPartitions <= 1) {
+    return std::vector<uint32_t>(m_nNodes, 0);
+  }
+
+  uint32_t evenShare = (m_nNodes + nPartitions - 1) / nPartitions;
+  uint32_t capacity = std::max(evenShare, static_cast<uint32_t>(std::ceil(
+                                 m_nNodes * (1 + m_maxImbalance) / nPartitions)));
+
+  // Links with delay below a threshold are kept inside partitions.  Thresholds are the link
+  // delays themselves; the smallest one keeps no link, so it is always feasible as long as
+  // there are at least as many nodes as partitions.
+  std::vector<int64_t> thresholds;
+  for (const Link& link : m_links) {
+    thresholds.push_back(link.delay);
+  }
+  std::sort(thresholds.begin(), thresholds.end());
+  thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+  thresholds.push_back(std::numeric_limits<int64_t>::max());
+
+  auto getSizes = [this] (const std::vector<uint32_t>& clusters, uint32_t nClusters) {
+    std::vector<uint32_t> sizes(nClusters, 0);
+    for (uint32_t node = 0; node < m_nNodes; ++node) {
+      ++sizes[clusters[node]];
+    }
+    return sizes;
+  };
+
+  size_t low = 0;
+  size_t high = thresholds.size() - 1;
+  while (low < high) {
+    size_t middle = (low + high + 1) / 2;
+    uint32_t nClusters = 0;
+    std::vector<uint32_t> clusters = MakeClusters(thresholds[middle], nClusters);
+    if (!PackClusters(getSizes(clusters, nClusters), nPartitions, capacity).empty()) {
+      low = middle;
+    }
+    else {
+      high = middle - 1;
+    }
+  }
+
+  uint32_t nClusters = 0;
+  std::vector<uint32_t> clusters = MakeClusters(thresholds[low], nClusters);
+  std::vector<uint32_t> sizes = getSizes(clusters, nClusters);
+  NS_LOG_DEBUG(nClusters << " clusters of nodes connected by links with delay below "
+               << NanoSeconds(thresholds[low]));
+
+  // number of links between clusters
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> neighbors(nClusters);
+  {
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> nLinks;
+    for (const Link& link : m_links) {
+      uint32_t from = clusters[link.from];
+      uint32_t to = clusters[link.to];
+      if (from != to) {
+        ++nLinks[std::make_pair(from, to)];
+        ++nLinks[std::make_pair(to, from)];
+      }
+    }
+    for (const auto& item : nLinks) {
+      neighbors[item.first.first].push_back(std::make_pair(item.first.second, item.second));
+    }
+  }
+
+  // Grow partitions one by one from the largest unassigned cluster, adding clusters with most
+  // links into the partition first.  The last partition takes all remaining clusters.
+  std::vector<uint32_t> bySize(nClusters);
+  std::iota(bySize.begin(), bySize.end(), 0);
+  std::stable_sort(bySize.begin(), bySize.end(),
+                   [&sizes] (uint32_t a, uint32_t b) { return sizes[a] > sizes[b]; });
+
+  std::vector<uint32_t> partitions(nClusters, NO_PARTITION);
+  std::vector<uint32_t> loads(nPartitions, 0);
+  uint32_t nRemaining = m_nNodes;
+  for (uint32_t partition = 0; partition < nPartitions; ++partition) {
+    bool isLast = partition + 1 == nPartitions;
+    uint32_t target = (nRemaining + (nPartitions - partition) - 1) / (nPartitions - partition);
+
+    std::vector<uint32_t> connections(nClusters, 0);
+    std::set<std::pair<uint32_t, uint32_t>> frontier; // (max - connections, cluster)
+    auto next = bySize.begin();
+
+    while (isLast || loads[partition] < target) {
+      uint32_t cluster = NO_PARTITION;
+      while (!frontier.empty() && cluster == NO_PARTITION) {
+        uint32_t candidate = frontier.begin()->second;
+        frontier.erase(frontier.begin());
+        if (partitions[candidate] == NO_PARTITION &&
+            (isLast || loads[partition] + sizes[candidate] <= capacity)) {
+          cluster = candidate;
+        }
+      }
+      for (; cluster == NO_PARTITION && next != bySize.end(); ++next) {
+        if (partitions[*next] == NO_PARTITION &&
+            (isLast || loads[partition] + sizes[*next] <= capacity)) {
+          cluster = *next;
+        }
+      }
+      if (cluster == NO_PARTITION) {
+        break;
+      }
+
+      partitions[cluster] = partition;
+      loads[partition] += sizes[cluster];
+      nRemaining -= sizes[cluster];
+      for (const auto& neighbor : neighbors[cluster]) {
+        if (partitions[neighbor.first] == NO_PARTITION) {
+          uint32_t& count = connections[neighbor.first];
+          frontier.erase(std::make_pair(std::numeric_limits<uint32_t>::max() - count,
+                                        neighbor.first));
+          count += neighbor.second;
+          frontier.insert(std::make_pair(std::numeric_limits<uint32_t>::max() - count,
+                                         neighbor.first));
+        }
+      }
+    }
+  }
+
+  if (*std::max_element(loads.begin(), loads.end()) > capacity) {
+    NS_LOG_DEBUG("Grown partitions exceed capacity " << capacity << ", packing clusters instead");
+    partitions = PackClusters(sizes, nPartitions, capacity);
+    NS_ASSERT(!partitions.empty());
+    std::fill(loads.begin(), loads.end(), 0);
+    for (uint32_t cluster = 0; cluster < nClusters; ++cluster) {
+      loads[partitions[cluster]] += sizes[cluster];
+    }
+  }
+
+  // Move clusters to the partition they have most links to, while it reduces cut links and
+  // the partition has room.  A partition is never left empty.
+  std::vector<uint32_t> nPartitionClusters(nPartitions, 0);
+  for (uint32_t partition : partitions) {
+    ++nPartitionClusters[partition];
+  }
+  std::vector<uint32_t> connections(nPartitions, 0);
+  for (int pass = 0; pass < 16; ++pass) {
+    bool hasMoved = false;
+    for (uint32_t cluster = 0; cluster < nClusters; ++cluster) {
+      uint32_t current = partitions[cluster];
+      if (nPartitionClusters[current] == 1) {
+        continue;
+      }
+
+      for (const auto& neighbor : neighbors[cluster]) {
+        connections[partitions[neighbor.first]] += neighbor.second;
+      }
+      uint32_t best = current;
+      for (const auto& neighbor : neighbors[cluster]) {
+        uint32_t partition = partitions[neighbor.first];
+        if (connections[partition] > connections[best] &&
+            loads[partition] + sizes[cluster] <= capacity) {
+          best = partition;
+        }
+      }
+      for (const auto& neighbor : neighbors[cluster]) {
+        connections[partitions[neighbor.first]] = 0;
+      }
+
+      if (best != current) {
+        partitions[cluster] = best;
+        loads[current] -= sizes[cluster];
+        loads[best] += sizes[cluster];
+        --nPartitionClusters[current];
+        ++nPartitionClusters[best];
+        hasMoved = true;
+      }
+    }
+    if (!hasMoved) {
+      break;
+    }
+  }
+
+  std::vector<uint32_t> systemIds(m_nNodes);
+  for (uint32_t node = 0; node < m_nNodes; ++node) {
+    systemIds[node] = partitions[clusters[node]];
+  }
+
+  int64_t lookahead = std::numeric_limits<int64_t>::max();
+  for (const Link& link : m_links) {
+    if (systemIds[link.from] != systemIds[link.to]) {
+      ++m_nCutLinks;
+      lookahead = std::min(lookahead, link.delay);
+    }
+  }
+  if (m_nCutLinks > 0) {
+    m_lookahead = NanoSeconds(lookahead);
+  }
+
+  NS_LOG_INFO(m_nNodes << " nodes in " << nPartitions << " partitions (at most " << capacity
+              << " nodes each), " << m_nCutLinks << " cut links, lookahead " << m_lookahead);
+  return systemIds;
+}
+
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Partitions a topology across logical processors (MPI ranks) of a distributed simulation
+ *
+ * Links cut by the partitioning become remote links.  A distributed simulator can only advance
+ * every rank by the smallest delay of the remote links (the lookahead) before it synchronizes
+ * ranks, so the partitioner first keeps links with small delays inside partitions: it finds the
+ * largest delay D such that all links with delay below D can be kept inside partitions without
+ * exceeding the allowed partition size.  Nodes connected by such links are never separated.
+ * Within this constraint, the number of cut links is then minimized by growing partitions along
+ * links and moving nodes between partitions while it reduces the number of cut links.
+ *
+ * The partitioning is deterministic, so every rank that reads the same topology computes the
+ * same partitions without communication.
+ */
+class TopologyPartitioner {
+public:
+  /**
+   * \brief Create a partitioner for a topology of \p nNodes nodes
+   * \param nNodes number of nodes, which are identified by indices 0..nNodes-1
+   * \param maxImbalance allowed relative excess of the number of nodes of any partition over
+   *        the even share
+   */
+  explicit TopologyPartitioner(uint32_t nNodes, double maxImbalance = 0.1);
+
+  /**
+   * \brief Add a link between nodes with indices \p from and \p to
+   */
+  void
+  AddLink(uint32_t from, uint32_t to, Time delay);
+
+  /**
+   * \brief Assign nodes to \p nPartitions partitions
+   * \return partition (system ID) of every node
+   */
+  std::vector<uint32_t>
+  Partition(uint32_t nPartitions);
+
+  /**
+   * \brief Get the smallest delay of links cut by the last partitioning
+   *
+   * Time::Max() if no link is cut.
+   */
+  Time
+  GetLookahead() const
+  {
+    return m_lookahead;
+  }
+
+  /**
+   * \brief Get the number of links cut by the last partitioning
+   */
+  uint32_t
+  GetNCutLinks() const
+  {
+    return m_nCutLinks;
+  }
+
+private:
+  struct Link {
+    uint32_t from;
+    uint32_t to;
+    int64_t delay; ///< in nanoseconds
+  };
+
+  /**
+   * \brief Group nodes connected by links with delay below \p minDelay
+   * \return cluster index of every node; clusters are numbered 0..nClusters-1
+   */
+  std::vector<uint32_t>
+  MakeClusters(int64_t minDelay, uint32_t& nClusters) const;
+
+  /**
+   * \brief Pack clusters into partitions, largest first into the least loaded partition
+   * \return partition of every cluster, or empty vector if partitions would exceed capacity
+   *         or some partition would be empty
+   */
+  std::vector<uint32_t>
+  PackClusters(const std::vector<uint32_t>& sizes, uint32_t nPartitions, uint32_t capacity) const;
+
+private:
+  uint32_t m_nNodes;
+  double m_maxImbalance;
+  std::vector<Link> m_links;
+
+  Time m_lookahead;
+  uint32_t m_nCutLinks;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
@@ -22,6 +22,7 @@
 #include "ns3/packet.h"
 #include "ns3/config.h"
 #include "ns3/names.h"
+#include "ns3/string.h"
 #include "ns3/callback.h"
 
 #include "apps/ndn-app.hpp"
@@ -49,34 +50,27 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file,
+                           TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = writer != nullptr ? Install(*node, writer)
+                                                  : Install(*node, outputStream);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -86,34 +80,27 @@ AppDelayTracer::InstallAll(const std::string& file)
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = writer != nullptr ? Install(*node, writer)
+                                                  : Install(*node, outputStream);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -123,32 +110,25 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = writer != nullptr ? Install(node, writer)
+                                                : Install(node, outputStream);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -167,6 +147,82 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
   return trace;
 }
 
+void
+AppDelayTracer::InstallAllAggregated(const std::string& file, Time averagingPeriod /* = Seconds(1.0)*/,
+                                     bool perPrefix /* = false*/)
+{
+  InstallAggregated(NodeContainer::GetGlobal(), file, averagingPeriod, perPrefix);
+}
+
+void
+AppDelayTracer::InstallAggregated(Ptr<Node> node, const std::string& file,
+                                  Time averagingPeriod /* = Seconds(1.0)*/,
+                                  bool perPrefix /* = false*/)
+{
+  InstallAggregated(NodeContainer(node), file, averagingPeriod, perPrefix);
+}
+
+void
+AppDelayTracer::InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                                  Time averagingPeriod /* = Seconds(1.0)*/,
+                                  bool perPrefix /* = false*/)
+{
+  std::list<Ptr<AppDelayTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, TraceFormat::TSV);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = InstallAggregated(*node, outputStream, averagingPeriod, perPrefix);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::InstallAggregated(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                                  Time averagingPeriod, bool perPrefix /* = false*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node, averagingPeriod,
+                                                     perPrefix);
+
+  return trace;
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(writer, node);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+AppDelayTracer::GetBinaryColumns()
+{
+  return {{"Time", BinaryTraceColumn::DOUBLE},
+          {"Node", BinaryTraceColumn::STRING},
+          {"AppId", BinaryTraceColumn::INTEGER},
+          {"SeqNo", BinaryTraceColumn::INTEGER},
+          {"Type", BinaryTraceColumn::STRING},
+          {"DelayS", BinaryTraceColumn::DOUBLE},
+          {"DelayUS", BinaryTraceColumn::DOUBLE},
+          {"RetxCount", BinaryTraceColumn::INTEGER},
+          {"HopCount", BinaryTraceColumn::INTEGER}};
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +230,8 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_isAggregated(false)
+  , m_isPerPrefix(false)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +246,57 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_isAggregated(false)
+  , m_isPerPrefix(false)
+{
+  Connect();
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+  , m_isAggregated(false)
+  , m_isPerPrefix(false)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node, Time averagingPeriod,
+                               bool perPrefix)
+  : m_nodePtr(node)
+  , m_os(os)
+  , m_isAggregated(true)
+  , m_isPerPrefix(perPrefix)
+  , m_period(averagingPeriod)
 {
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
   Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+  m_flushEvent = Simulator::ScheduleDestroy(&AppDelayTracer::FlushPeriod, this);
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  if (m_isAggregated && m_printEvent.IsRunning()) {
+    FlushPeriod();
+  }
+  m_printEvent.Cancel();
+  m_flushEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -209,6 +313,31 @@ AppDelayTracer::Connect()
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (m_isAggregated) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Prefix"
+       << "\t"
+       << "Type"
+       << "\t"
+       << "Count"
+       << "\t"
+       << "MinUS"
+       << "\t"
+       << "P50US"
+       << "\t"
+       << "P99US"
+       << "\t"
+       << "P999US"
+       << "\t"
+       << "MaxUS";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -234,6 +363,16 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_isAggregated) {
+    GetHistograms(app).lastDelay.Add(delay.GetNanoSeconds());
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    WriteRecord(app, seqno, "LastDelay", delay, 1, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +384,16 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_isAggregated) {
+    GetHistograms(app).fullDelay.Add(delay.GetNanoSeconds());
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    WriteRecord(app, seqno, "FullDelay", delay, retxCount, hopCount);
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -252,5 +401,84 @@ AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
         << "\t" << hopCount << "\n";
 }
 
+void
+AppDelayTracer::WriteRecord(Ptr<App> app, uint32_t seqno, const std::string& type, Time delay,
+                            uint32_t retxCount, int32_t hopCount)
+{
+  m_writer->AddDouble(Simulator::Now().ToDouble(Time::S));
+  m_writer->AddString(m_node);
+  m_writer->AddInteger(app->GetId());
+  m_writer->AddInteger(seqno);
+  m_writer->AddString(type);
+  m_writer->AddDouble(delay.ToDouble(Time::S));
+  m_writer->AddDouble(delay.ToDouble(Time::US));
+  m_writer->AddInteger(retxCount);
+  m_writer->AddInteger(hopCount);
+  m_writer->EndRow();
+}
+
+AppDelayTracer::DelayHistograms&
+AppDelayTracer::GetHistograms(Ptr<App> app)
+{
+  auto cached = m_appHistograms.find(app->GetId());
+  if (cached != m_appHistograms.end()) {
+    return *cached->second;
+  }
+
+  StringValue prefix("-");
+  app->GetAttributeFailSafe("Prefix", prefix);
+
+  auto key = std::make_pair(m_isPerPrefix ? -1 : static_cast<int64_t>(app->GetId()), prefix.Get());
+  DelayHistograms* histograms = &m_histograms[key];
+  m_appHistograms[app->GetId()] = histograms;
+  return *histograms;
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  for (auto& entry : m_histograms) {
+    entry.second.lastDelay.Reset();
+    entry.second.fullDelay.Reset();
+  }
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::FlushPeriod()
+{
+  // print the partial period since the last PeriodicPrinter call, which would be lost otherwise
+  m_printEvent.Cancel();
+  Print(*m_os);
+
+  for (auto& entry : m_histograms) {
+    entry.second.lastDelay.Reset();
+    entry.second.fullDelay.Reset();
+  }
+}
+
+#define PRINTER(printName, histogram)                                                              \
+  if (histogram.GetCount() > 0) {                                                                  \
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << entry.first.first << "\t"            \
+       << entry.first.second << "\t" << printName << "\t" << histogram.GetCount() << "\t"          \
+       << histogram.GetMin() / 1000.0 << "\t" << histogram.GetQuantile(0.5) / 1000.0 << "\t"      \
+       << histogram.GetQuantile(0.99) / 1000.0 << "\t" << histogram.GetQuantile(0.999) / 1000.0   \
+       << "\t" << histogram.GetMax() / 1000.0 << "\n";                                             \
+  }
+
+void
+AppDelayTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+
+  for (const auto& entry : m_histograms) {
+    PRINTER("LastDelay", entry.second.lastDelay);
+    PRINTER("FullDelay", entry.second.fullDelay);
+  }
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -21,6 +21,8 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ndn-latency-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +32,8 @@
 
 #include <tuple>
 #include <list>
+#include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -50,20 +54,23 @@ public:
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Format of the trace file (default, tab-separated text)
    *
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Format of the trace file (default, tab-separated text)
    *
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -72,9 +79,10 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *        second)
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -91,11 +99,84 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracer writing binary records on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param writer Writer created with the columns returned by GetBinaryColumns
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer);
+
+  /**
+   * @brief Get columns of the binary trace, which match the columns of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
+  /**
+   * @brief Helper method to install aggregating tracers on all simulation nodes
+   *
+   * Instead of a line per received Data packet, aggregating tracers keep streaming histograms of
+   * delays and, every @p averagingPeriod, write the number of delays and their minimum, median,
+   * 99th and 99.9th percentiles, and maximum (see LatencyHistogram).
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *        second)
+   * @param perPrefix If true, delays of all applications of a node that request the same prefix
+   *        are aggregated together, otherwise each application is aggregated separately
+   */
+  static void
+  InstallAllAggregated(const std::string& file, Time averagingPeriod = Seconds(1.0),
+                       bool perPrefix = false);
+
+  /**
+   * @brief Helper method to install aggregating tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *        second)
+   * @param perPrefix If true, delays are aggregated per requested prefix instead of per application
+   */
+  static void
+  InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                    Time averagingPeriod = Seconds(1.0), bool perPrefix = false);
+
+  /**
+   * @brief Helper method to install aggregating tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *        second)
+   * @param perPrefix If true, delays are aggregated per requested prefix instead of per application
+   */
+  static void
+  InstallAggregated(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(1.0),
+                    bool perPrefix = false);
+
+  /**
+   * @brief Helper method to install aggregating tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   * @param averagingPeriod How often data will be written into the trace file
+   * @param perPrefix If true, delays are aggregated per requested prefix instead of per application
+   */
+  static Ptr<AppDelayTracer>
+  InstallAggregated(Ptr<Node> node, shared_ptr<std::ostream> outputStream, Time averagingPeriod,
+                    bool perPrefix = false);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
    * This method can be helpful if simulation scenario contains several independent run,
-   * or if it is desired to do a postprocessing of the resulting data
+   * or if it is desired to do a postprocessing of the resulting data.
+   *
+   * Aggregated tracers print the histograms of the last, partial averaging period when they
+   * are removed, or when the simulator is destroyed, whichever happens first.
    */
   static void
   Destroy();
@@ -114,6 +195,23 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node and writes binary
+   *        records
+   * @param writer writer of the binary trace
+   * @param node   pointer to the node
+   */
+  AppDelayTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node and aggregates delays
+   * @param os              reference to the output stream
+   * @param node            pointer to the node
+   * @param averagingPeriod how often aggregated data will be written
+   * @param perPrefix       whether delays are aggregated per prefix instead of per application
+   */
+  AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node, Time averagingPeriod, bool perPrefix);
+
   /**
    * @brief Destructor
    */
@@ -127,6 +225,14 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Print aggregated delays of the current averaging period (aggregating tracer only)
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
 private:
   void
   Connect();
@@ -138,11 +244,41 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  WriteRecord(Ptr<App> app, uint32_t seqno, const std::string& type, Time delay,
+              uint32_t retxCount, int32_t hopCount);
+
+  /// @cond include_hidden
+  struct DelayHistograms {
+    LatencyHistogram lastDelay;
+    LatencyHistogram fullDelay;
+  };
+  /// @endcond
+
+  DelayHistograms&
+  GetHistograms(Ptr<App> app);
+
+  void
+  PeriodicPrinter();
+
+  void
+  FlushPeriod();
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
+
+  // aggregating tracer
+  bool m_isAggregated;
+  bool m_isPerPrefix;
+  Time m_period;
+  EventId m_printEvent;
+  EventId m_flushEvent; ///< prints the last partial period when the simulator is destroyed
+  std::map<std::pair<int64_t, std::string>, DelayHistograms> m_histograms; ///< (AppId, Prefix)
+  std::unordered_map<uint32_t, DelayHistograms*> m_appHistograms;          ///< AppId => histograms
 };
 
 } // namespace ndn
@@ -0,0 +1,318 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-binary-trace.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+const size_t BinaryTraceWriter::DEFAULT_BLOCK_SIZE = 4096;
+
+template<class T>
+static void
+writeValue(std::ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void
+writeString(std::ostream& os, const std::string& value)
+{
+  BOOST_ASSERT(value.size() <= std::numeric_limits<uint16_t>::max());
+  writeValue<uint16_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+BinaryTraceWriter::BinaryTraceWriter(shared_ptr<std::ostream> os,
+                                     const std::vector<BinaryTraceColumn>& columns,
+                                     size_t blockSize)
+  : m_os(os)
+  , m_columns(columns)
+  , m_blockSize(std::max<size_t>(blockSize, 1))
+  , m_data(columns.size())
+  , m_currentColumn(0)
+  , m_nRows(0)
+{
+  for (auto& column : m_data) {
+    column.reserve(m_blockSize);
+  }
+
+  m_os->write(MAGIC, sizeof(MAGIC));
+  writeValue(*m_os, VERSION);
+  writeValue(*m_os, BYTE_ORDER_MARK);
+  writeValue<uint16_t>(*m_os, m_columns.size());
+  for (const auto& column : m_columns) {
+    writeValue<uint8_t>(*m_os, column.type);
+    writeString(*m_os, column.name);
+  }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+  Flush();
+}
+
+void
+BinaryTraceWriter::AddValue(BinaryTraceColumn::Type type, uint64_t value)
+{
+  BOOST_ASSERT_MSG(m_currentColumn < m_columns.size(), "too many values in a row");
+  BOOST_ASSERT_MSG(m_columns[m_currentColumn].type == type, "value does not match column type");
+  m_data[m_currentColumn++].push_back(value);
+}
+
+void
+BinaryTraceWriter::AddDouble(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  AddValue(BinaryTraceColumn::DOUBLE, bits);
+}
+
+void
+BinaryTraceWriter::AddInteger(int64_t value)
+{
+  AddValue(BinaryTraceColumn::INTEGER, static_cast<uint64_t>(value));
+}
+
+void
+BinaryTraceWriter::AddString(const std::string& value)
+{
+  auto entry = m_dictionary.insert(std::make_pair(value, m_dictionary.size()));
+  if (entry.second) {
+    m_newStrings.push_back(&entry.first->first);
+  }
+  AddValue(BinaryTraceColumn::STRING, entry.first->second);
+}
+
+void
+BinaryTraceWriter::EndRow()
+{
+  BOOST_ASSERT_MSG(m_currentColumn == m_columns.size(), "too few values in a row");
+  m_currentColumn = 0;
+  if (++m_nRows == m_blockSize) {
+    WriteBlock();
+  }
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+  if (m_nRows > 0) {
+    WriteBlock();
+  }
+  m_os->flush();
+}
+
+void
+BinaryTraceWriter::WriteBlock()
+{
+  writeValue<uint32_t>(*m_os, m_nRows);
+  writeValue<uint32_t>(*m_os, m_newStrings.size());
+  for (const std::string* value : m_newStrings) {
+    writeString(*m_os, *value);
+  }
+  m_newStrings.clear();
+
+  for (auto& column : m_data) {
+    m_os->write(reinterpret_cast<const char*>(column.data()), m_nRows * sizeof(uint64_t));
+    // values of an incomplete row stay for the next block
+    column.erase(column.begin(), column.begin() + m_nRows);
+  }
+  m_nRows = 0;
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+  , m_nRows(0)
+{
+  char magic[sizeof(MAGIC)];
+  if (!m_is.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    BOOST_THROW_EXCEPTION(Error("Not an ndnSIM binary trace"));
+  }
+  if (Read<uint32_t>() != VERSION) {
+    BOOST_THROW_EXCEPTION(Error("Unsupported binary trace version"));
+  }
+  if (Read<uint32_t>() != BYTE_ORDER_MARK) {
+    BOOST_THROW_EXCEPTION(Error("Binary trace was written with a different byte order"));
+  }
+
+  uint16_t nColumns = Read<uint16_t>();
+  for (uint16_t i = 0; i < nColumns; ++i) {
+    uint8_t type = Read<uint8_t>();
+    if (type > BinaryTraceColumn::STRING) {
+      BOOST_THROW_EXCEPTION(Error("Unknown column type " + std::to_string(type)));
+    }
+    m_columns.push_back({ReadString(), static_cast<BinaryTraceColumn::Type>(type)});
+  }
+  m_data.resize(m_columns.size());
+}
+
+template<class T>
+T
+BinaryTraceReader::Read()
+{
+  T value;
+  if (!m_is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    BOOST_THROW_EXCEPTION(Error("Binary trace is truncated"));
+  }
+  return value;
+}
+
+std::string
+BinaryTraceReader::ReadString()
+{
+  std::string value(Read<uint16_t>(), '\0');
+  if (!m_is.read(&value[0], value.size())) {
+    BOOST_THROW_EXCEPTION(Error("Binary trace is truncated"));
+  }
+  return value;
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+  uint32_t nRows;
+  if (!m_is.read(reinterpret_cast<char*>(&nRows), sizeof(nRows))) {
+    m_nRows = 0;
+    return false;
+  }
+
+  uint32_t nNewStrings = Read<uint32_t>();
+  for (uint32_t i = 0; i < nNewStrings; ++i) {
+    m_dictionary.push_back(ReadString());
+  }
+
+  for (size_t column = 0; column < m_columns.size(); ++column) {
+    m_data[column].resize(nRows);
+    if (!m_is.read(reinterpret_cast<char*>(m_data[column].data()), nRows * sizeof(uint64_t))) {
+      BOOST_THROW_EXCEPTION(Error("Binary trace is truncated"));
+    }
+    if (m_columns[column].type == BinaryTraceColumn::STRING) {
+      for (uint64_t value : m_data[column]) {
+        if (value >= m_dictionary.size()) {
+          BOOST_THROW_EXCEPTION(Error("String index is out of range"));
+        }
+      }
+    }
+  }
+  m_nRows = nRows;
+  return true;
+}
+
+double
+BinaryTraceReader::GetDouble(size_t column, size_t row) const
+{
+  BOOST_ASSERT(m_columns[column].type == BinaryTraceColumn::DOUBLE);
+  double value;
+  std::memcpy(&value, &m_data[column][row], sizeof(value));
+  return value;
+}
+
+int64_t
+BinaryTraceReader::GetInteger(size_t column, size_t row) const
+{
+  BOOST_ASSERT(m_columns[column].type == BinaryTraceColumn::INTEGER);
+  return static_cast<int64_t>(m_data[column][row]);
+}
+
+const std::string&
+BinaryTraceReader::GetString(size_t column, size_t row) const
+{
+  BOOST_ASSERT(m_columns[column].type == BinaryTraceColumn::STRING);
+  return m_dictionary[m_data[column][row]];
+}
+
+void
+BinaryTraceReader::WriteTsv(std::ostream& os)
+{
+  for (size_t column = 0; column < m_columns.size(); ++column) {
+    os << (column > 0 ? "\t" : "") << m_columns[column].name;
+  }
+  os << "\n";
+
+  while (ReadBlock()) {
+    for (size_t row = 0; row < m_nRows; ++row) {
+      for (size_t column = 0; column < m_columns.size(); ++column) {
+        if (column > 0) {
+          os << "\t";
+        }
+        switch (m_columns[column].type) {
+        case BinaryTraceColumn::DOUBLE:
+          os << GetDouble(column, row);
+          break;
+        case BinaryTraceColumn::INTEGER:
+          os << GetInteger(column, row);
+          break;
+        case BinaryTraceColumn::STRING:
+          os << GetString(column, row);
+          break;
+        }
+      }
+      os << "\n";
+    }
+  }
+}
+
+shared_ptr<std::ostream>
+OpenTraceStream(const std::string& file, TraceFormat format)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+  if (format == TraceFormat::BINARY) {
+    mode |= std::ios_base::binary;
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), mode);
+  if (!os->is_open()) {
+    return nullptr;
+  }
+  return os;
+}
+
+shared_ptr<std::ostream>
+OpenTraceStream(const std::string& file, TraceFormat format,
+                const std::vector<BinaryTraceColumn>& columns,
+                shared_ptr<BinaryTraceWriter>& writer)
+{
+  writer = nullptr;
+  shared_ptr<std::ostream> os = OpenTraceStream(file, format);
+  if (os != nullptr && format == TraceFormat::BINARY) {
+    writer = make_shared<BinaryTraceWriter>(os, columns);
+  }
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
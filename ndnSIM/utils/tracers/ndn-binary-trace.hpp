@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BINARY_TRACE_H
+#define NDN_BINARY_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output format of tracers
+ */
+enum class TraceFormat {
+  TSV,   ///< tab-separated text with a header line
+  BINARY ///< columnar binary records, see BinaryTraceWriter
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column of a binary trace
+ */
+struct BinaryTraceColumn {
+  enum Type : uint8_t {
+    DOUBLE = 0,
+    INTEGER = 1, ///< signed 64-bit integer
+    STRING = 2   ///< string, stored as an index into the string dictionary
+  };
+
+  std::string name;
+  Type type;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Buffered writer of columnar binary traces
+ *
+ * Rows are accumulated column by column in memory and written out in blocks.  The layout of
+ * the output is (all numbers in host byte order):
+ *
+ *     file   := "NDNTRACE" version:u32 byteOrderMark:u32 nColumns:u16 column* block*
+ *     column := type:u8 nameLength:u16 name
+ *     block  := nRows:u32 nNewStrings:u32 (length:u16 string)* columnData*
+ *
+ * Each columnData holds nRows 8-byte values: IEEE 754 doubles, signed integers, or indexes of
+ * strings.  Each distinct string is stored only once, in the block where it first appears, and
+ * gets the next index of the dictionary.
+ *
+ * BinaryTraceReader reads the format back, and can convert it into the TSV layout of tracers.
+ *
+ * Values of a row are added in column order with AddDouble, AddInteger and AddString, and the
+ * row is completed with EndRow.  Pending rows are written when the writer is destroyed.
+ */
+class BinaryTraceWriter : boost::noncopyable {
+public:
+  /**
+   * @brief Create a writer and write the trace header
+   * @param os        output stream, which should be opened in binary mode
+   * @param columns   schema of the trace
+   * @param blockSize number of rows written at once
+   */
+  BinaryTraceWriter(shared_ptr<std::ostream> os, const std::vector<BinaryTraceColumn>& columns,
+                    size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+  ~BinaryTraceWriter();
+
+  void
+  AddDouble(double value);
+
+  void
+  AddInteger(int64_t value);
+
+  void
+  AddString(const std::string& value);
+
+  void
+  EndRow();
+
+  /**
+   * @brief Write all completed rows and flush the stream
+   */
+  void
+  Flush();
+
+public:
+  static const size_t DEFAULT_BLOCK_SIZE;
+
+private:
+  void
+  AddValue(BinaryTraceColumn::Type type, uint64_t value);
+
+  void
+  WriteBlock();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<BinaryTraceColumn> m_columns;
+  size_t m_blockSize;
+
+  std::vector<std::vector<uint64_t>> m_data; ///< values of pending rows, per column
+  size_t m_currentColumn;
+  size_t m_nRows;
+
+  std::unordered_map<std::string, uint64_t> m_dictionary;
+  std::vector<const std::string*> m_newStrings; ///< entries of m_dictionary not yet written
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of traces written by BinaryTraceWriter
+ */
+class BinaryTraceReader : boost::noncopyable {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Read the trace header
+   * @throw Error the stream does not contain a binary trace
+   */
+  explicit
+  BinaryTraceReader(std::istream& is);
+
+  const std::vector<BinaryTraceColumn>&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Read the next block of rows
+   * @return false if there are no more blocks
+   * @throw Error the block is truncated
+   */
+  bool
+  ReadBlock();
+
+  /**
+   * @brief Get number of rows in the current block
+   */
+  size_t
+  GetNRows() const
+  {
+    return m_nRows;
+  }
+
+  double
+  GetDouble(size_t column, size_t row) const;
+
+  int64_t
+  GetInteger(size_t column, size_t row) const;
+
+  const std::string&
+  GetString(size_t column, size_t row) const;
+
+  /**
+   * @brief Write the header and all rows of the trace in the tab-separated layout of tracers
+   */
+  void
+  WriteTsv(std::ostream& os);
+
+private:
+  template<class T>
+  T
+  Read();
+
+  std::string
+  ReadString();
+
+private:
+  std::istream& m_is;
+  std::vector<BinaryTraceColumn> m_columns;
+  std::vector<std::string> m_dictionary;
+  std::vector<std::vector<uint64_t>> m_data;
+  size_t m_nRows;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Open the output stream of tracers
+ * @param file   name of the output file, which is truncated, or "-" for the standard output
+ * @param format output format; files of binary traces are opened in binary mode
+ * @return the stream, or nullptr if the file cannot be opened
+ */
+shared_ptr<std::ostream>
+OpenTraceStream(const std::string& file, TraceFormat format);
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Open the output stream of tracers and, for binary traces, a writer on top of it
+ * @param file    name of the output file, which is truncated, or "-" for the standard output
+ * @param format  output format
+ * @param columns schema of binary traces
+ * @param[out] writer the writer of binary traces, or nullptr for TSV traces
+ * @return the stream, or nullptr if the file cannot be opened
+ */
+shared_ptr<std::ostream>
+OpenTraceStream(const std::string& file, TraceFormat format,
+                const std::vector<BinaryTraceColumn>& columns,
+                shared_ptr<BinaryTraceWriter>& writer);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_H
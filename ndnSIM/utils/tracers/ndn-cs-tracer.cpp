@@ -48,34 +48,27 @@ CsTracer::Destroy()
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                     TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                            : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -86,34 +79,27 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                            : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -124,32 +110,25 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<CsTracer> trace = writer != nullptr ? Install(node, writer, averagingPeriod)
+                                          : Install(node, outputStream, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -170,6 +149,27 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<CsTracer> trace = Create<CsTracer>(writer, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+CsTracer::GetBinaryColumns()
+{
+  return {{"Time", BinaryTraceColumn::DOUBLE},
+          {"Node", BinaryTraceColumn::STRING},
+          {"Type", BinaryTraceColumn::STRING},
+          {"Packets", BinaryTraceColumn::DOUBLE}};
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -195,6 +195,20 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   Connect();
 }
 
+CsTracer::CsTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
 CsTracer::~CsTracer(){};
 
 void
@@ -218,7 +232,12 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -258,6 +277,22 @@ CsTracer::Print(std::ostream& os) const
   PRINTER("CacheMisses", m_cacheMisses);
 }
 
+#define WRITER(printName, fieldName)                                                               \
+  writer.AddDouble(time.ToDouble(Time::S));                                                        \
+  writer.AddString(m_node);                                                                        \
+  writer.AddString(printName);                                                                     \
+  writer.AddDouble(m_stats.fieldName);                                                             \
+  writer.EndRow();
+
+void
+CsTracer::Write(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+  WRITER("CacheHits", m_cacheHits);
+  WRITER("CacheMisses", m_cacheMisses);
+}
+
 void
 CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
 {
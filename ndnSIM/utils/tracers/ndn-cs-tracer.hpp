@@ -21,6 +21,7 @@
 #define CCNX_CS_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ndn-binary-trace.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -71,10 +72,12 @@ public:
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
    *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
+   * @param format Format of the trace file (default, tab-separated text)
    *
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -87,10 +90,12 @@ public:
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
    *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
+   * @param format Format of the trace file (default, tab-separated text)
    *
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -103,10 +108,12 @@ public:
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
    *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
+   * @param format Format of the trace file (default, tab-separated text)
    *
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -124,6 +131,24 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracer writing binary records on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param writer Writer created with the columns returned by GetBinaryColumns
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+          Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get columns of the binary trace, which match the columns of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +172,13 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer and writes binary records
+   * @param writer writer of the binary trace
+   * @param node   pointer to the node
+   */
+  CsTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,6 +200,14 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as binary records
+   *
+   * @param writer writer of the binary trace
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 private:
   void
   Connect();
@@ -193,6 +233,7 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
 
   Time m_period;
   EventId m_printEvent;
@@ -47,31 +47,54 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::SetFilterAll(const L3TracerFilter& filter)
 {
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+  for (const auto& installed : g_tracers) {
+    for (const auto& tracer : std::get<1>(installed)) {
+      tracer->SetFilter(filter);
     }
+  }
+}
 
-    outputStream = os;
+void
+L3RateTracer::AttachAll()
+{
+  for (const auto& installed : g_tracers) {
+    for (const auto& tracer : std::get<1>(installed)) {
+      tracer->Attach();
+    }
   }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+}
+
+void
+L3RateTracer::DetachAll()
+{
+  for (const auto& installed : g_tracers) {
+    for (const auto& tracer : std::get<1>(installed)) {
+      tracer->Detach();
+    }
+  }
+}
+
+void
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         TraceFormat format /* = TraceFormat::TSV*/)
+{
+  std::list<Ptr<L3RateTracer>> tracers;
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                                : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -82,34 +105,27 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                                : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -120,32 +136,25 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceFormat format /* = TraceFormat::TSV*/)
 {
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<BinaryTraceWriter> writer;
+  shared_ptr<std::ostream> outputStream = OpenTraceStream(file, format, GetBinaryColumns(), writer);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<L3RateTracer> trace = writer != nullptr ? Install(node, writer, averagingPeriod)
+                                              : Install(node, outputStream, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && writer == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -166,6 +175,32 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(writer, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+L3RateTracer::GetBinaryColumns()
+{
+  return {{"Time", BinaryTraceColumn::DOUBLE},
+          {"Node", BinaryTraceColumn::STRING},
+          {"FaceId", BinaryTraceColumn::INTEGER},
+          {"FaceDescr", BinaryTraceColumn::STRING},
+          {"Type", BinaryTraceColumn::STRING},
+          {"Packets", BinaryTraceColumn::DOUBLE},
+          {"Kilobytes", BinaryTraceColumn::DOUBLE},
+          {"PacketRaw", BinaryTraceColumn::DOUBLE},
+          {"KilobytesRaw", BinaryTraceColumn::DOUBLE}};
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
@@ -180,6 +215,13 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   SetAveragingPeriod(Seconds(1.0));
 }
 
+L3RateTracer::L3RateTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_writer(writer)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
 L3RateTracer::~L3RateTracer()
 {
   m_printEvent.Cancel();
@@ -196,7 +238,12 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -240,59 +287,97 @@ const double alpha = 0.8;
 #define STATS(INDEX) std::get<INDEX>(stats.second)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
-#define PRINTER(printName, fieldName)                                                              \
+#define RECORD(printName, fieldName)                                                               \
   STATS(2).fieldName =                                                                             \
     /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  record(stats.first, printName, STATS(2).fieldName, STATS(3).fieldName, STATS(0).fieldName,       \
+         STATS(1).fieldName / 1024.0);
 
+template<class Record>
 void
-L3RateTracer::Print(std::ostream& os) const
+L3RateTracer::ForEachRecord(const Record& record) const
 {
-  Time time = Simulator::Now();
-
   for (auto& stats : m_stats) {
     if (stats.first == nfd::face::INVALID_FACEID)
       continue;
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+    RECORD("InInterests", m_inInterests);
+    RECORD("OutInterests", m_outInterests);
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+    RECORD("InData", m_inData);
+    RECORD("OutData", m_outData);
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+    RECORD("InNacks", m_inNack);
+    RECORD("OutNacks", m_outNack);
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+    RECORD("InSatisfiedInterests", m_satisfiedInterests);
+    RECORD("InTimedOutInterests", m_timedOutInterests);
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+    RECORD("OutSatisfiedInterests", m_outSatisfiedInterests);
+    RECORD("OutTimedOutInterests", m_outTimedOutInterests);
   }
 
   {
     auto i = m_stats.find(nfd::face::INVALID_FACEID);
     if (i != m_stats.end()) {
       auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
+      RECORD("SatisfiedInterests", m_satisfiedInterests);
+      RECORD("TimedOutInterests", m_timedOutInterests);
     }
   }
 }
 
+void
+L3RateTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+
+  ForEachRecord([&] (nfd::FaceId faceId, const char* type, double packets, double kilobytes,
+                     double packetsRaw, double kilobytesRaw) {
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+    if (faceId != nfd::face::INVALID_FACEID) {
+      os << faceId << "\t";
+      NS_ASSERT(m_faceInfos.find(faceId) != m_faceInfos.end());
+      os << m_faceInfos.find(faceId)->second << "\t";
+    }
+    else {
+      os << "-1\tall\t";
+    }
+    os << type << "\t" << packets << "\t" << kilobytes << "\t" << packetsRaw << "\t"
+       << kilobytesRaw << "\n";
+  });
+}
+
+void
+L3RateTracer::Write(BinaryTraceWriter& writer) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  ForEachRecord([&] (nfd::FaceId faceId, const char* type, double packets, double kilobytes,
+                     double packetsRaw, double kilobytesRaw) {
+    writer.AddDouble(time);
+    writer.AddString(m_node);
+    if (faceId != nfd::face::INVALID_FACEID) {
+      writer.AddInteger(faceId);
+      NS_ASSERT(m_faceInfos.find(faceId) != m_faceInfos.end());
+      writer.AddString(m_faceInfos.find(faceId)->second);
+    }
+    else {
+      writer.AddInteger(-1);
+      writer.AddString("all");
+    }
+    writer.AddString(type);
+    writer.AddDouble(packets);
+    writer.AddDouble(kilobytes);
+    writer.AddDouble(packetsRaw);
+    writer.AddDouble(kilobytesRaw);
+    writer.EndRow();
+  });
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
@@ -366,11 +451,15 @@ L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, cons
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
+    if (!IsTracedFace(in.getFace()))
+      continue;
     AddInfo(in.getFace());
     std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
+    if (!IsTracedFace(out.getFace()))
+      continue;
     AddInfo(out.getFace());
     std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
   }
@@ -383,11 +472,15 @@ L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
+    if (!IsTracedFace(in.getFace()))
+      continue;
     AddInfo(in.getFace());
     std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
+    if (!IsTracedFace(out.getFace()))
+      continue;
     AddInfo(out.getFace());
     std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
   }
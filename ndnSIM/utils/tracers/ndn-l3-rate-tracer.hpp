@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-binary-trace.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -48,9 +49,11 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +62,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +75,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TSV);
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -83,6 +90,31 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Apply @p filter to all tracers installed with the file-based Install/InstallAll
+   *        methods
+   * @sa L3Tracer::SetFilter
+   */
+  static void
+  SetFilterAll(const L3TracerFilter& filter);
+
+  /**
+   * @brief Resume tracing of all tracers installed with the file-based Install/InstallAll methods
+   *
+   * Can be scheduled, e.g., Simulator::Schedule(Seconds(10), &L3RateTracer::AttachAll)
+   */
+  static void
+  AttachAll();
+
+  /**
+   * @brief Stop tracing of all tracers installed with the file-based Install/InstallAll methods
+   *
+   * The tracers keep writing their (decaying) averages, but no packets are counted until
+   * AttachAll is called.
+   */
+  static void
+  DetachAll();
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -97,6 +129,13 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer and writes binary records
+   * @param writer writer of the binary trace
+   * @param node   pointer to the node
+   */
+  L3RateTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +157,24 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracer writing binary records on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param writer Writer created with the columns returned by GetBinaryColumns
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+          Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get columns of the binary trace, which match the columns of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +182,14 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as binary records
+   *
+   * @param writer writer of the binary trace
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -164,8 +229,19 @@ private:
   void
   AddInfo(const Face& face);
 
+  /**
+   * @brief Update averaged rates and call @p record for every trace line
+   *
+   * @p record is called as record(faceId, type, packets, kilobytes, packetsRaw, kilobytesRaw),
+   * with faceId equal to nfd::face::INVALID_FACEID for the node-wide statistics.
+   */
+  template<class Record>
+  void
+  ForEachRecord(const Record& record) const;
+
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
   Time m_period;
   EventId m_printEvent;
 
@@ -26,13 +26,20 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include "daemon/table/pit-entry.hpp"
+
 namespace ns3 {
 namespace ndn {
 
 L3Tracer::L3Tracer(Ptr<Node> node)
-  : m_nodePtr(node)
+  : m_isAttached(false)
+  , m_isFiltered(false)
+  , m_sampleCounters()
+  , m_nodePtr(node)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -45,31 +52,188 @@ L3Tracer::L3Tracer(Ptr<Node> node)
 }
 
 L3Tracer::L3Tracer(const std::string& node)
-  : m_node(node)
+  : m_isAttached(false)
+  , m_isFiltered(false)
+  , m_sampleCounters()
+  , m_node(node)
 {
   Connect();
 }
 
-L3Tracer::~L3Tracer(){};
+L3Tracer::~L3Tracer()
+{
+  Detach();
+}
 
 void
 L3Tracer::Connect()
 {
+  Attach();
+}
+
+void
+L3Tracer::Attach()
+{
+  if (!m_isAttached) {
+    ConnectAll(true);
+    m_isAttached = true;
+  }
+}
+
+void
+L3Tracer::Detach()
+{
+  if (m_isAttached) {
+    ConnectAll(false);
+    m_isAttached = false;
+  }
+}
+
+void
+L3Tracer::SetFilter(const L3TracerFilter& filter)
+{
+  bool wasAttached = m_isAttached;
+  Detach();
+
+  m_filter = filter;
+  m_isFiltered = !m_filter.IsPassThrough();
+  std::fill(std::begin(m_sampleCounters), std::end(m_sampleCounters), 0);
+
+  if (wasAttached) {
+    Attach();
+  }
+}
+
+template<class Callback>
+void
+L3Tracer::ConnectSource(uint32_t source, const std::string& name, const Callback& direct,
+                        const Callback& filtered, bool isConnect)
+{
+  if ((m_filter.sources & source) == 0) {
+    return;
+  }
+
   Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  if (l3 == nullptr) {
+    return;
+  }
 
-  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::OutInterests, this));
-  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::InInterests, this));
-  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::OutData, this));
-  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::InData, this));
-  l3->TraceConnectWithoutContext("OutNack", MakeCallback(&L3Tracer::OutNack, this));
-  l3->TraceConnectWithoutContext("InNack", MakeCallback(&L3Tracer::InNack, this));
+  const Callback& callback = m_isFiltered ? filtered : direct;
+  if (isConnect) {
+    l3->TraceConnectWithoutContext(name, callback);
+  }
+  else {
+    l3->TraceDisconnectWithoutContext(name, callback);
+  }
+}
+
+void
+L3Tracer::ConnectAll(bool isConnect)
+{
+  ConnectSource(L3TracerFilter::OUT_INTERESTS, "OutInterests",
+                MakeCallback(&L3Tracer::OutInterests, this),
+                MakeCallback(&L3Tracer::FilteredOutInterests, this), isConnect);
+  ConnectSource(L3TracerFilter::IN_INTERESTS, "InInterests",
+                MakeCallback(&L3Tracer::InInterests, this),
+                MakeCallback(&L3Tracer::FilteredInInterests, this), isConnect);
+  ConnectSource(L3TracerFilter::OUT_DATA, "OutData",
+                MakeCallback(&L3Tracer::OutData, this),
+                MakeCallback(&L3Tracer::FilteredOutData, this), isConnect);
+  ConnectSource(L3TracerFilter::IN_DATA, "InData",
+                MakeCallback(&L3Tracer::InData, this),
+                MakeCallback(&L3Tracer::FilteredInData, this), isConnect);
+  ConnectSource(L3TracerFilter::OUT_NACKS, "OutNack",
+                MakeCallback(&L3Tracer::OutNack, this),
+                MakeCallback(&L3Tracer::FilteredOutNack, this), isConnect);
+  ConnectSource(L3TracerFilter::IN_NACKS, "InNack",
+                MakeCallback(&L3Tracer::InNack, this),
+                MakeCallback(&L3Tracer::FilteredInNack, this), isConnect);
 
   // satisfied/timed out PIs
-  l3->TraceConnectWithoutContext("SatisfiedInterests",
-                                 MakeCallback(&L3Tracer::SatisfiedInterests, this));
+  ConnectSource(L3TracerFilter::SATISFIED_INTERESTS, "SatisfiedInterests",
+                MakeCallback(&L3Tracer::SatisfiedInterests, this),
+                MakeCallback(&L3Tracer::FilteredSatisfiedInterests, this), isConnect);
+  ConnectSource(L3TracerFilter::TIMED_OUT_INTERESTS, "TimedOutInterests",
+                MakeCallback(&L3Tracer::TimedOutInterests, this),
+                MakeCallback(&L3Tracer::FilteredTimedOutInterests, this), isConnect);
+}
+
+bool
+L3Tracer::IsSampled(const Name& name, const Face* face, uint32_t source)
+{
+  if (!m_filter.prefix.isPrefixOf(name)) {
+    return false;
+  }
+  if (face != nullptr && !IsTracedFace(*face)) {
+    return false;
+  }
+  return m_sampleCounters[source]++ % std::max<uint32_t>(m_filter.sampling, 1) == 0;
+}
+
+void
+L3Tracer::FilteredOutInterests(const Interest& interest, const Face& face)
+{
+  if (IsSampled(interest.getName(), &face, 0)) {
+    OutInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilteredInInterests(const Interest& interest, const Face& face)
+{
+  if (IsSampled(interest.getName(), &face, 1)) {
+    InInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilteredOutData(const Data& data, const Face& face)
+{
+  if (IsSampled(data.getName(), &face, 2)) {
+    OutData(data, face);
+  }
+}
 
-  l3->TraceConnectWithoutContext("TimedOutInterests",
-                                 MakeCallback(&L3Tracer::TimedOutInterests, this));
+void
+L3Tracer::FilteredInData(const Data& data, const Face& face)
+{
+  if (IsSampled(data.getName(), &face, 3)) {
+    InData(data, face);
+  }
+}
+
+void
+L3Tracer::FilteredOutNack(const lp::Nack& nack, const Face& face)
+{
+  if (IsSampled(nack.getInterest().getName(), &face, 4)) {
+    OutNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilteredInNack(const lp::Nack& nack, const Face& face)
+{
+  if (IsSampled(nack.getInterest().getName(), &face, 5)) {
+    InNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilteredSatisfiedInterests(const nfd::pit::Entry& entry, const Face& face,
+                                     const Data& data)
+{
+  // faces of PIT in-records and out-records are checked by the tracer
+  if (IsSampled(entry.getName(), nullptr, 6)) {
+    SatisfiedInterests(entry, face, data);
+  }
+}
+
+void
+L3Tracer::FilteredTimedOutInterests(const nfd::pit::Entry& entry)
+{
+  if (IsSampled(entry.getName(), nullptr, 7)) {
+    TimedOutInterests(entry);
+  }
 }
 
 } // namespace ndn
@@ -25,6 +25,8 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
+#include <set>
+
 namespace nfd {
 namespace pit {
 class Entry;
@@ -38,6 +40,38 @@ class Packet;
 
 namespace ndn {
 
+/**
+ * @ingroup ndn-tracers
+ * @brief Selection of packets and trace sources traced by L3Tracer
+ */
+struct L3TracerFilter {
+  enum TraceSource : uint32_t {
+    IN_INTERESTS = 1 << 0,
+    OUT_INTERESTS = 1 << 1,
+    IN_DATA = 1 << 2,
+    OUT_DATA = 1 << 3,
+    IN_NACKS = 1 << 4,
+    OUT_NACKS = 1 << 5,
+    SATISFIED_INTERESTS = 1 << 6,
+    TIMED_OUT_INTERESTS = 1 << 7,
+    ALL_SOURCES = (1 << 8) - 1
+  };
+
+  /**
+   * @brief Whether the filter lets through every event of the connected trace sources
+   */
+  bool
+  IsPassThrough() const
+  {
+    return prefix.empty() && faces.empty() && sampling <= 1;
+  }
+
+  Name prefix;                    ///< only packets under this prefix are traced ("/" for all)
+  std::set<nfd::FaceId> faces;    ///< only packets on these faces are traced (empty for all)
+  uint32_t sampling = 1;          ///< only 1 of every N matching events of a source is traced
+  uint32_t sources = ALL_SOURCES; ///< bitmask of connected trace sources
+};
+
 /**
  * @ingroup ndn-tracers
  * @brief Base class for network-layer (incoming/outgoing Interests and Data) tracing of NDN stack
@@ -77,10 +111,56 @@ public:
   virtual void
   Print(std::ostream& os) const = 0;
 
+  /**
+   * @brief Change which packets and trace sources are traced
+   *
+   * Trace sources that are not selected are disconnected from L3Protocol, so they do not cost
+   * anything.  If the filter lets through every event, the tracer handlers are connected
+   * directly; otherwise, every event of the selected sources is first checked against the prefix
+   * and face filters, and then only each N-th matching event of a source is passed on.
+   *
+   * With sampling, the tracer counts only the sampled events, i.e., about 1/N of the packets.
+   */
+  void
+  SetFilter(const L3TracerFilter& filter);
+
+  const L3TracerFilter&
+  GetFilter() const
+  {
+    return m_filter;
+  }
+
+  /**
+   * @brief Connect to trace sources of the node, e.g., to resume tracing after Detach
+   */
+  void
+  Attach();
+
+  /**
+   * @brief Disconnect from all trace sources of the node, which stops tracing
+   */
+  void
+  Detach();
+
+  bool
+  IsAttached() const
+  {
+    return m_isAttached;
+  }
+
 protected:
   void
   Connect();
 
+  /**
+   * @brief Check whether events on @p face pass the face filter
+   */
+  bool
+  IsTracedFace(const Face& face) const
+  {
+    return m_filter.faces.empty() || m_filter.faces.count(face.getId()) > 0;
+  }
+
   virtual void
   OutInterests(const Interest&, const Face&) = 0;
 
@@ -105,6 +185,48 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&) = 0;
 
+private:
+  template<class Callback>
+  void
+  ConnectSource(uint32_t source, const std::string& name, const Callback& direct,
+                const Callback& filtered, bool isConnect);
+
+  void
+  ConnectAll(bool isConnect);
+
+  bool
+  IsSampled(const Name& name, const Face* face, uint32_t source);
+
+  void
+  FilteredOutInterests(const Interest& interest, const Face& face);
+
+  void
+  FilteredInInterests(const Interest& interest, const Face& face);
+
+  void
+  FilteredOutData(const Data& data, const Face& face);
+
+  void
+  FilteredInData(const Data& data, const Face& face);
+
+  void
+  FilteredOutNack(const lp::Nack& nack, const Face& face);
+
+  void
+  FilteredInNack(const lp::Nack& nack, const Face& face);
+
+  void
+  FilteredSatisfiedInterests(const nfd::pit::Entry& entry, const Face& face, const Data& data);
+
+  void
+  FilteredTimedOutInterests(const nfd::pit::Entry& entry);
+
+private:
+  L3TracerFilter m_filter;
+  bool m_isAttached;
+  bool m_isFiltered; ///< whether filtering handlers are connected
+  uint32_t m_sampleCounters[8];
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
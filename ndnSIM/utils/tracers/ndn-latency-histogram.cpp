@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-latency-histogram.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+const uint8_t LatencyHistogram::DEFAULT_PRECISION_BITS = 7;
+
+LatencyHistogram::LatencyHistogram(uint8_t precisionBits)
+  : m_precisionBits(precisionBits)
+  , m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+{
+  BOOST_ASSERT(precisionBits >= 1 && precisionBits <= 16);
+}
+
+size_t
+LatencyHistogram::GetIndex(uint64_t value) const
+{
+  // values below 2^(precisionBits + 1) are counted exactly
+  uint64_t linearLimit = uint64_t(2) << m_precisionBits;
+  if (value < linearLimit) {
+    return value;
+  }
+
+  // highest set bit of value is above precisionBits, drop the lower bits beyond the precision
+  int shift = 63 - __builtin_clzll(value) - m_precisionBits;
+  return (size_t(shift) << m_precisionBits) + (value >> shift);
+}
+
+std::pair<uint64_t, uint64_t>
+LatencyHistogram::GetRange(size_t index) const
+{
+  size_t linearLimit = size_t(2) << m_precisionBits;
+  if (index < linearLimit) {
+    return std::make_pair(index, index);
+  }
+
+  int shift = static_cast<int>(index >> m_precisionBits) - 1;
+  uint64_t mantissa = index - (size_t(shift) << m_precisionBits);
+  uint64_t lowest = mantissa << shift;
+  return std::make_pair(lowest, lowest + ((uint64_t(1) << shift) - 1));
+}
+
+void
+LatencyHistogram::Add(uint64_t value)
+{
+  size_t index = GetIndex(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1, 0);
+  }
+  ++m_counts[index];
+
+  ++m_count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void
+LatencyHistogram::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+}
+
+uint64_t
+LatencyHistogram::GetQuantile(double q) const
+{
+  BOOST_ASSERT(m_count > 0);
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(q * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  size_t index = 0;
+  for (uint64_t seen = 0; index < m_counts.size(); ++index) {
+    seen += m_counts[index];
+    if (seen >= rank) {
+      break;
+    }
+  }
+
+  auto range = GetRange(index);
+  uint64_t middle = range.first + (range.second - range.first) / 2;
+  return std::min(std::max(middle, m_min), m_max);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LATENCY_HISTOGRAM_H
+#define NDN_LATENCY_HISTOGRAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming histogram of non-negative integer values with bounded relative error
+ *
+ * The histogram uses the log-linear bucketing of HDR histograms: values below
+ * 2^(precisionBits + 1) have buckets of width one, and every following power-of-two range is
+ * split into 2^precisionBits equal buckets.  A quantile is therefore reported with a relative
+ * error of at most 2^-(precisionBits + 1), while memory depends only on the logarithm of the
+ * largest value (about 2^precisionBits counters per doubling of the range).
+ *
+ * Adding a value is O(1) and does not allocate unless the value is larger than all previous
+ * ones.  Minimum and maximum values are tracked exactly.
+ */
+class LatencyHistogram {
+public:
+  /**
+   * @brief Create an empty histogram
+   * @param precisionBits number of bits of precision kept for every value (1..16)
+   */
+  explicit
+  LatencyHistogram(uint8_t precisionBits = DEFAULT_PRECISION_BITS);
+
+  void
+  Add(uint64_t value);
+
+  /**
+   * @brief Remove all values, keeping the allocated buckets
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @pre GetCount() > 0
+   */
+  uint64_t
+  GetMin() const
+  {
+    return m_min;
+  }
+
+  /**
+   * @pre GetCount() > 0
+   */
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Estimate the value below or at which fraction @p q of values lie
+   * @param q quantile in range [0, 1], e.g., 0.99 for 99th percentile
+   * @pre GetCount() > 0
+   *
+   * The estimate is the middle of the bucket that contains the value of rank ceil(q * count),
+   * limited to the exact [GetMin(), GetMax()] range.
+   */
+  uint64_t
+  GetQuantile(double q) const;
+
+public:
+  static const uint8_t DEFAULT_PRECISION_BITS;
+
+private:
+  size_t
+  GetIndex(uint64_t value) const;
+
+  /**
+   * @brief Get range [lowest, highest] of values counted in bucket @p index
+   */
+  std::pair<uint64_t, uint64_t>
+  GetRange(size_t index) const;
+
+private:
+  uint8_t m_precisionBits;
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LATENCY_HISTOGRAM_H
@@ -0,0 +1,801 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef COMPACT_TRIE_H_
+#define COMPACT_TRIE_H_
+
+/// @cond include_hidden
+
+#include "trie.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Fixed-size block allocator for trie nodes
+ *
+ * Nodes are carved from chunks of CHUNK_SIZE slots. Released slots are kept in an intrusive free
+ * list and reused by subsequent allocations; chunks are returned to the system only when the pool
+ * is destroyed.
+ */
+template<class Node>
+class compact_trie_pool : boost::noncopyable {
+public:
+  static const size_t CHUNK_SIZE = 64;
+
+  compact_trie_pool()
+    : free_(nullptr)
+    , size_(0)
+  {
+  }
+
+  void*
+  allocate()
+  {
+    if (free_ == nullptr) {
+      chunks_.emplace_back(new slot[CHUNK_SIZE]);
+      slot* chunk = chunks_.back().get();
+      for (size_t i = CHUNK_SIZE; i > 0; --i) {
+        deallocate_slot(&chunk[i - 1]);
+      }
+    }
+
+    free_slot* item = free_;
+    free_ = item->next;
+    ++size_;
+    return item;
+  }
+
+  void
+  deallocate(void* item)
+  {
+    deallocate_slot(item);
+    --size_;
+  }
+
+  /// @brief number of allocated nodes
+  size_t
+  size() const
+  {
+    return size_;
+  }
+
+  /// @brief number of nodes that can be allocated without growing the pool
+  size_t
+  capacity() const
+  {
+    return chunks_.size() * CHUNK_SIZE;
+  }
+
+private:
+  struct free_slot {
+    free_slot* next;
+  };
+
+  void
+  deallocate_slot(void* item)
+  {
+    free_slot* slot = static_cast<free_slot*>(item);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  typedef typename std::aligned_storage<(sizeof(Node) > sizeof(free_slot) ? sizeof(Node)
+                                                                           : sizeof(free_slot)),
+                                        (alignof(Node) > alignof(free_slot) ? alignof(Node)
+                                                                             : alignof(free_slot))>::type
+    slot;
+
+  std::vector<std::unique_ptr<slot[]>> chunks_;
+  free_slot* free_;
+  size_t size_;
+};
+
+template<class Trie>
+class compact_trie_iterator;
+
+template<class Trie>
+class compact_trie_point_iterator;
+
+/**
+ * @brief Drop-in alternative to trie with cache-friendly child storage
+ *
+ * The interface (and therefore the policy hooks and trie_with_policy) is the same as in trie,
+ * but children are stored differently:
+ *
+ * - a node with a single child keeps the pointer inline, so single-child chains, which are
+ *   typical for deep and sparse names, do not allocate any child storage;
+ * - otherwise children are kept in a vector sorted by key and found with a binary search;
+ * - when the number of children exceeds HASH_THRESHOLD, a hash index over the keys is added,
+ *   and it is dropped again when the fan-out falls below half of that.
+ *
+ * Nodes are allocated from a compact_trie_pool owned by the root.
+ *
+ * Each node still corresponds to exactly one key component, because replacement policies and
+ * cache entries keep pointers to individual nodes.  Enumeration order of children is the
+ * canonical order of their keys.
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+class compact_trie : boost::noncopyable {
+public:
+  typedef typename FullKey::value_type Key;
+
+  typedef compact_trie* iterator;
+  typedef const compact_trie* const_iterator;
+
+  typedef compact_trie_iterator<compact_trie> recursive_iterator;
+  typedef compact_trie_iterator<const compact_trie> const_recursive_iterator;
+
+  typedef compact_trie_point_iterator<compact_trie> point_iterator;
+  typedef compact_trie_point_iterator<const compact_trie> const_point_iterator;
+
+  typedef PayloadTraits payload_traits;
+
+  typedef compact_trie_pool<compact_trie> pool_type;
+
+  /// @brief fan-out above which children are indexed by a hash table
+  static const size_t HASH_THRESHOLD = 16;
+
+  /**
+   * @brief Create a root node
+   *
+   * The bucket parameters have no meaning for this trie; they are accepted so that trie and
+   * compact_trie can be constructed the same way by trie_with_policy.
+   */
+  explicit compact_trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+    : key_(key)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(nullptr)
+    , pool_(new pool_type)
+    , onlyChild_(nullptr)
+  {
+  }
+
+  ~compact_trie()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    clear();
+
+    if (parent_ == nullptr) {
+      // root owns the pool, and all other nodes have been returned to it by now
+      delete pool_;
+    }
+  }
+
+  void
+  clear()
+  {
+    for (compact_trie* const* child = child_begin(); child != child_end(); ++child) {
+      destroy(*child);
+    }
+
+    onlyChild_ = nullptr;
+    std::vector<compact_trie*>().swap(children_);
+    index_.reset();
+  }
+
+  template<class Predicate>
+  void
+  clear_if(Predicate cond)
+  {
+    recursive_iterator trieNode(this);
+    recursive_iterator end(0);
+
+    while (trieNode != end) {
+      if (cond(*trieNode)) {
+        trieNode = recursive_iterator(trieNode->erase());
+      }
+      trieNode++;
+    }
+  }
+
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, typename PayloadTraits::insert_type payload)
+  {
+    compact_trie* trieNode = this;
+
+    for (const Key& subkey : key) {
+      compact_trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
+        child = trieNode->create_child(subkey);
+      }
+      trieNode = child;
+    }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload) {
+      trieNode->payload_ = payload;
+      return std::make_pair(trieNode, true);
+    }
+    else
+      return std::make_pair(trieNode, false);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
+   */
+  inline iterator
+  erase()
+  {
+    payload_ = PayloadTraits::empty_payload;
+    return prune();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   */
+  inline iterator
+  prune()
+  {
+    if (payload_ == PayloadTraits::empty_payload && child_count() == 0) {
+      if (parent_ == nullptr)
+        return this;
+
+      compact_trie* parent = parent_;
+      parent->remove_child(this); // committing a suicide
+
+      return parent->prune();
+    }
+    return this;
+  }
+
+  /**
+   * @brief Perform prune of the node, but without attempting to parent of the node
+   */
+  inline void
+  prune_node()
+  {
+    if (payload_ == PayloadTraits::empty_payload && child_count() == 0) {
+      if (parent_ == nullptr)
+        return;
+
+      parent_->remove_child(this); // committing a suicide
+    }
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  inline std::tuple<iterator, bool, iterator>
+  find(const FullKey& key)
+  {
+    compact_trie* trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
+    bool reachLast = true;
+
+    for (const Key& subkey : key) {
+      compact_trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
+        reachLast = false;
+        break;
+      }
+
+      trieNode = child;
+      if (trieNode->payload_ != PayloadTraits::empty_payload)
+        foundNode = trieNode;
+    }
+
+    return std::make_tuple(foundNode, reachLast, trieNode);
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, iterator>
+  find_if(const FullKey& key, Predicate pred)
+  {
+    compact_trie* trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
+    bool reachLast = true;
+
+    for (const Key& subkey : key) {
+      compact_trie* child = trieNode->find_child(subkey);
+      if (child == nullptr) {
+        reachLast = false;
+        break;
+      }
+
+      trieNode = child;
+      if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_))
+        foundNode = trieNode;
+    }
+
+    return std::make_tuple(foundNode, reachLast, trieNode);
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   * @returns end() or a valid iterator pointing to the first trie leaf in key order
+   */
+  inline iterator
+  find()
+  {
+    if (payload_ != PayloadTraits::empty_payload)
+      return this;
+
+    for (compact_trie* const* child = child_begin(); child != child_end(); ++child) {
+      iterator value = (*child)->find();
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the first matching trie leaf in key order
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if(Predicate pred)
+  {
+    if (payload_ != PayloadTraits::empty_payload && pred(payload_))
+      return this;
+
+    for (compact_trie* const* child = child_begin(); child != child_end(); ++child) {
+      iterator value = (*child)->find_if(pred);
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   *
+   * This version check predicate only for the next level children
+   *
+   * @returns end() or a valid iterator pointing to the first matching trie leaf in key order
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level(Predicate pred)
+  {
+    for (compact_trie* const* child = child_begin(); child != child_end(); ++child) {
+      if (pred((*child)->key())) {
+        return (*child)->find();
+      }
+    }
+
+    return 0;
+  }
+
+  iterator
+  end()
+  {
+    return 0;
+  }
+
+  const_iterator
+  end() const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload() const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload(typename PayloadTraits::insert_type payload)
+  {
+    payload_ = payload;
+  }
+
+  Key
+  key() const
+  {
+    return key_;
+  }
+
+  /// @brief number of direct children of the node
+  size_t
+  child_count() const
+  {
+    return onlyChild_ != nullptr ? 1 : children_.size();
+  }
+
+  /// @brief node pool shared by all nodes of the trie
+  const pool_type&
+  get_pool() const
+  {
+    return *pool_;
+  }
+
+  inline void
+  PrintStat(std::ostream& os) const;
+
+  friend std::ostream&
+  operator<<(std::ostream& os, const compact_trie& trie_node)
+  {
+    os << "# " << trie_node.key_
+       << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << std::endl;
+
+    for (compact_trie* const* child = trie_node.child_begin(); child != trie_node.child_end();
+         ++child) {
+      const compact_trie& subnode = **child;
+      os << "\"" << &trie_node << "\""
+         << " [label=\"" << trie_node.key_
+         << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
+      os << "\"" << &subnode << "\""
+         << " [label=\"" << subnode.key_
+         << ((subnode.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
+
+      os << "\"" << &trie_node << "\""
+         << " -> "
+         << "\"" << &subnode << "\""
+         << "\n";
+      os << subnode;
+    }
+
+    return os;
+  }
+
+private:
+  struct child_tag {
+  };
+
+  compact_trie(const Key& key, compact_trie* parent, child_tag)
+    : key_(key)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+    , pool_(parent->pool_)
+    , onlyChild_(nullptr)
+  {
+  }
+
+  struct key_less {
+    bool
+    operator()(const compact_trie* node, const Key& key) const
+    {
+      return node->key_ < key;
+    }
+  };
+
+  struct key_hash {
+    size_t
+    operator()(const Key& key) const
+    {
+      const auto& wire = key.wireEncode();
+      return boost::hash_range(wire.wire(), wire.wire() + wire.size());
+    }
+  };
+
+  typedef std::unordered_map<Key, compact_trie*, key_hash> child_index;
+
+  compact_trie* const*
+  child_begin() const
+  {
+    return onlyChild_ != nullptr ? &onlyChild_ : children_.data();
+  }
+
+  compact_trie* const*
+  child_end() const
+  {
+    return child_begin() + child_count();
+  }
+
+  compact_trie*
+  first_child() const
+  {
+    return child_count() > 0 ? *child_begin() : nullptr;
+  }
+
+  compact_trie*
+  next_sibling() const
+  {
+    if (parent_ == nullptr || parent_->onlyChild_ != nullptr)
+      return nullptr;
+
+    const std::vector<compact_trie*>& siblings = parent_->children_;
+    auto item = std::lower_bound(siblings.begin(), siblings.end(), key_, key_less());
+    BOOST_ASSERT(item != siblings.end() && *item == this);
+    ++item;
+    return item != siblings.end() ? *item : nullptr;
+  }
+
+  compact_trie*
+  find_child(const Key& key) const
+  {
+    if (onlyChild_ != nullptr)
+      return onlyChild_->key_ == key ? onlyChild_ : nullptr;
+
+    if (index_ != nullptr) {
+      auto item = index_->find(key);
+      return item != index_->end() ? item->second : nullptr;
+    }
+
+    auto item = std::lower_bound(children_.begin(), children_.end(), key, key_less());
+    if (item != children_.end() && (*item)->key_ == key)
+      return *item;
+    return nullptr;
+  }
+
+  compact_trie*
+  create_child(const Key& key)
+  {
+    void* storage = pool_->allocate();
+    compact_trie* child = nullptr;
+    try {
+      child = new (storage) compact_trie(key, this, child_tag());
+    }
+    catch (...) {
+      pool_->deallocate(storage);
+      throw;
+    }
+
+    if (child_count() == 0) {
+      onlyChild_ = child;
+      return child;
+    }
+
+    if (onlyChild_ != nullptr) {
+      children_.reserve(2);
+      children_.push_back(onlyChild_);
+      onlyChild_ = nullptr;
+    }
+
+    children_.insert(std::lower_bound(children_.begin(), children_.end(), key, key_less()), child);
+
+    if (index_ != nullptr) {
+      index_->emplace(key, child);
+    }
+    else if (children_.size() > HASH_THRESHOLD) {
+      index_.reset(new child_index(children_.size() * 2));
+      for (compact_trie* node : children_) {
+        index_->emplace(node->key_, node);
+      }
+    }
+
+    return child;
+  }
+
+  void
+  remove_child(compact_trie* child)
+  {
+    if (onlyChild_ == child) {
+      onlyChild_ = nullptr;
+      destroy(child);
+      return;
+    }
+
+    auto item = std::lower_bound(children_.begin(), children_.end(), child->key_, key_less());
+    BOOST_ASSERT(item != children_.end() && *item == child);
+    children_.erase(item);
+
+    if (index_ != nullptr) {
+      index_->erase(child->key_);
+      if (children_.size() < HASH_THRESHOLD / 2)
+        index_.reset();
+    }
+
+    if (children_.size() == 1) {
+      onlyChild_ = children_.front();
+      std::vector<compact_trie*>().swap(children_);
+    }
+
+    destroy(child);
+  }
+
+  void
+  destroy(compact_trie* node)
+  {
+    node->~compact_trie();
+    pool_->deallocate(node);
+  }
+
+  template<class Trie>
+  friend class compact_trie_iterator;
+
+  template<class Trie>
+  friend class compact_trie_point_iterator;
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  Key key_; ///< name component
+  typename PayloadTraits::storage_type payload_;
+  compact_trie* parent_; // to make cleaning effective
+  pool_type* pool_;      // owned by the root node
+
+  compact_trie* onlyChild_;             ///< the child, if there is exactly one
+  std::vector<compact_trie*> children_; ///< children sorted by key, if there are two or more
+  std::unique_ptr<child_index> index_;  ///< key index of children_, if fan-out is large
+};
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+inline void
+compact_trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+{
+  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
+     << child_count() << " children" << (index_ != nullptr ? " (hashed)" : "") << std::endl;
+
+  for (compact_trie* const* child = child_begin(); child != child_end(); ++child) {
+    (*child)->PrintStat(os);
+  }
+}
+
+/**
+ * @brief Depth-first iterator over a compact_trie, starting from the given node
+ */
+template<class Trie>
+class compact_trie_iterator {
+public:
+  compact_trie_iterator()
+    : trie_(0)
+  {
+  }
+  compact_trie_iterator(Trie* item)
+    : trie_(item)
+  {
+  }
+  compact_trie_iterator(Trie& item)
+    : trie_(&item)
+  {
+  }
+
+  Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(const compact_trie_iterator& other) const
+  {
+    return trie_ == other.trie_;
+  }
+  bool
+  operator!=(const compact_trie_iterator& other) const
+  {
+    return trie_ != other.trie_;
+  }
+
+  compact_trie_iterator&
+  operator++()
+  {
+    Trie* child = trie_->first_child();
+    if (child != nullptr)
+      trie_ = child;
+    else
+      trie_ = goUp();
+    return *this;
+  }
+
+  compact_trie_iterator
+  operator++(int)
+  {
+    compact_trie_iterator old = *this;
+    ++(*this);
+    return old;
+  }
+
+private:
+  Trie*
+  goUp() const
+  {
+    for (Trie* node = trie_; node != nullptr; node = node->parent_) {
+      Trie* sibling = node->next_sibling();
+      if (sibling != nullptr)
+        return sibling;
+    }
+    return nullptr;
+  }
+
+private:
+  Trie* trie_;
+};
+
+/**
+ * @brief Iterator over direct children of a compact_trie node
+ */
+template<class Trie>
+class compact_trie_point_iterator {
+public:
+  compact_trie_point_iterator()
+    : trie_(0)
+  {
+  }
+  compact_trie_point_iterator(Trie* item)
+    : trie_(item)
+  {
+  }
+  compact_trie_point_iterator(Trie& item)
+    : trie_(item.first_child())
+  {
+  }
+
+  Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(const compact_trie_point_iterator& other) const
+  {
+    return trie_ == other.trie_;
+  }
+  bool
+  operator!=(const compact_trie_point_iterator& other) const
+  {
+    return trie_ != other.trie_;
+  }
+
+  compact_trie_point_iterator&
+  operator++()
+  {
+    trie_ = trie_->next_sibling();
+    return *this;
+  }
+
+  compact_trie_point_iterator
+  operator++(int)
+  {
+    compact_trie_point_iterator old = *this;
+    ++(*this);
+    return old;
+  }
+
+private:
+  Trie* trie_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // COMPACT_TRIE_H_